@@ -0,0 +1,49 @@
+# Writes OUTPUT, a C++ source defining Shaders::embeddedShaders from the SPIR-V files
+# in SHADER_FILES (comma-separated). Shaders compiled to identical binaries share one
+# array. Run with cmake -P; see the shader section of CMakeLists.txt.
+
+string(REPLACE "," ";" shaderFiles "${SHADER_FILES}")
+
+set(shaderArrays "")
+set(shaderEntries "")
+set(arrayCount 0)
+
+foreach(shaderFile IN LISTS shaderFiles)
+    file(SHA256 ${shaderFile} shaderHash)
+    if (NOT DEFINED arrayOf_${shaderHash})
+        set(arrayOf_${shaderHash} spirv${arrayCount})
+        math(EXPR arrayCount "${arrayCount} + 1")
+
+        # glslc writes words in host order, and every target we build for is little-endian
+        file(READ ${shaderFile} shaderHex HEX)
+        string(REGEX REPLACE "(..)(..)(..)(..)" "0x\\4\\3\\2\\1, " shaderWords "${shaderHex}")
+        # eight words a line; cmake regular expressions have no {n}
+        set(lineWords "")
+        foreach(i RANGE 1 8)
+            string(APPEND lineWords "0x........, ")
+        endforeach()
+        string(REGEX REPLACE "(${lineWords})" "\\1\n        " shaderWords "${shaderWords}")
+        string(APPEND shaderArrays
+                "    alignas(16) constexpr uint32_t ${arrayOf_${shaderHash}}[] = {\n"
+                "        ${shaderWords}\n"
+                "    };\n\n")
+    endif()
+
+    get_filename_component(shaderName ${shaderFile} NAME)
+    string(APPEND shaderEntries
+            "            { \"${shaderName}\", ${arrayOf_${shaderHash}}, sizeof(${arrayOf_${shaderHash}}) },\n")
+endforeach()
+
+list(LENGTH shaderFiles shaderCount)
+file(WRITE ${OUTPUT}
+        "// generated by cmake/EmbedShaders.cmake; do not edit\n"
+        "#include \"Shaders.h\"\n\n"
+        "namespace\n{\n"
+        "${shaderArrays}"
+        "}\n\n"
+        "namespace Shaders\n{\n"
+        "    EmbeddedShader const embeddedShaders[] = {\n"
+        "${shaderEntries}"
+        "    };\n"
+        "    size_t const embeddedShaderCount = ${shaderCount};\n"
+        "}\n")
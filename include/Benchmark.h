@@ -0,0 +1,41 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Collects named per-frame timings for --benchmark runs and prints a summary
+ * (mean, median, 99th percentile, extremes) once the run is finished, along with
+ * per-frame counters such as culling results.
+ * Samples taken during the warmup frames are discarded.
+ */
+class Benchmark
+{
+public:
+    static constexpr uint32_t DEFAULT_WARMUP_FRAMES = 60;
+
+    Benchmark() = default;
+    explicit Benchmark(uint32_t const& frames, uint32_t const& warmup = DEFAULT_WARMUP_FRAMES);
+
+    [[nodiscard]]
+    bool enabled() const;
+
+    [[nodiscard]]
+    bool finished() const;
+
+    void addSample(std::string const& name, double const& milliseconds);
+    void addCount(std::string const& name, uint64_t const& count);
+    void endFrame();
+
+    void report(std::ostream& out, std::string const& label) const;
+
+private:
+    uint32_t frameCount = 0;
+    uint32_t warmupFrames = DEFAULT_WARMUP_FRAMES;
+    uint32_t framesSeen = 0;
+
+    std::map<std::string, std::vector<double>> samples;
+    std::map<std::string, std::vector<uint64_t>> counts;
+};
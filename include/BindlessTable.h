@@ -0,0 +1,80 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Image.h"
+#include "StorageBufferArray.h"
+#include "MaterialTable.h"
+#include "InstanceTransform.h"
+
+struct DrawPushConstant
+{
+    uint32_t drawIdx;
+
+    static VkPushConstantRange pushConstantRange();
+};
+
+constexpr uint32_t BINDLESS_NO_TEXTURE = UINT32_MAX;
+
+/**
+ * Descriptor-indexed set holding every texture and per-draw/per-material record.
+ * One set per frame in flight; bound once per frame and indexed by draw ID in the shaders.
+ */
+class BindlessTable : public AVkGraphicsBase
+{
+public:
+    static constexpr uint32_t MAX_DRAWS = 4096;
+    static constexpr uint32_t MAX_MATERIALS = 1024;
+    static constexpr uint32_t MAX_TEXTURES = 4096;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkSampler sampler = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSets;
+
+    BindlessTable() = default;
+    BindlessTable(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice const& physDev);
+
+    DISALLOW_COPY(BindlessTable)
+
+    BindlessTable(BindlessTable&& table) noexcept;
+    BindlessTable& operator=(BindlessTable&& table) noexcept;
+
+    ~BindlessTable() override;
+
+    static bool supported(VkPhysicalDeviceVulkan12Features const& features);
+
+    uint32_t registerTexture(Image::Image const& img);
+    // materials reach a frame's buffer on its next syncMaterials, never while earlier frames read it
+    uint32_t registerMaterial(MaterialRecord const& material);
+    void updateMaterial(uint32_t const& idx, MaterialRecord const& material);
+
+    VkResult setDrawRecords(uint32_t const& frameIdx, std::vector<DrawRecord> const& records);
+    // uploads the material changes frameIdx has not seen yet; the frame's last use must be complete
+    VkResult syncMaterials(uint32_t const& frameIdx);
+
+    [[nodiscard]]
+    uint32_t textureCapacity() const;
+
+protected:
+    VkResult createDescriptorSetLayout();
+    VkResult createDescriptorPool();
+    VkResult createDescriptorSets();
+    VkResult createSampler();
+    void writeBufferDescriptors();
+
+private:
+    void dispose();
+
+    VmaAllocator* allocator = nullptr;
+    uint32_t maxTextures = MAX_TEXTURES;
+
+    std::vector<StorageBufferArray<DrawRecord>> drawRecordBuffers;
+    std::vector<StorageBufferArray<MaterialRecord>> materialBuffers;
+    std::vector<MaterialRecord> materials;
+    // one bit per frame in flight whose material buffer is out of date
+    uint32_t staleMaterialFrames = 0;
+    uint32_t textureCount = 0;
+};
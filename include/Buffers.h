@@ -40,6 +40,13 @@ namespace Buffers
         [[nodiscard]]
         uint32_t getSize() const;
 
+        /**
+         * Requires the buffer to be created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+         * and the bufferDeviceAddress feature to be enabled.
+         */
+        [[nodiscard]]
+        VkDeviceAddress deviceAddress() const;
+
         VkResult loadData(void const* data);
         VkResult loadData(void const* data, uint32_t const& offset, uint32_t const& dataSize);
 
@@ -67,6 +74,8 @@ namespace Buffers
                 std::set<uint32_t> const& queues);
 
     private:
+        void dispose();
+
         VmaAllocator* allocator = nullptr;
         size_t size = -1;
         void* mappedMemory = nullptr;
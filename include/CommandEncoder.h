@@ -0,0 +1,65 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Vertex.h"
+
+struct BindStats
+{
+    uint32_t issued = 0;
+    uint32_t skipped = 0;
+};
+
+/**
+ * Records binds into a command buffer through a cache of the currently bound
+ * pipeline, descriptor sets and vertex/index buffers, dropping binds that would not
+ * change anything. The cache only knows what went through it, so begin() must be
+ * called for every command buffer, and binds recorded directly invalidate it.
+ */
+class CommandEncoder
+{
+public:
+    static constexpr uint32_t MAX_DESCRIPTOR_SETS = 4;
+
+    void begin(VkCommandBuffer const& commandBuffer);
+
+    void bindPipeline(VkPipeline const& pipeline);
+    void bindDescriptorSets(
+            VkPipelineLayout const& layout,
+            uint32_t const& firstSet,
+            uint32_t const& setCount,
+            VkDescriptorSet const* sets,
+            uint32_t const& dynamicOffsetCount = 0,
+            uint32_t const* dynamicOffsets = nullptr);
+    // binds every stream of buffer at once, stream i at binding i
+    void bindVertexStreams(VkBuffer const& buffer, VertexStreams const& streams);
+    void bindIndexBuffer(VkBuffer const& buffer, VkDeviceSize const& offset, VkIndexType const& indexType);
+
+    [[nodiscard]]
+    VkCommandBuffer const& commandBuffer() const;
+
+    [[nodiscard]]
+    BindStats const& stats() const;
+
+private:
+    struct BoundSet
+    {
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        // dynamic offsets of the bind call that started at this set
+        std::vector<uint32_t> dynamicOffsets;
+    };
+
+    VkCommandBuffer cmdBuf = VK_NULL_HANDLE;
+    BindStats bindStats;
+
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    VkPipelineLayout boundLayout = VK_NULL_HANDLE;
+    std::array<BoundSet, MAX_DESCRIPTOR_SETS> boundSets;
+    VkBuffer boundVertexBuffer = VK_NULL_HANDLE;
+    VertexStreams boundVertexStreams;
+    VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceSize boundIndexOffset = 0;
+    VkIndexType boundIndexType = VK_INDEX_TYPE_UINT32;
+};
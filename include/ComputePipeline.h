@@ -0,0 +1,41 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Shaders.h"
+
+class ComputePipeline : public AVkGraphicsBase
+{
+public:
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    std::vector<VkPushConstantRange> pushConstantRanges;
+
+    ComputePipeline() = default;
+    ComputePipeline(
+            VkDevice* device,
+            VkPipelineCache const& pipelineCache,
+            std::string const& compShader,
+            std::vector<VkDescriptorSetLayout> const& descriptorSetLayout = {},
+            std::vector<VkPushConstantRange> const& pushConstantRanges = {});
+
+    ComputePipeline(ComputePipeline const&) = delete;
+    ComputePipeline& operator=(ComputePipeline const&) = delete;
+
+    ComputePipeline(ComputePipeline&& computePipeline) noexcept;
+    ComputePipeline& operator= (ComputePipeline&& computePipeline) noexcept;
+
+    ~ComputePipeline();
+
+protected:
+    VkResult createComputePipeline(
+            VkPipelineCache const& pipelineCache,
+            std::string const& compShaderName,
+            std::vector<VkDescriptorSetLayout> const& descriptorSetLayout,
+            std::vector<VkPushConstantRange> const& pushConstantRanges);
+
+private:
+    void dispose();
+};
@@ -0,0 +1,93 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "ComputePipeline.h"
+#include "GeometryBuffer.h"
+#include "InstanceBuffer.h"
+#include "QueueFamilies.h"
+#include "FrustumCuller.h"
+
+/**
+ * View frustum for cull.comp, as six inward-facing planes (xyz normal, w distance).
+ */
+struct CullPushConstant
+{
+    glm::vec4 frustumPlanes[6];
+
+    static CullPushConstant fromViewProj(glm::mat4 const& viewProj);
+    static VkPushConstantRange pushConstantRange();
+};
+
+/**
+ * Frustum culling on the GPU. Every frame, cull.comp tests each instance's
+ * bounding sphere and appends a VkDrawIndexedIndirectCommand (firstInstance set
+ * to the instance) for the visible ones, along with the count; the frame is then
+ * drawn with a single vkCmdDrawIndexedIndirectCount over the merged geometry.
+ *
+ * Culling is submitted to the compute queue and signals a per-frame semaphore
+ * the graphics submission must wait on, at the draw indirect stage.
+ */
+class CullingPass : public AVkGraphicsBase
+{
+public:
+    static constexpr uint32_t MAX_MESHES = 256;
+    static constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSets;
+
+    CullingPass() = default;
+    CullingPass(
+            VkDevice* logicalDev,
+            VmaAllocator* allocator,
+            VkPhysicalDevice const& physDev,
+            QueueFamilies& queueFamilies,
+            DescriptorAllocator& descAllocator,
+            DescriptorLayoutCache& layoutCache,
+            GeometryBuffer const& geometry,
+            InstanceBuffer const& instances,
+            VkPipelineCache const& pipelineCache,
+            std::string const& cullShader);
+
+    DISALLOW_COPY(CullingPass)
+
+    CullingPass(CullingPass&& cullingPass) noexcept;
+    CullingPass& operator=(CullingPass&& cullingPass) noexcept;
+
+    ~CullingPass() override;
+
+    static bool supported(VkPhysicalDeviceFeatures const& features, VkPhysicalDeviceVulkan12Features const& features12);
+
+    /**
+     * Records and submits culling of the frame's instances; returns the semaphore signalled when done.
+     * The frame's fence must have been waited on.
+     */
+    VkSemaphore submit(
+            uint32_t const& frameIdx,
+            VkQueue const& computeQueue,
+            uint32_t const& instanceCount,
+            CullPushConstant const& frustum);
+
+    void cmdDraw(VkCommandBuffer& cmdBuf, uint32_t const& frameIdx, uint32_t const& maxDrawCount) const;
+
+protected:
+    VkResult createCommandPool(uint32_t const& computeFamily);
+    VkResult createCommandBuffers();
+    VkResult createSemaphores();
+    void writeDescriptorSets(InstanceBuffer const& instances);
+
+private:
+    void dispose();
+
+    std::unique_ptr<ComputePipeline> pipeline;
+    std::unique_ptr<StorageBufferArray<MeshRange>> meshBuffer;
+    std::vector<Buffers::Buffer> drawCommandBuffers;
+    std::vector<Buffers::Buffer> drawCountBuffers;
+
+    VkCommandPool cmdPool = VK_NULL_HANDLE;
+    std::vector<VkCommandBuffer> cmdBuffers;
+    std::vector<VkSemaphore> cullFinished;
+};
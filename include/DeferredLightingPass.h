@@ -0,0 +1,56 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "GraphicsPipeline.h"
+
+/**
+ * Lighting subpass of the deferred render pass: one full-screen triangle that reads
+ * the G-buffer and depth as input attachments, rebuilds each pixel's world position
+ * from depth and shades it for every light reaching it (see deferred.frag.hlsl).
+ */
+class DeferredLightingPass : public AVkGraphicsBase
+{
+public:
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+
+    DeferredLightingPass() = default;
+
+    /**
+     * @param renderPass A deferred render pass, as created by
+     * SwapchainComponents::createRenderPass.
+     * @param descriptorSetLayout The frame's uniform set layout, then the GBuffer's.
+     */
+    DeferredLightingPass(
+            VkDevice* device,
+            VkPipelineCache const& pipelineCache,
+            VkRenderPass const& renderPass,
+            std::vector<VkDescriptorSetLayout> const& descriptorSetLayout);
+
+    DeferredLightingPass(DeferredLightingPass const&) = delete;
+    DeferredLightingPass& operator=(DeferredLightingPass const&) = delete;
+
+    DeferredLightingPass(DeferredLightingPass&& lightingPass) noexcept;
+    DeferredLightingPass& operator= (DeferredLightingPass&& lightingPass) noexcept;
+
+    ~DeferredLightingPass();
+
+    // records the lighting subpass; the command buffer must already be in it
+    void cmdDraw(
+            VkCommandBuffer& cmdBuf,
+            VkDescriptorSet const& frameSet,
+            VkDescriptorSet const& gbufferSet,
+            VkExtent2D const& extent) const;
+
+protected:
+    VkResult createPipeline(
+            VkPipelineCache const& pipelineCache,
+            VkRenderPass const& renderPass,
+            std::vector<VkDescriptorSetLayout> const& descriptorSetLayout);
+
+private:
+    void dispose();
+};
@@ -0,0 +1,60 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "FrameTimeline.h"
+#include <deque>
+#include <mutex>
+
+/**
+ * Holds on to objects the GPU may still be using, and destroys them once the
+ * FrameTimeline reaches the value of the last submission that could have
+ * referenced them, instead of idling the device before replacing them.
+ *
+ * Any movable RAII wrapper (Buffers::Buffer, Image::Image, GraphicsPipeline,
+ * SwapchainComponents, or a unique_ptr to one) is retired by moving it in, after
+ * which the original may be assigned a replacement straight away. Raw handles go
+ * in as a destroy callback.
+ *
+ * Entries are destroyed in retirement order, so one retired with a smaller value
+ * than an earlier entry waits for that entry; it is never destroyed too early.
+ */
+class DeletionQueue
+{
+public:
+    DeletionQueue() = default;
+    DISALLOW_COPY(DeletionQueue)
+
+    ~DeletionQueue();
+
+    void defer(uint64_t const& value, std::function<void()> destroy);
+
+    template<typename T>
+    void retire(uint64_t const& value, T&& object)
+    {
+        static_assert(not std::is_lvalue_reference_v<T>, "Objects have to be moved into the deletion queue");
+        auto retired = std::make_shared<T>(std::move(object));
+        defer(value, [retired]() mutable { retired.reset(); });
+    }
+
+    // destroys everything whose value the timeline has reached
+    void collect(FrameTimeline& timeline);
+
+    // destroys everything; only once the device is idle
+    void flush();
+
+    [[nodiscard]]
+    size_t size() const;
+
+private:
+    struct Entry
+    {
+        uint64_t value;
+        std::function<void()> destroy;
+    };
+
+    mutable std::mutex mutex;
+    std::deque<Entry> entries;
+};
@@ -0,0 +1,85 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Chain of descriptor pools. When the current pool runs out, a new one with
+ * twice as many sets is created; reset() returns every pool to the free list
+ * with a single vkResetDescriptorPool per pool.
+ */
+class DescriptorAllocator : public AVkGraphicsBase
+{
+public:
+    struct PoolSizeRatio
+    {
+        VkDescriptorType type;
+        float ratio;
+    };
+
+    static constexpr uint32_t DEFAULT_SETS_PER_POOL = 32;
+    static constexpr uint32_t MAX_SETS_PER_POOL = 4096;
+
+    DescriptorAllocator() = default;
+    explicit DescriptorAllocator(
+            VkDevice* logicalDev,
+            std::vector<PoolSizeRatio> poolRatios = defaultPoolRatios(),
+            uint32_t const& initialSetsPerPool = DEFAULT_SETS_PER_POOL,
+            VkDescriptorPoolCreateFlags const& poolFlags = 0);
+
+    DISALLOW_COPY(DescriptorAllocator)
+
+    DescriptorAllocator(DescriptorAllocator&& descAllocator) noexcept;
+    DescriptorAllocator& operator=(DescriptorAllocator&& descAllocator) noexcept;
+
+    ~DescriptorAllocator() override;
+
+    VkResult allocate(VkDescriptorSetLayout const& layout, VkDescriptorSet& set);
+    VkResult allocate(std::vector<VkDescriptorSetLayout> const& layouts, std::vector<VkDescriptorSet>& sets);
+
+    void reset();
+
+    [[nodiscard]]
+    size_t poolCount() const;
+
+    static std::vector<PoolSizeRatio> defaultPoolRatios();
+
+protected:
+    VkResult createPool(uint32_t const& setCount, VkDescriptorPool& pool);
+    VkResult grabPool(uint32_t const& minSetCount);
+
+private:
+    void dispose();
+
+    std::vector<PoolSizeRatio> ratios;
+    VkDescriptorPoolCreateFlags flags = 0;
+    uint32_t setsPerPool = DEFAULT_SETS_PER_POOL;
+
+    VkDescriptorPool currentPool = VK_NULL_HANDLE;
+    std::vector<std::pair<VkDescriptorPool, uint32_t>> usedPools;
+    std::vector<std::pair<VkDescriptorPool, uint32_t>> freePools;
+};
+
+/**
+ * One descriptor allocator per frame in flight, for sets that only live for a frame.
+ * beginFrame() must be called once the frame slot's timeline value has been waited on;
+ * it resets the slot's pools, so its sets are never freed one by one.
+ */
+class FrameDescriptorAllocator
+{
+public:
+    FrameDescriptorAllocator() = default;
+    explicit FrameDescriptorAllocator(
+            VkDevice* logicalDev,
+            std::vector<DescriptorAllocator::PoolSizeRatio> const& poolRatios =
+                    DescriptorAllocator::defaultPoolRatios());
+
+    void beginFrame(uint32_t const& frameIdx);
+    VkResult allocate(VkDescriptorSetLayout const& layout, VkDescriptorSet& set);
+
+private:
+    std::array<DescriptorAllocator, MAX_FRAMES_IN_FLIGHT> frameAllocators;
+    uint32_t currentFrame = 0;
+};
@@ -0,0 +1,49 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Owns descriptor set layouts, deduplicated by their (sorted) bindings.
+ * Layouts handed out stay valid until the cache is destroyed.
+ */
+class DescriptorLayoutCache : public AVkGraphicsBase
+{
+public:
+    DescriptorLayoutCache() = default;
+    explicit DescriptorLayoutCache(VkDevice* logicalDev);
+
+    DISALLOW_COPY(DescriptorLayoutCache)
+
+    DescriptorLayoutCache(DescriptorLayoutCache&& cache) noexcept;
+    DescriptorLayoutCache& operator=(DescriptorLayoutCache&& cache) noexcept;
+
+    ~DescriptorLayoutCache() override;
+
+    VkDescriptorSetLayout getLayout(
+            std::vector<VkDescriptorSetLayoutBinding> const& bindings,
+            VkDescriptorSetLayoutCreateFlags const& flags = 0);
+
+    [[nodiscard]]
+    size_t size() const;
+
+private:
+    struct LayoutKey
+    {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        VkDescriptorSetLayoutCreateFlags flags;
+
+        bool operator==(LayoutKey const& other) const;
+    };
+
+    struct LayoutKeyHash
+    {
+        size_t operator()(LayoutKey const& key) const;
+    };
+
+    void dispose();
+
+    std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> layouts;
+};
@@ -0,0 +1,45 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Wraps a VkDescriptorUpdateTemplate so a whole set can be written from one
+ * plain struct of descriptor infos, without building VkWriteDescriptorSet arrays.
+ */
+class DescriptorUpdateTemplate : public AVkGraphicsBase
+{
+public:
+    VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE;
+
+    DescriptorUpdateTemplate() = default;
+    DescriptorUpdateTemplate(
+            VkDevice* logicalDev,
+            VkDescriptorSetLayout const& layout,
+            std::vector<VkDescriptorUpdateTemplateEntry> const& entries);
+
+    DISALLOW_COPY(DescriptorUpdateTemplate)
+
+    DescriptorUpdateTemplate(DescriptorUpdateTemplate&& updTemplate) noexcept;
+    DescriptorUpdateTemplate& operator=(DescriptorUpdateTemplate&& updTemplate) noexcept;
+
+    ~DescriptorUpdateTemplate() override;
+
+    static VkDescriptorUpdateTemplateEntry entry(
+            uint32_t const& binding,
+            VkDescriptorType const& descriptorType,
+            size_t const& offset,
+            uint32_t const& descriptorCount = 1,
+            size_t const& stride = 0);
+
+    template<typename TDescriptorData>
+    void update(VkDescriptorSet const& dstSet, TDescriptorData const& data) const
+    {
+        vkUpdateDescriptorSetWithTemplate(getLogicalDev(), dstSet, updateTemplate, &data);
+    }
+
+private:
+    void dispose();
+};
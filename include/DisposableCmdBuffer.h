@@ -21,6 +21,8 @@ public:
 
     VkCommandBuffer& commandBuffer();
     VkResult submit(VkQueue& queue);
+    // also signals signalValue on a timeline semaphore once the commands are done
+    VkResult submit(VkQueue& queue, VkSemaphore timeline, uint64_t const& signalValue);
     void finish();
 
 private:
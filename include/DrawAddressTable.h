@@ -0,0 +1,48 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Buffers.h"
+#include "UniformObjects.h"
+
+struct DrawAddressPushConstant
+{
+    VkDeviceAddress record; // address of this draw's MeshUniform
+
+    static VkPushConstantRange pushConstantRange();
+};
+
+/**
+ * Persistently mapped buffer of per-draw MeshUniform records, one region per frame in
+ * flight. Shaders reach a record through its buffer device address, so drawing needs
+ * no per-draw descriptor binds.
+ */
+class DrawAddressTable
+{
+public:
+    static constexpr uint32_t MAX_DRAWS = 4096;
+
+    DrawAddressTable() = default;
+    DrawAddressTable(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice const& physDev);
+
+    static bool supported(VkPhysicalDeviceVulkan12Features const& features);
+
+    /**
+     * Writes this frame's records straight into its region, which is host coherent, so
+     * the frame's submission makes them visible. Only once the frame's last use has completed.
+     */
+    VkResult setRecords(uint32_t const& frameIdx, std::vector<MeshUniform> const& records);
+
+    [[nodiscard]]
+    VkDeviceAddress recordAddress(uint32_t const& frameIdx, uint32_t const& drawIdx) const;
+
+protected:
+    [[nodiscard]]
+    VkDeviceSize frameOffset(uint32_t const& frameIdx) const;
+
+private:
+    Buffers::Buffer recordBuffer;
+    VkDeviceAddress baseAddress = 0;
+};
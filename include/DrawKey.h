@@ -0,0 +1,49 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * 64-bit draw sort key. From the most significant bits down: pipeline, mesh,
+ * material and a front-to-back depth bucket, so sorting groups draws by the state
+ * that costs the most to change.
+ */
+namespace DrawKey
+{
+    constexpr uint32_t PIPELINE_BITS = 8;
+    constexpr uint32_t MESH_BITS = 16;
+    constexpr uint32_t MATERIAL_BITS = 16;
+    constexpr uint32_t DEPTH_BITS = 24;
+
+    static_assert(PIPELINE_BITS + MESH_BITS + MATERIAL_BITS + DEPTH_BITS == 64, "DrawKey fields must fill 64 bits");
+
+    /**
+     * @param depth View distance normalized to [0, 1]; values outside are clamped.
+     */
+    uint64_t make(uint32_t const& pipeline, uint32_t const& mesh, uint32_t const& material, float const& depth);
+}
+
+struct DrawSortEntry
+{
+    uint64_t key;
+    uint32_t drawIdx;
+};
+
+/**
+ * Stable LSD radix sort over draw keys, one byte per pass. Passes where every key
+ * shares the same byte are skipped, so the unused high bits cost nothing.
+ */
+class DrawSorter
+{
+public:
+    static constexpr uint32_t RADIX_BITS = 8;
+    static constexpr uint32_t RADIX_SIZE = 1u << RADIX_BITS;
+    static constexpr uint32_t PASS_COUNT = 64 / RADIX_BITS;
+
+    void sort(std::vector<DrawSortEntry>& entries);
+
+private:
+    std::vector<DrawSortEntry> scratch;
+};
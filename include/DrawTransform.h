@@ -0,0 +1,22 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "InstanceTransform.h"
+
+/**
+ * Per-draw payload of the push-constant path: the encoded model transform and
+ * a material index, 52 bytes in total.
+ */
+struct DrawTransformPushConstant
+{
+    InstanceTransform transform;
+    uint32_t materialIdx;
+
+    static VkPushConstantRange pushConstantRange();
+};
+
+// every device has at least 128 bytes of push constants, so the path needs no fallback
+static_assert(sizeof(DrawTransformPushConstant) <= 128, "Per-draw payload exceeds the guaranteed push constant size");
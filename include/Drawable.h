@@ -24,7 +24,9 @@ public:
     Drawable(Drawable&& dwb) noexcept :
         AVkGraphicsBase(std::move(dwb)),
         drawMesh(dwb.drawMesh),
-        uniform(std::move(dwb.uniform))
+        uniform(std::move(dwb.uniform)),
+        materialIdx(dwb.materialIdx),
+        pipelineVariant(dwb.pipelineVariant)
     {
     }
 
@@ -33,11 +35,15 @@ public:
         AVkGraphicsBase::operator=(std::move(dwb));
         drawMesh = std::move(dwb.drawMesh);
         uniform = std::move(uniform);
+        materialIdx = dwb.materialIdx;
+        pipelineVariant = dwb.pipelineVariant;
 
         return *this;
     }
 
     MeshUniform uniform;
+    uint32_t materialIdx = 0; // index into the material table of the active draw path
+    uint32_t pipelineVariant = 0; // id from the PipelineManager; 0 draws with the generic pipeline
 
     Mesh& getMesh()
     {
@@ -10,12 +10,11 @@ class FrameSemaphores : public AVkGraphicsBase
 public:
     VkSemaphore imgAvailable = VK_NULL_HANDLE;
     VkSemaphore renderFinished = VK_NULL_HANDLE;
-    VkFence inFlight = VK_NULL_HANDLE;
+    // FrameTimeline value of the last submission using this frame slot; 0 if none yet
+    uint64_t timelineValue = 0;
 
     FrameSemaphores();
-    explicit FrameSemaphores(
-            VkDevice* logicalDev,
-            VkFenceCreateFlags const& fenceFlags=VK_FENCE_CREATE_SIGNALED_BIT);
+    explicit FrameSemaphores(VkDevice* logicalDev);
 
     FrameSemaphores(FrameSemaphores const&) = delete;
     FrameSemaphores& operator=(FrameSemaphores const&) = delete;
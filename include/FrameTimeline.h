@@ -0,0 +1,56 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include <atomic>
+
+/**
+ * One timeline semaphore counting every submission the CPU has to wait on: frames
+ * and uploads each signal the next value. Whatever a submission used is tagged
+ * with its value and may be reused once the semaphore reaches it, which replaces
+ * per-frame and per-image fences.
+ *
+ * The last value read back from the device is cached, so checking a value that
+ * has already completed is a plain comparison rather than a Vulkan call.
+ */
+class FrameTimeline : public AVkGraphicsBase
+{
+public:
+    FrameTimeline() = default;
+    explicit FrameTimeline(VkDevice* logicalDev);
+
+    DISALLOW_COPY(FrameTimeline)
+
+    FrameTimeline(FrameTimeline&& timeline) noexcept;
+    FrameTimeline& operator=(FrameTimeline&& timeline) noexcept;
+
+    ~FrameTimeline() override;
+
+    // claims the value the next submission signals; values must be submitted in order
+    uint64_t advance();
+
+    // the latest value handed out by advance()
+    [[nodiscard]]
+    uint64_t lastValue() const;
+
+    // reads the counter back from the device
+    uint64_t completed();
+
+    // true once the value is reached; only queries the device if the cache is behind
+    bool reached(uint64_t const& value);
+
+    // returns right away if the cached value is already there
+    VkResult wait(uint64_t const& value, uint64_t const& timeout = UINT64_MAX);
+
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+
+private:
+    void dispose();
+    void updateCompleted(uint64_t const& value);
+
+    uint64_t submittedValue = 0;
+    // only ever raised; waits from several threads may race to update it
+    std::atomic<uint64_t> completedValue = 0;
+};
@@ -0,0 +1,77 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Six inward-facing planes (xyz normal, w distance) of a view frustum in world space.
+ */
+struct Frustum
+{
+    glm::vec4 planes[6];
+
+    static Frustum fromViewProj(glm::mat4 const& viewProj);
+};
+
+struct CullStats
+{
+    uint32_t visible = 0;
+    uint32_t frustumCulled = 0;
+    uint32_t smallCulled = 0; // inside the frustum, but below the minimum screen size
+};
+
+#if defined(__AVX2__)
+#define FRUSTUM_CULLER_AVX2
+#endif
+
+/**
+ * Tests world-space bounding spheres against a frustum, eight at a time with AVX2
+ * when built with ENABLE_AVX2 (scalar otherwise). Bounds are kept as a structure
+ * of arrays, padded to the SIMD width.
+ */
+class FrustumCuller
+{
+public:
+    static constexpr size_t SIMD_WIDTH = 8;
+
+    void resize(size_t const& count);
+    void setBounds(size_t const& idx, glm::vec4 const& sphere);
+
+    /**
+     * Writes the indices of visible spheres, in order, to visible.
+     * @param pixelsPerUnit Projected size in pixels of a unit length at unit distance,
+     *     i.e. proj[1][1] times half the viewport height.
+     * @param minPixels Spheres whose projected diameter is smaller than this are rejected.
+     */
+    CullStats cull(
+            Frustum const& frustum,
+            glm::vec3 const& cameraPos,
+            float const& pixelsPerUnit,
+            float const& minPixels,
+            std::vector<uint32_t>& visible) const;
+
+    // the paths cull() picks from, public so tests can compare them
+    CullStats cullScalar(
+            Frustum const& frustum,
+            glm::vec3 const& cameraPos,
+            float const& pixelsPerUnit,
+            float const& minPixels,
+            std::vector<uint32_t>& visible) const;
+#if defined(FRUSTUM_CULLER_AVX2)
+    CullStats cullAvx2(
+            Frustum const& frustum,
+            glm::vec3 const& cameraPos,
+            float const& pixelsPerUnit,
+            float const& minPixels,
+            std::vector<uint32_t>& visible) const;
+#endif
+
+private:
+    size_t count = 0;
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> radius;
+};
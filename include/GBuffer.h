@@ -0,0 +1,62 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Image.h"
+#include "DescriptorAllocator.h"
+#include "DescriptorLayoutCache.h"
+
+/**
+ * Attachments the deferred renderer's geometry subpass writes and its lighting
+ * subpass reads back as input attachments, along with the depth buffer. The set
+ * binding them is allocated every frame from the frame's transient pools, so a
+ * resize creates no descriptor pool or set of its own.
+ *
+ * The attachments never leave the render pass: they are transient, and live in lazily
+ * allocated memory where the device has it, so tiled GPUs keep them on chip.
+ */
+class GBuffer
+{
+public:
+    // albedo, normal (mapped to [0, 1]), then roughness, metallic and F0; see gbuffer.hlsli
+    static constexpr uint32_t COLOR_ATTACHMENT_COUNT = 3;
+    static constexpr std::array<VkFormat, COLOR_ATTACHMENT_COUNT> FORMATS = {
+            VK_FORMAT_R8G8B8A8_UNORM, VK_FORMAT_A2B10G10R10_UNORM_PACK32, VK_FORMAT_R8G8B8A8_UNORM };
+    // the lighting set binds the color attachments in order, then depth
+    static constexpr uint32_t DEPTH_BINDING = COLOR_ATTACHMENT_COUNT;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+
+    GBuffer() = default;
+
+    /**
+     * @param depthView View of the depth buffer drawn along with the G-buffer, created
+     * with VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT.
+     */
+    GBuffer(
+            VkDevice* logicalDev,
+            VmaAllocator* allocator,
+            VkPhysicalDevice const& physDev,
+            std::pair<uint32_t, uint32_t> const& size,
+            VkImageView const& depthView,
+            DescriptorLayoutCache& layoutCache);
+
+    // framebuffer attachments, after the swapchain image and the depth buffer
+    [[nodiscard]]
+    std::vector<VkImageView> attachmentViews() const;
+
+    // allocates this frame's lighting set and points it at the attachments
+    VkResult allocateLightingSet(FrameDescriptorAllocator& frameDescriptors, VkDescriptorSet& set) const;
+
+    static std::vector<VkDescriptorSetLayoutBinding> layoutBindings();
+
+    // pool sizes for the lighting sets, one set each
+    static std::vector<DescriptorAllocator::PoolSizeRatio> poolRatios();
+
+private:
+    VkDevice* logicalDev = nullptr;
+    VkImageView depthView = VK_NULL_HANDLE;
+    std::array<Image::Image, COLOR_ATTACHMENT_COUNT> attachments;
+};
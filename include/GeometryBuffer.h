@@ -0,0 +1,66 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Buffers.h"
+#include "Mesh.h"
+
+// where a mesh lives in the merged buffer, see culling.hlsli
+struct MeshRange
+{
+    uint32_t indexCount;
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t _unused;
+    glm::vec4 boundingSphere; // model space
+
+    static VkShaderStageFlags stageFlags()
+    {
+        return VK_SHADER_STAGE_COMPUTE_BIT;
+    }
+};
+
+/**
+ * Vertices and indices of several meshes packed into one buffer (all vertices,
+ * then all indices), so that draws of any of them need a single vertex and index bind.
+ * The buffer takes the vertex layout of the meshes, which must all share it; split
+ * layouts keep all positions, then all attributes. The meshes must outlive this buffer.
+ */
+class GeometryBuffer
+{
+public:
+    Buffers::Buffer buf;
+
+    GeometryBuffer(
+            VkDevice* logicalDev,
+            VmaAllocator* allocator,
+            VkPhysicalDevice const& physDev,
+            std::vector<Mesh const*> meshes);
+
+    [[nodiscard]]
+    size_t idxOffset() const;
+
+    [[nodiscard]]
+    VertexStreams vertexStreams() const;
+
+    std::shared_ptr<Buffers::StagingBuffer> stagingBuffer(std::set<uint32_t> const& transferQueues);
+
+    [[nodiscard]]
+    uint32_t meshIndex(Mesh const* mesh) const;
+
+    [[nodiscard]]
+    std::vector<MeshRange> const& meshRanges() const;
+
+private:
+    VkDevice* logicalDev;
+    VmaAllocator* allocator;
+    VkPhysicalDevice physDev;
+
+    std::vector<Mesh const*> meshes;
+    std::vector<MeshRange> ranges;
+    VertexLayout layout = VERTEX_LAYOUT_INTERLEAVED;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+};
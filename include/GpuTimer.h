@@ -0,0 +1,49 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Measures how long the GPU takes over each frame's command buffer, for --benchmark
+ * runs, with a pair of timestamp queries per frame in flight. A frame slot's results
+ * are read back when the slot is next recorded, by which point the timeline says the
+ * earlier frame is done, so reading never waits.
+ */
+class GpuTimer : public AVkGraphicsBase
+{
+public:
+    GpuTimer() = default;
+    GpuTimer(VkDevice* logicalDev, VkPhysicalDevice const& physDev, uint32_t const& queueFamily);
+
+    DISALLOW_COPY(GpuTimer)
+
+    GpuTimer(GpuTimer&& gpuTimer) noexcept;
+    GpuTimer& operator=(GpuTimer&& gpuTimer) noexcept;
+
+    ~GpuTimer() override;
+
+    // false if the queue family cannot write timestamps
+    [[nodiscard]]
+    bool supported() const;
+
+    /**
+     * Milliseconds between the timestamps the frame slot last wrote, if it wrote any
+     * since the previous call. Only call once the slot's last frame has completed.
+     */
+    std::optional<double> read(uint32_t const& frameIdx);
+
+    // resets the slot's queries and writes its first timestamp; call outside a render pass
+    void cmdBegin(VkCommandBuffer const& cmdBuf, uint32_t const& frameIdx);
+    void cmdEnd(VkCommandBuffer const& cmdBuf, uint32_t const& frameIdx);
+
+private:
+    void dispose();
+
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    // nanoseconds per timestamp tick
+    double timestampPeriod = 0;
+    uint64_t timestampMask = 0;
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> written = {};
+};
@@ -9,25 +9,113 @@
 #include "Shaders.h"
 #include "UniformObjects.h"
 
+// shaders and specialization constants picking one variant of a pipeline
+struct PipelineVariant
+{
+    std::string vertShader;
+    std::string fragShader;
+    // constant i has constant_id i, in both stages
+    std::vector<uint32_t> constants;
+
+    bool operator==(PipelineVariant const& other) const;
+
+    [[nodiscard]]
+    size_t hash() const;
+};
+
+// part a pipeline plays in a frame drawn with a depth pre-pass
+enum DepthPrePass : uint32_t
+{
+    // tests and writes depth as it shades; no pre-pass
+    DEPTH_PRE_PASS_NONE = 0,
+    // the pre-pass itself: reads positions only, writes depth and no color
+    DEPTH_PRE_PASS_WRITE = 1,
+    // shades only what the pre-pass left visible, without writing depth
+    DEPTH_PRE_PASS_TEST = 2,
+};
+
+/**
+ * The fixed-function state every scene pipeline shares: Vertex input, back-face
+ * culling, no blending, and dynamic viewport and scissor. The create infos point
+ * into the object, so it stays where it was built. colorAttachmentCount is that of
+ * the subpass drawn in: 1 for forward shading, GBuffer::COLOR_ATTACHMENT_COUNT for
+ * the deferred geometry subpass.
+ */
+class PipelineFixedState
+{
+public:
+    explicit PipelineFixedState(
+            bool const& enableDepthTest = true,
+            DepthPrePass const& depthPrePass = DEPTH_PRE_PASS_NONE,
+            VertexLayout const& vertexLayout = VERTEX_LAYOUT_INTERLEAVED,
+            uint32_t const& colorAttachmentCount = 1);
+    DISALLOW_COPY(PipelineFixedState)
+
+    // points every fixed-function state of a complete pipeline here
+    void fill(VkGraphicsPipelineCreateInfo& createInfo) const;
+
+    VkPipelineVertexInputStateCreateInfo vertexInput = {};
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly = {};
+    VkPipelineViewportStateCreateInfo viewportState = {};
+    VkPipelineDynamicStateCreateInfo dynamicState = {};
+    VkPipelineRasterizationStateCreateInfo rasterizer = {};
+    VkPipelineMultisampleStateCreateInfo multisample = {};
+    VkPipelineColorBlendStateCreateInfo colorBlend = {};
+    VkPipelineDepthStencilStateCreateInfo depthStencil = {};
+    bool depthTestEnabled;
+
+private:
+    VertexInputDescription vertexInputDesc;
+    std::array<VkDynamicState, 2> dynamicStates = {};
+    std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachments;
+};
+
+// a shader module and its specialization, destroyed once the pipeline is created
+class PipelineShaderStage
+{
+public:
+    PipelineShaderStage(
+            VkDevice const& logicalDev,
+            VkShaderStageFlagBits const& stage,
+            std::string const& fileName,
+            std::vector<uint32_t> const& constants = {});
+    DISALLOW_COPY(PipelineShaderStage)
+    ~PipelineShaderStage();
+
+    VkPipelineShaderStageCreateInfo info = {};
+
+private:
+    VkDevice logicalDev;
+    VkShaderModule module = VK_NULL_HANDLE;
+    std::vector<uint32_t> constants;
+    std::vector<VkSpecializationMapEntry> specEntries;
+    VkSpecializationInfo specInfo = {};
+};
+
 class GraphicsPipeline : public AVkGraphicsBase
 {
 public:
     VkPipeline pipeline = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     std::vector<VkCommandBuffer> cmdBuffers;
+    std::vector<VkPushConstantRange> pushConstantRanges;
 
     GraphicsPipeline() = default;
     GraphicsPipeline(
             VkDevice* device,
             VkPhysicalDevice const& physDev,
             VkCommandPool* cmdPool,
+            VkPipelineCache const& pipelineCache,
             std::string const& vertShader,
             std::string const& fragShader,
-            VkExtent2D const& extent,
             size_t const& swpchainImgCount,
             VkRenderPass const& renderPass,
             std::vector<VkDescriptorSetLayout> const& descriptorSetLayout = {},
-            bool enableDepthTest = true);
+            bool enableDepthTest = true,
+            std::vector<VkPushConstantRange> const& pushConstantRanges = {},
+            DepthPrePass depthPrePass = DEPTH_PRE_PASS_NONE,
+            VertexLayout vertexLayout = VERTEX_LAYOUT_INTERLEAVED,
+            uint32_t colorAttachmentCount = 1);
 
     GraphicsPipeline(GraphicsPipeline const&) = delete;
     GraphicsPipeline& operator=(GraphicsPipeline const&) = delete;
@@ -37,14 +125,22 @@ public:
 
     ~GraphicsPipeline();
 
+    // union of the stages covered by the push constant ranges, for vkCmdPushConstants
+    [[nodiscard]]
+    VkShaderStageFlags pushConstantStages() const;
+
 protected:
     VkResult createGraphicsPipeline(
+            VkPipelineCache const& pipelineCache,
             std::string const& vertShaderName,
             std::string const& fragShaderName,
-            VkExtent2D const& extent,
             VkRenderPass const& renderPass,
             std::vector<VkDescriptorSetLayout> const& descriptorSetLayout = {},
-            bool enableDepthTest = true);
+            bool enableDepthTest = true,
+            std::vector<VkPushConstantRange> const& pushConstantRanges = {},
+            DepthPrePass depthPrePass = DEPTH_PRE_PASS_NONE,
+            VertexLayout vertexLayout = VERTEX_LAYOUT_INTERLEAVED,
+            uint32_t colorAttachmentCount = 1);
 
     VkResult createCmdBuffers(size_t const& swpchainImgCoun);
 
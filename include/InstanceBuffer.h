@@ -0,0 +1,60 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "StorageBufferArray.h"
+#include "DescriptorAllocator.h"
+#include "DescriptorLayoutCache.h"
+#include "InstanceTransform.h"
+#include "Mesh.h"
+
+/**
+ * Identifies the batch being drawn; instanced.vert reads
+ * instances[instanceBase + SV_InstanceID].
+ */
+struct InstanceBatchPushConstant
+{
+    uint32_t instanceBase;
+
+    static VkPushConstantRange pushConstantRange();
+};
+
+// contiguous run of instance records sharing a mesh
+struct InstanceBatch
+{
+    Mesh* mesh;
+    uint32_t firstInstance;
+    uint32_t instanceCount;
+};
+
+/**
+ * Per-frame storage buffers of instance records, written contiguously per mesh
+ * so that each mesh goes out as a single instanced draw.
+ * Sets come from the allocator passed in, which must not be reset while in use.
+ */
+class InstanceBuffer
+{
+public:
+    static constexpr uint32_t MAX_INSTANCES = 65536;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSets;
+
+    InstanceBuffer(
+            VkDevice* logicalDev,
+            VmaAllocator* allocator,
+            VkPhysicalDevice const& physDev,
+            DescriptorAllocator& descAllocator,
+            DescriptorLayoutCache& layoutCache,
+            Buffers::optUint32Set const& usedQueues = nullopt);
+
+    VkResult setInstances(uint32_t const& frameIdx, std::vector<DrawRecord> const& records);
+
+    [[nodiscard]]
+    StorageBufferArray<DrawRecord> const& records(uint32_t const& frameIdx) const;
+
+private:
+    std::vector<StorageBufferArray<DrawRecord>> instanceBuffers;
+};
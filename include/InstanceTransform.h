@@ -0,0 +1,40 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Affine model transform packed as the top three rows of the matrix (48 bytes,
+ * against 128 for a model matrix plus its inverse-transpose). The bottom row is
+ * implicitly (0, 0, 0, 1); shaders rebuild the normal matrix from the rows.
+ */
+struct InstanceTransform
+{
+    glm::vec4 rows[3];
+
+    static InstanceTransform encode(glm::mat4 const& model);
+
+    /**
+     * Encodes count contiguous matrices into out, four per iteration: with ENABLE_AVX2
+     * two matrices share each 256-bit transpose, otherwise each gets an SSE one.
+     */
+    static void encodeBatch(glm::mat4 const* models, size_t const& count, InstanceTransform* out);
+};
+
+static_assert(sizeof(InstanceTransform) == 48, "InstanceTransform must match the shader layout");
+
+// per-draw (or per-instance) storage buffer record, see drawrecord.hlsli
+struct DrawRecord
+{
+    InstanceTransform transform;
+    uint32_t materialIdx;
+    uint32_t meshIdx; // into the geometry buffer; only read by GPU culling
+    uint32_t _unused[2]; // pads to the std430 array stride
+
+    static VkShaderStageFlags stageFlags()
+    {
+        return VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    }
+};
@@ -0,0 +1,186 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+class JobSystem;
+
+namespace Jobs
+{
+    class Counter;
+
+    struct Job
+    {
+        std::function<void()> fn;
+        Counter* counter = nullptr;
+    };
+
+    /**
+     * Counts unfinished jobs. Jobs run with a counter increment it when queued and
+     * decrement it when done; JobSystem::wait() returns once it drops to zero and
+     * rethrows the first exception any of them threw. Jobs queued with runAfter()
+     * start once the counter they depend on reaches zero.
+     *
+     * A counter must outlive its jobs, and should not be reused for new jobs while
+     * continuations are still waiting on it.
+     */
+    class Counter
+    {
+    public:
+        Counter() = default;
+        DISALLOW_COPY(Counter)
+
+        [[nodiscard]]
+        bool done() const;
+
+    private:
+        friend class ::JobSystem;
+
+        std::atomic<uint32_t> pending = 0;
+        std::mutex mutex;
+        std::vector<Job*> continuations;
+        std::exception_ptr error;
+    };
+
+    /**
+     * Chase-Lev work-stealing deque of fixed capacity. Only the owning worker may
+     * push() and pop() at the bottom; any thread may steal() from the top.
+     */
+    class WorkStealingDeque
+    {
+    public:
+        static constexpr int64_t CAPACITY = 4096;
+
+        WorkStealingDeque();
+        DISALLOW_COPY(WorkStealingDeque)
+
+        // false if the deque is full
+        bool push(Job* job);
+        Job* pop();
+        Job* steal();
+
+    private:
+        static constexpr int64_t MASK = CAPACITY - 1;
+        static_assert((CAPACITY & MASK) == 0, "Deque capacity must be a power of two");
+
+        // top and bottom are on their own cache lines, as thieves hammer one and the owner the other
+        alignas(64) std::atomic<int64_t> top = 0;
+        alignas(64) std::atomic<int64_t> bottom = 0;
+        std::array<std::atomic<Job*>, CAPACITY> buffer;
+    };
+}
+
+/**
+ * Work-stealing job scheduler. Worker 0 has no thread of its own: it is the thread
+ * constructing the system until another one takes it over with registerThread(),
+ * and it runs jobs while it waits. Every other worker is a background thread. Each
+ * worker pushes the jobs it spawns to its own deque and steals from the others when
+ * it runs dry. Jobs queued from threads outside the system go through a shared
+ * injection queue instead, whose lock is only taken while it holds jobs.
+ *
+ * Waiting never blocks a worker: wait() keeps running queued jobs until its counter
+ * is done, so jobs may wait on other jobs.
+ *
+ * Work that has to stay on one thread (GLFW calls on the main thread, queue
+ * submission on the render thread) is queued with runOnThread() and run by that
+ * thread in pumpThread(), or while it waits. Threads outside the system may queue
+ * jobs and wait on them too; they steal from every worker while waiting.
+ */
+class JobSystem
+{
+public:
+    /**
+     * @param threadCount Workers including the calling thread; 0 uses every hardware thread.
+     * @param pinThreads Pin worker i to logical core i.
+     */
+    explicit JobSystem(uint32_t const& threadCount = 0, bool const& pinThreads = false);
+
+    DISALLOW_COPY(JobSystem)
+
+    ~JobSystem();
+
+    [[nodiscard]]
+    uint32_t threadCount() const;
+
+    /**
+     * Makes the calling thread worker 0, so the jobs it queues go to a deque of its own.
+     * Worker 0 should be the thread scheduling the most work, e.g. a render thread; its
+     * previous thread must have called releaseThread() before this thread starts.
+     */
+    void registerThread();
+
+    // the calling thread, worker 0, leaves the system and queues through the injection queue
+    void releaseThread();
+
+    void run(std::function<void()> fn, Jobs::Counter* counter = nullptr);
+
+    /**
+     * Queues a long job for the background workers only. Waiting threads never pick
+     * these up, so they cannot stall whoever waits on frame work. Falls back to run()
+     * when the system has no background workers.
+     */
+    void runBackground(std::function<void()> fn, Jobs::Counter* counter = nullptr);
+    void runAfter(Jobs::Counter& dependency, std::function<void()> fn, Jobs::Counter* counter = nullptr);
+    void wait(Jobs::Counter& counter);
+
+    /**
+     * Calls body(begin, end) over [0, count) in ranges of at most grainSize, and waits for all of them.
+     */
+    void parallelFor(
+            uint32_t const& count,
+            uint32_t const& grainSize,
+            std::function<void(uint32_t, uint32_t)> const& body);
+
+    // runs fn right away when called from that thread
+    void runOnThread(std::thread::id const& thread, std::function<void()> fn, Jobs::Counter* counter = nullptr);
+    void runOnMainThread(std::function<void()> fn, Jobs::Counter* counter = nullptr);
+
+    // runs the jobs queued for the calling thread
+    void pumpThread();
+    void pumpMainThread();
+
+protected:
+    void workerLoop(uint32_t workerIdx);
+
+    void schedule(Jobs::Job* job);
+    void execute(Jobs::Job* job);
+    // hands a job's exception to its counter, or logs it when the job has none
+    void reportError(Jobs::Job* job, std::exception_ptr const& error, char const* what);
+    void finish(Jobs::Counter& counter);
+
+    // the next job for the calling thread, or nullptr if there is none anywhere
+    Jobs::Job* findJob();
+    Jobs::Job* findBackgroundJob();
+
+private:
+    std::vector<std::unique_ptr<Jobs::WorkStealingDeque>> deques;
+    std::vector<std::thread> threads;
+    std::thread::id mainThread;
+    std::atomic<bool> stopping = false;
+
+    // the counts let idle threads skip the locks while the queues are empty
+    std::mutex injectionMutex;
+    std::deque<Jobs::Job*> injectionQueue;
+    std::atomic<uint32_t> injectionCount = 0;
+
+    std::mutex backgroundMutex;
+    std::deque<Jobs::Job*> backgroundQueue;
+    std::atomic<uint32_t> backgroundCount = 0;
+
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    std::atomic<uint32_t> sleepingWorkers = 0;
+
+    std::mutex affineMutex;
+    std::map<std::thread::id, std::vector<Jobs::Job*>> affineJobs;
+    // lets wait() skip the lock while nothing is queued for any thread
+    std::atomic<uint32_t> affineJobCount = 0;
+};
@@ -0,0 +1,110 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Lights.h"
+#include "Buffers.h"
+#include "JobSystem.h"
+
+/**
+ * Froxel grid for clustered forward lighting, matching shaders/include/clusters.hlsli.
+ * The view frustum is split into GRID_X by GRID_Y screen tiles and GRID_Z depth slices,
+ * spaced exponentially between the clip planes. Each cluster lists the ranged point
+ * lights reaching into it, so a pixel only shades those.
+ *
+ * The cluster buffer holds the light count of every cluster, followed by
+ * MAX_LIGHTS_PER_CLUSTER light indices per cluster.
+ */
+namespace LightClusters
+{
+    constexpr uint32_t GRID_X = 16;
+    constexpr uint32_t GRID_Y = 9;
+    constexpr uint32_t GRID_Z = 24;
+    constexpr uint32_t CLUSTER_COUNT = GRID_X * GRID_Y * GRID_Z;
+    constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 256;
+
+    // lights in the scene, global and clustered
+    constexpr uint32_t MAX_LIGHTS = 32768;
+
+    // threads of clusters.comp, one cluster each
+    constexpr uint32_t WORKGROUP_SIZE = 64;
+
+    constexpr VkDeviceSize bufferSize()
+    {
+        return CLUSTER_COUNT * (1 + MAX_LIGHTS_PER_CLUSTER) * sizeof(uint32_t);
+    }
+
+    /**
+     * Slice of a view depth d: log(d) * scale + bias, so that slice 0 starts at the near
+     * plane and slice GRID_Z at the far one.
+     */
+    struct DepthSlicing
+    {
+        float scale;
+        float bias;
+
+        static DepthSlicing fromClipPlanes(float const& clipNear, float const& clipFar);
+
+        // view depth where slice starts
+        [[nodiscard]]
+        float sliceDepth(uint32_t const& slice) const;
+    };
+}
+
+/**
+ * Bins ranged point lights into light clusters on the CPU, the fallback for the
+ * clusters.comp pass. Each light is brought to view space and given the range of
+ * tiles and slices its bounding sphere may touch, eight lights at a time with AVX2
+ * when built with ENABLE_AVX2 (scalar otherwise). Lights are then scattered into
+ * clusters one depth slice per job.
+ */
+class LightBinner
+{
+public:
+    static constexpr size_t SIMD_WIDTH = 8;
+
+    /**
+     * Bins lights[i] as light firstIndex + i of the scene; all of them must be point
+     * lights with a range. Clusters with more than MAX_LIGHTS_PER_CLUSTER lights keep
+     * the first ones.
+     */
+    void bin(
+            std::vector<Light> const& lights,
+            uint32_t const& firstIndex,
+            glm::mat4 const& view,
+            glm::mat4 const& proj,
+            LightClusters::DepthSlicing const& slicing,
+            JobSystem& jobs);
+
+    // copies the clusters into a host-visible cluster buffer, skipping unused slots
+    VkResult upload(Buffers::Buffer& clusterBuffer) const;
+
+    // scene indices of the lights binned into cluster
+    [[nodiscard]]
+    std::vector<uint32_t> clusterLights(uint32_t const& cluster) const;
+
+private:
+    struct Projection
+    {
+        glm::mat4 view;
+        float scaleX, scaleY;
+        float clipNear, clipFar;
+        // view depths where slices 1 to GRID_Z - 1 start
+        std::array<float, LightClusters::GRID_Z - 1> sliceStarts;
+    };
+
+    void computeRanges(std::vector<Light> const& lights, Projection const& projection, uint32_t first, uint32_t last);
+    void computeRange(Light const& light, Projection const& projection, size_t const& idx);
+    void scatter(uint32_t const& firstIndex, uint32_t const& slice);
+
+    size_t count = 0;
+    // inclusive cluster ranges of each light, padded to the SIMD width; empty when minZ > maxZ
+    std::vector<int32_t> minX, maxX;
+    std::vector<int32_t> minY, maxY;
+    std::vector<int32_t> minZ, maxZ;
+
+    std::vector<uint32_t> counts = std::vector<uint32_t>(LightClusters::CLUSTER_COUNT, 0);
+    std::vector<uint32_t> indices;
+};
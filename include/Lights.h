@@ -19,10 +19,11 @@ struct Light
     VEC4_ALIGN
     glm::vec4 color;
     glm::vec4 position;
-    glm::vec4 parameters;
+    glm::vec4 parameters; // x: range of a point light, 0 for unbounded
 
     static VkShaderStageFlags stageFlags()
     {
-        return VK_SHADER_STAGE_FRAGMENT_BIT;
+        // the light clustering pass reads them too
+        return VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
     }
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "StorageBufferArray.h"
+#include "DescriptorAllocator.h"
+#include "DescriptorLayoutCache.h"
+
+struct MaterialRecord
+{
+    glm::vec4 baseColor;
+    glm::vec4 params; // roughness, metallic, F0, specular (0 for a diffuse-only material)
+    uint32_t textureIdx;
+    uint32_t _unused[3]; // pads to the std430 array stride
+
+    static VkShaderStageFlags stageFlags()
+    {
+        return VK_SHADER_STAGE_FRAGMENT_BIT;
+    }
+};
+
+/**
+ * Storage buffer of materials indexed by draws, in a set of its own.
+ * The layout belongs to the layout cache and the set to the allocator passed in,
+ * which must not be reset while the table is in use.
+ */
+class MaterialTable
+{
+public:
+    static constexpr uint32_t MAX_MATERIALS = 1024;
+
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+    MaterialTable(
+            VkDevice* logicalDev,
+            VmaAllocator* allocator,
+            VkPhysicalDevice const& physDev,
+            DescriptorAllocator& descAllocator,
+            DescriptorLayoutCache& layoutCache);
+
+    uint32_t registerMaterial(MaterialRecord const& material);
+    void updateMaterial(uint32_t const& idx, MaterialRecord const& material);
+
+private:
+    std::unique_ptr<StorageBufferArray<MaterialRecord>> materialBuffer;
+    std::vector<MaterialRecord> materials;
+};
@@ -19,15 +19,48 @@ public:
     Mesh() = default;
     ~Mesh() = default;
 
+    /**
+     * @param layout How buf holds the vertices. With VERTEX_LAYOUT_SPLIT_POSITIONS,
+     * it holds all positions, then all VertexAttributes, then the indices.
+     */
     Mesh(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice* physDev,
-         std::string const& objFile);
+         std::string const& objFile, VertexLayout layout = VERTEX_LAYOUT_INTERLEAVED);
 
+    // both layouts take up the same space, so indices start at the same offset
     [[nodiscard]]
     size_t idxOffset() const;
 
+    [[nodiscard]]
+    VertexLayout vertexLayout() const;
+
+    // offsets of the vertex streams in buf
+    [[nodiscard]]
+    VertexStreams vertexStreams() const;
+
     [[nodiscard]]
     size_t idxCount() const;
 
+    [[nodiscard]]
+    std::vector<NVertex> const& vertices() const;
+
+    [[nodiscard]]
+    std::vector<uint32_t> const& vertexIndices() const;
+
+    // the vertices split into the streams of a split layout, built on each call for uploads
+    [[nodiscard]]
+    std::vector<glm::vec3> positionStream() const;
+
+    [[nodiscard]]
+    std::vector<VertexAttributes> attributeStream() const;
+
+    // whether the obj file had texture coordinates; without them every vertex has (0, 0)
+    [[nodiscard]]
+    bool hasTexCoords() const;
+
+    // bounding sphere in model space: center in xyz, radius in w
+    [[nodiscard]]
+    glm::vec4 boundingSphere() const;
+
     std::shared_ptr<Buffers::StagingBuffer> stagingBuffer(std::set<uint32_t> const& transferQueues);
 
     Mesh(Mesh const&) = delete;
@@ -36,8 +69,14 @@ public:
     Mesh(Mesh&& mesh) noexcept;
     Mesh& operator=(Mesh&& mesh) noexcept;
 private:
+    [[nodiscard]]
+    glm::vec4 computeBoundingSphere() const;
+
     std::vector<NVertex> verts;
     std::vector<uint32_t> indices;
+    VertexLayout layout = VERTEX_LAYOUT_INTERLEAVED;
+    bool texCoords = false;
+    glm::vec4 bounds = glm::vec4(0.f);
 
     VmaAllocator* allocator = nullptr;
     VkPhysicalDevice* physDev = nullptr;
@@ -0,0 +1,49 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * VkPipelineCache shared by every pipeline the engine creates, persisted to disk
+ * between runs. The file is only loaded if its header matches the device: same
+ * vendor, device ID and pipeline cache UUID (which drivers change with every build
+ * whose compiler output differs). Anything else starts from an empty cache.
+ *
+ * save() writes to a temporary file and renames it over the old one, so a crash
+ * mid-write never leaves a truncated cache behind. With no path the cache only
+ * lives for the run.
+ */
+class PipelineCache : public AVkGraphicsBase
+{
+public:
+    VkPipelineCache cache = VK_NULL_HANDLE;
+
+    PipelineCache() = default;
+    PipelineCache(VkDevice* logicalDev, VkPhysicalDevice const& physDev, std::string path);
+
+    DISALLOW_COPY(PipelineCache)
+
+    PipelineCache(PipelineCache&& pipelineCache) noexcept;
+    PipelineCache& operator=(PipelineCache&& pipelineCache) noexcept;
+
+    ~PipelineCache() override;
+
+    /**
+     * Writes the cache out if it grew since it was loaded or last saved. The cache is
+     * internally synchronized, so this may run while other threads create pipelines.
+     * @return false if the file could not be written.
+     */
+    bool save();
+
+private:
+    void dispose();
+
+    // the file's contents if they were written for this device, otherwise nothing
+    [[nodiscard]]
+    std::vector<char> loadFile(VkPhysicalDevice const& physDev) const;
+
+    std::string path;
+    size_t savedSize = 0;
+};
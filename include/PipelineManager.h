@@ -0,0 +1,138 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "GraphicsPipeline.h"
+#include "JobSystem.h"
+#include "DrawKey.h"
+#include <future>
+#include <mutex>
+
+/**
+ * Compiles variants of one graphics pipeline on the job system, through the shared
+ * pipeline cache. Variants share the generic pipeline's layout and fixed-function
+ * state, and differ in shaders and specialization constants.
+ *
+ * request() only queues a compile and returns the variant's id; get() is lock-free
+ * and returns the generic pipeline until the variant is ready, so registering new
+ * variants never stalls recording. Id 0 always stands for the generic pipeline.
+ *
+ * With VK_EXT_graphics_pipeline_library, the vertex input and fragment output
+ * interfaces are built once, each shader becomes a library of its own (shared by
+ * every variant using it) and variants are fast-linked from those, which costs a
+ * fraction of a full compile.
+ */
+class PipelineManager : public AVkGraphicsBase
+{
+public:
+    // ids have to fit the pipeline field of a DrawKey
+    static constexpr uint32_t MAX_VARIANTS = 1u << DrawKey::PIPELINE_BITS;
+
+    /**
+     * @param layout Layout of the generic pipeline; it must outlive the manager.
+     * @param colorFormat Format of the swapchain drawn to; variants work with the
+     * render pass of any swapchain of that format.
+     * @param depthPrePass DEPTH_PRE_PASS_TEST when frames are drawn after a depth
+     * pre-pass, in which case variants leave depth alone.
+     * @param vertexLayout Layout of the meshes variants draw.
+     * @param deferred Variants fill the G-buffer in the first subpass of the deferred
+     * render pass, instead of shading.
+     * @param useLibraries Link variants from pipeline libraries; needs
+     * VK_EXT_graphics_pipeline_library enabled.
+     */
+    PipelineManager(
+            VkDevice* logicalDev,
+            VkPhysicalDevice const& physDev,
+            JobSystem& jobs,
+            VkPipelineCache const& pipelineCache,
+            VkPipelineLayout const& layout,
+            VkPipeline const& genericPipeline,
+            VkFormat const& colorFormat,
+            bool enableDepthTest,
+            DepthPrePass depthPrePass,
+            VertexLayout vertexLayout,
+            bool deferred,
+            bool useLibraries);
+
+    // queued compiles point back at the manager
+    DISALLOW_COPY(PipelineManager)
+    PipelineManager(PipelineManager&&) = delete;
+    PipelineManager& operator=(PipelineManager&&) = delete;
+
+    // waits for the compiles still running
+    ~PipelineManager() override;
+
+    /**
+     * Queues the variant unless it was requested before. Returns its id, or 0 (the
+     * generic pipeline) once MAX_VARIANTS ids are taken.
+     */
+    uint32_t request(PipelineVariant const& variant);
+
+    // ready once the variant is compiled; holds VK_NULL_HANDLE if compiling failed
+    [[nodiscard]]
+    std::shared_future<VkPipeline> future(uint32_t const& id) const;
+
+    // the variant if it is ready, the generic pipeline otherwise. Never blocks
+    [[nodiscard]]
+    VkPipeline get(uint32_t const& id) const;
+
+    [[nodiscard]]
+    uint32_t pending() const;
+
+    [[nodiscard]]
+    bool usesLibraries() const;
+
+private:
+    struct Variant
+    {
+        std::atomic<VkPipeline> pipeline = VK_NULL_HANDLE;
+        std::promise<VkPipeline> compiled;
+        std::shared_future<VkPipeline> future;
+    };
+
+    struct VariantHash
+    {
+        size_t operator()(PipelineVariant const& variant) const
+        {
+            return variant.hash();
+        }
+    };
+
+    using LibraryKey = std::tuple<VkShaderStageFlagBits, std::string, std::vector<uint32_t>>;
+
+    VkPipeline compile(PipelineVariant const& variant);
+    VkPipeline compileComplete(PipelineVariant const& variant);
+    VkPipeline linkLibraries(PipelineVariant const& variant);
+
+    // builds the parts of a pipeline named by flags; stage is only read for shader parts
+    VkPipeline createLibrary(uint32_t const& flags, PipelineShaderStage const* stage);
+    VkPipeline shaderLibrary(
+            VkShaderStageFlagBits const& stage, std::string const& fileName, std::vector<uint32_t> const& constants);
+
+    void dispose();
+
+    JobSystem* jobs = nullptr;
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    VkPipeline genericPipeline = VK_NULL_HANDLE;
+    // a render pass of its own, so compiles never depend on the swapchain of the day
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    PipelineFixedState fixedState;
+    bool useLibraries;
+
+    VkPipeline vertexInputLibrary = VK_NULL_HANDLE;
+    VkPipeline fragmentOutputLibrary = VK_NULL_HANDLE;
+    std::mutex libraryMutex;
+    std::map<LibraryKey, VkPipeline> shaderLibraries;
+
+    // guards variantIds, variantCount and each variant's future
+    mutable std::mutex variantMutex;
+    std::unordered_map<PipelineVariant, uint32_t, VariantHash> variantIds;
+    std::array<Variant, MAX_VARIANTS> variants;
+    uint32_t variantCount = 1;
+
+    Jobs::Counter compiles;
+    std::atomic<uint32_t> pendingCompiles = 0;
+};
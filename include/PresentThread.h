@@ -0,0 +1,77 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/**
+ * Presents swapchain images from a thread of its own, for when the present queue
+ * is not the graphics queue. The render thread queues each present right after
+ * its submit and moves on to the next frame instead of waiting in
+ * vkQueuePresentKHR.
+ *
+ * Presenting and acquiring both need the swapchain externally synchronized, so
+ * acquires must hold swapchainMutex() too. Presents are counted in queue order;
+ * before reusing a semaphore an earlier present waits on, wait for that present
+ * to be issued with waitForIssued().
+ */
+class PresentThread
+{
+public:
+    explicit PresentThread(VkQueue presentQueue);
+    DISALLOW_COPY(PresentThread)
+
+    ~PresentThread();
+
+    void present(VkSwapchainKHR swapchain, uint32_t const& imageIdx, VkSemaphore waitSemaphore);
+
+    /**
+     * Blocks until at least count presents have been handed to the queue. Throws if
+     * any of them failed for reasons other than the swapchain going out of date.
+     */
+    void waitForIssued(uint64_t const& count);
+
+    // blocks until every queued present has been handed to the queue
+    void drain();
+
+    [[nodiscard]]
+    uint64_t queued() const;
+
+    // true if a present found the swapchain out of date or suboptimal since the last call
+    bool takeOutOfDate();
+
+    std::mutex& swapchainMutex();
+
+protected:
+    void presentLoop();
+
+private:
+    struct PresentRequest
+    {
+        VkSwapchainKHR swapchain;
+        uint32_t imageIdx;
+        VkSemaphore waitSemaphore;
+    };
+
+    VkQueue queue;
+    std::mutex swapchainLock;
+
+    // guards everything below
+    mutable std::mutex requestMutex;
+    std::condition_variable requestQueued;
+    std::condition_variable requestIssued;
+    std::deque<PresentRequest> requests;
+    uint64_t queuedCount = 0;
+    uint64_t issuedCount = 0;
+    bool outOfDate = false;
+    bool failed = false;
+    bool stopping = false;
+
+    // started last, once everything it reads is initialized
+    std::thread thread;
+};
@@ -18,10 +18,13 @@ public:
     optional<uint32_t> graphicsFamily;
     optional<uint32_t> presentationFamily;
     optional<uint32_t> transferFamily;
+    optional<uint32_t> computeFamily; // only set for a compute family without graphics
 
     uint32_t transferQueueFamily();
+    uint32_t computeQueueFamily();
 
     std::set<uint32_t> queuesForTransfer();
+    std::set<uint32_t> queuesForCompute();
 };
 
 
@@ -0,0 +1,85 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+enum DrawPath : uint32_t
+{
+    DRAW_PATH_DYNAMIC_UBO = 0,
+    DRAW_PATH_BINDLESS = 1,
+    DRAW_PATH_BUFFER_ADDRESS = 2,
+    DRAW_PATH_PUSH_CONSTANT = 3,
+    DRAW_PATH_INSTANCED = 4,
+    DRAW_PATH_GPU_DRIVEN = 5,
+};
+
+inline char const* drawPathName(DrawPath const& path)
+{
+    switch (path)
+    {
+        case DRAW_PATH_BINDLESS:
+            return "bindless";
+        case DRAW_PATH_BUFFER_ADDRESS:
+            return "buffer device address";
+        case DRAW_PATH_PUSH_CONSTANT:
+            return "push constant";
+        case DRAW_PATH_INSTANCED:
+            return "instanced";
+        case DRAW_PATH_GPU_DRIVEN:
+            return "gpu-driven";
+        case DRAW_PATH_DYNAMIC_UBO:
+        default:
+            return "dynamic uniform buffer";
+    }
+}
+
+struct RenderOptions
+{
+    DrawPath drawPath = DRAW_PATH_PUSH_CONSTANT;
+
+    // frames to time before exiting; 0 runs interactively
+    uint32_t benchmarkFrames = 0;
+
+    // total drawables in the scene; extra teapots are laid out on a grid. 0 keeps the default scene
+    uint32_t drawCount = 0;
+
+    // ranged point lights added to the scene, shaded through the light clusters
+    uint32_t lightCount = 0;
+    // bin lights into clusters on the CPU instead of in a compute pass
+    bool cpuLightBinning = false;
+
+    // reject drawables outside the view or smaller than minScreenPixels before recording
+    bool cpuCulling = true;
+    float minScreenPixels = 2.f;
+
+    // lay down depth in a position-only pass first, so the lit pass shades each pixel once
+    bool depthPrePass = false;
+
+    // keep mesh positions in a stream of their own, so position-only passes fetch 12 bytes per vertex
+    bool splitPositions = false;
+
+    // fill a G-buffer in one subpass and light it per pixel in the next, instead of shading draws
+    bool deferredShading = false;
+
+    // sort draws by pipeline, mesh, material and depth before recording
+    bool sortDraws = true;
+
+    // job system workers, including the main thread; 0 uses every hardware thread, 1 runs everything inline
+    uint32_t jobThreads = 0;
+    bool pinThreads = false;
+
+    // render on a thread of its own, fed scene snapshots by the simulation on the main thread
+    bool renderThread = true;
+    // simulation steps per second on the main thread while the render thread runs
+    uint32_t simulationRate = 120;
+    // present from another thread when the device has a separate present queue
+    bool presentThread = true;
+
+    // where compiled pipelines are kept between runs; empty keeps them in memory only
+    std::string pipelineCachePath = "pipeline.cache";
+
+    // load shaders from SPIR-V files here instead of the ones built into the executable
+    std::string shaderDirectory;
+};
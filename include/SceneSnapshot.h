@@ -0,0 +1,19 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Everything the render thread needs from one simulation step. The simulation
+ * thread fills one in full and hands it over through a TripleBuffer; once
+ * published it is never written again until the renderer has moved on from it.
+ */
+struct SceneSnapshot
+{
+    // milliseconds of simulated time
+    float totalTime = 0;
+    // model matrix of every drawable, by drawable index
+    std::vector<glm::mat4> models;
+};
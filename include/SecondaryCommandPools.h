@@ -0,0 +1,66 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+
+/**
+ * Command pools for recording secondary command buffers on several threads: one
+ * pool per worker per frame in flight, each holding a secondary buffer per pass
+ * drawn, so no two threads ever touch the same pool. A frame's pools are reset
+ * together once its fence has been waited on.
+ */
+class SecondaryCommandPools : public AVkGraphicsBase
+{
+public:
+    // below this many draws per worker, threading costs more than it saves
+    static constexpr uint32_t MIN_DRAWS_PER_WORKER = 128;
+
+    SecondaryCommandPools() = default;
+    SecondaryCommandPools(
+            VkDevice* logicalDev,
+            uint32_t const& graphicsFamily,
+            uint32_t const& workerCount,
+            uint32_t const& passCount = 1);
+
+    DISALLOW_COPY(SecondaryCommandPools)
+
+    SecondaryCommandPools(SecondaryCommandPools&& pools) noexcept;
+    SecondaryCommandPools& operator=(SecondaryCommandPools&& pools) noexcept;
+
+    ~SecondaryCommandPools() override;
+
+    [[nodiscard]]
+    uint32_t workerCount() const;
+
+    VkResult resetFrame(uint32_t const& frameIdx);
+
+    /**
+     * Begins the worker's secondary buffer for a pass of the frame, continuing subpass 0 of renderPass.
+     */
+    VkResult begin(
+            uint32_t const& frameIdx,
+            uint32_t const& workerIdx,
+            uint32_t const& passIdx,
+            VkRenderPass const& renderPass,
+            VkFramebuffer const& framebuffer,
+            VkCommandBuffer& cmdBuf);
+
+    [[nodiscard]]
+    VkCommandBuffer const& cmdBuffer(
+            uint32_t const& frameIdx, uint32_t const& workerIdx, uint32_t const& passIdx = 0) const;
+
+protected:
+    VkResult createPools(uint32_t const& graphicsFamily);
+
+private:
+    void dispose();
+
+    uint32_t workers = 0;
+    uint32_t passes = 1;
+    // indexed by frameIdx * workers + workerIdx
+    std::vector<VkCommandPool> cmdPools;
+    // passes per pool, the pool's buffers next to each other
+    std::vector<VkCommandBuffer> cmdBuffers;
+};
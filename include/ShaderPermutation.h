@@ -0,0 +1,74 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "Lights.h"
+#include "GraphicsPipeline.h"
+
+/**
+ * Permutation of the lit shaders a draw needs, matching shaders/include/permutation.hlsli.
+ * The light types present and a bound on the light count are specialization constants;
+ * material features pick one of the shader variants compiled by CMake. The default
+ * permutation is the generic one, which shades any scene and material.
+ */
+struct ShaderPermutation
+{
+    enum LightTypeBits : uint32_t
+    {
+        POINT_LIGHT_BIT = 1u << POINT_LIGHT,
+        DIRECTIONAL_LIGHT_BIT = 1u << DIRECTIONAL_LIGHT,
+        ALL_LIGHT_TYPES = POINT_LIGHT_BIT | DIRECTIONAL_LIGHT_BIT,
+    };
+
+    enum MaterialFeatureBits : uint32_t
+    {
+        MATERIAL_SPECULAR = 1u << 0,
+        ALL_MATERIAL_FEATURES = MATERIAL_SPECULAR,
+    };
+
+    // bound on the global lights; clustered lights are not part of the permutation
+    static constexpr uint32_t MAX_LIGHTS = 64;
+
+    uint32_t lightTypes = ALL_LIGHT_TYPES;
+    uint32_t maxLights = MAX_LIGHTS;
+    uint32_t materialFeatures = ALL_MATERIAL_FEATURES;
+
+    /**
+     * The permutation shading lights, for any material. The light count is rounded up
+     * to a power of two, so a scene gaining or losing a light rarely needs a new one.
+     */
+    static ShaderPermutation forLights(std::vector<Light> const& lights);
+
+    /**
+     * This permutation, reduced to the features the material uses.
+     * @param params Roughness, metallic, F0 and the specular flag, as in MaterialRecord.
+     */
+    [[nodiscard]]
+    ShaderPermutation withMaterial(glm::vec4 const& params) const;
+
+    // specialization constants, indexed by constant_id
+    [[nodiscard]]
+    std::vector<uint32_t> constants() const;
+
+    /**
+     * The pipeline variant drawing this permutation with the shaders named baseName,
+     * e.g. main.vert.spv and main.frag.spv (or main.diffuse.frag.spv).
+     */
+    [[nodiscard]]
+    PipelineVariant pipelineVariant(std::string const& baseName) const;
+
+    bool operator==(ShaderPermutation const& other) const;
+
+    [[nodiscard]]
+    size_t hash() const;
+
+    struct Hash
+    {
+        size_t operator()(ShaderPermutation const& permutation) const
+        {
+            return permutation.hash();
+        }
+    };
+};
@@ -7,9 +7,38 @@
 
 namespace Shaders
 {
+    // SPIR-V linked into the executable by the build; see cmake/EmbedShaders.cmake
+    struct EmbeddedShader
+    {
+        char const* name;
+        uint32_t const* code;
+        size_t codeSize; // in bytes
+    };
+
+    extern EmbeddedShader const embeddedShaders[];
+    extern size_t const embeddedShaderCount;
+
+    /**
+     * Loads shaders from files in dir rather than the embedded ones, so they can be
+     * recompiled without relinking. Set it before creating any pipeline; an empty dir
+     * goes back to the embedded shaders.
+     */
+    void setOverrideDirectory(std::string const& dir);
+
+    // the embedded shader called fileName, or nullptr
+    EmbeddedShader const* findEmbedded(std::string const& fileName);
+
     std::vector<uint8_t> readBytecode(std::string const& fileName);
+    std::pair<VkShaderModule, VkResult> createShaderModule(
+            VkDevice const& logicalDev, uint32_t const* code, size_t const& codeSize);
     std::pair<VkShaderModule, VkResult> createShaderModule(
             VkDevice const& logicalDev, std::vector<uint8_t> const& spvSource);
+
+    /**
+     * Creates a module from the shader called fileName (e.g. main.vert.spv): from the
+     * override directory if one is set, otherwise from the embedded shaders, otherwise
+     * from a file on the search path.
+     */
     std::tuple<VkShaderModule, VkResult>
             createShaderModule(VkDevice const& logicalDev, std::string const& fileName);
-} // namespace shaders
\ No newline at end of file
+} // namespace shaders
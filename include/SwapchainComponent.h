@@ -20,16 +20,22 @@ public:
     VkRenderPass renderPass = VK_NULL_HANDLE;
     SwapChainsDetail detail;
 
-    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-
     SwapchainComponents() = default;
 
+    /**
+     * @param oldSwapchain The swapchain being replaced, if any. It is retired, but stays
+     * valid (and must be destroyed by its owner) until the frames using it are done.
+     * @param gbufferViews The G-buffer attachments for deferred shading; none for
+     * forward shading. See createRenderPass.
+     */
     SwapchainComponents(
             VkDevice* logicalDev,
             VkPhysicalDevice const& physDevice,
             VkSurfaceKHR const& surface,
             std::pair<size_t, size_t> const& windowSize,
-            std::optional<VkImageView> const& depthBufferImgView
+            std::optional<VkImageView> const& depthBufferImgView,
+            VkSwapchainKHR oldSwapchain = VK_NULL_HANDLE,
+            std::vector<VkImageView> const& gbufferViews = {}
             );
 
     SwapchainComponents(SwapchainComponents const&) = delete;
@@ -43,12 +49,25 @@ public:
     [[nodiscard]]
     uint32_t imageCount() const;
 
+    /**
+     * Creates the scene render pass for a swapchain of the given format. Pipelines
+     * built against one work with the render pass of any swapchain of that format.
+     * With deferred, it has two subpasses: the scene fills the GBuffer attachments in
+     * subpass 0, and subpass 1 shades from them as input attachments.
+     */
+    static VkResult createRenderPass(
+            VkDevice const& logicalDev,
+            VkPhysicalDevice const& physDevice,
+            VkFormat const& colorFormat,
+            VkRenderPass& renderPass,
+            bool const& deferred = false);
+
 protected:
     VkResult initSwapChain(
             VkPhysicalDevice const& physDevice,
             std::pair<size_t, size_t> const& windowHeight,
-            VkSurfaceKHR const& surface);
+            VkSurfaceKHR const& surface,
+            VkSwapchainKHR oldSwapchain);
 
-    VkResult createRenderPasses(VkPhysicalDevice const& physDevice);
-    VkResult createDescriptorPool();
+    VkResult createRenderPasses(VkPhysicalDevice const& physDevice, bool const& deferred);
 };
\ No newline at end of file
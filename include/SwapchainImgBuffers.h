@@ -9,20 +9,41 @@
 #include "UniformObjects.h"
 #include "Lights.h"
 #include "StorageBufferArray.h"
+#include "LightClusters.h"
+#include "DescriptorAllocator.h"
+#include "DescriptorLayoutCache.h"
+#include "DescriptorUpdateTemplate.h"
+
+// Descriptor infos for the scene set, laid out for vkUpdateDescriptorSetWithTemplate
+struct FrameDescriptorData
+{
+    VkDescriptorBufferInfo uniforms;
+    VkDescriptorImageInfo image;
+    VkDescriptorBufferInfo lights;
+    VkDescriptorBufferInfo clusters;
+};
+
+struct MeshDescriptorData
+{
+    VkDescriptorBufferInfo meshUniform;
+};
 
 class SwapchainImageBuffers : public AVkGraphicsBase
 {
 public:
+    // layouts are owned by the DescriptorLayoutCache they came from
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     VkDescriptorSetLayout meshDescriptorSetLayout = VK_NULL_HANDLE;
 
     std::vector<UniformObjBuffer<UniformObjects>> unifBuffers;
-    std::vector<StorageBufferArray<Light>> lightSBOs;
+    // up to LightClusters::MAX_LIGHTS, with no header; the counts are uniforms
+    std::vector<Buffers::Buffer> lightBuffers;
+    std::vector<Buffers::Buffer> clusterBuffers;
     std::vector<VkDescriptorSet> descriptorSets;
     std::vector<VkDescriptorSet> meshDescriptorSets;
 
     SwapchainImageBuffers() = default;
-    ~SwapchainImageBuffers();
+    ~SwapchainImageBuffers() = default;
 
     SwapchainImageBuffers(SwapchainImageBuffers const&) = delete;
     SwapchainImageBuffers& operator=(SwapchainImageBuffers const&) = delete;
@@ -36,21 +57,34 @@ public:
             VmaAllocator* allocator,
             VkPhysicalDevice const& physDev,
             SwapchainComponents const& swapchainComponent,
+            DescriptorAllocator& descAllocator,
+            DescriptorLayoutCache& layoutCache,
             Image::Image& img,
-            uint32_t const& binding);
+            uint32_t const& binding,
+            bool hostClusters = false);
 
-    void createUniformBuffers(VkPhysicalDevice const& physDev, SwapchainComponents const& swapchainComponent);
+    /**
+     * @param hostClusters Keep the light clusters in host-visible memory, for binning on
+     * the CPU; otherwise they are device-local and written by the clustering pass.
+     */
+    void createUniformBuffers(
+            VkPhysicalDevice const& physDev, SwapchainComponents const& swapchainComponent, bool hostClusters);
     void configureBuffers(uint32_t const& binding, Image::Image& img);
     void configureMeshBuffers(uint32_t const& binding, DynUniformObjBuffer<MeshUniform> const& unif);
-    VkResult createDescriptorSetLayout();
-    VkResult createDescriptorSets(SwapchainComponents const& swapchainComponent);
+    void createDescriptorSetLayout(DescriptorLayoutCache& layoutCache);
+    VkResult createDescriptorSets(DescriptorAllocator& descAllocator);
 
-    VkResult createMeshDescriptorSetLayout();
-    VkResult createMeshDescriptorSets(VkDescriptorPool const& descPool);
+    void createMeshDescriptorSetLayout(DescriptorLayoutCache& layoutCache);
+    VkResult createMeshDescriptorSets(DescriptorAllocator& descAllocator);
     std::pair<UniformObjBuffer<UniformObjects>&, VkDescriptorSet& >
             operator[](uint32_t const& i);
 
 private:
+    void createUpdateTemplates();
+
+    DescriptorUpdateTemplate frameUpdateTemplate;
+    DescriptorUpdateTemplate meshUpdateTemplate;
+
     VmaAllocator* allocator=nullptr;
     uint32_t imgSize=0;
 };
\ No newline at end of file
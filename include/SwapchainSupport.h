@@ -10,14 +10,16 @@ class SwapchainImageSupport : public AVkGraphicsBase
 public:
     VkImageView imageView = VK_NULL_HANDLE;
     VkFramebuffer frameBuffer = VK_NULL_HANDLE;
-    VkFence imagesInFlight = VK_NULL_HANDLE;
+    // FrameTimeline value of the last frame rendered to this image; 0 if none yet
+    uint64_t timelineValue = 0;
 
     SwapchainImageSupport() = default;
     SwapchainImageSupport(
             VkDevice* logicalDev,
             VkRenderPass const& renderPass, VkExtent2D const& extent,
             VkImage const& swapChainImage, VkFormat const& swapchainFormat,
-            std::optional<VkImageView> const& depthBufferImgView);
+            std::optional<VkImageView> const& depthBufferImgView,
+            std::vector<VkImageView> const& gbufferViews = {});
 
     SwapchainImageSupport(SwapchainImageSupport const&) = delete;
     SwapchainImageSupport& operator=(SwapchainImageSupport const&) = delete;
@@ -31,7 +33,8 @@ protected:
     VkResult createFramebuffer(
             VkRenderPass const& renderPass,
             VkExtent2D const& extent,
-            std::optional<VkImageView> const& depthBufferImgView);
+            std::optional<VkImageView> const& depthBufferImgView,
+            std::vector<VkImageView> const& gbufferViews);
 
     VkResult createImageView(
             VkImage const& swapChainImage,
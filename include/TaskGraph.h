@@ -0,0 +1,62 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include "JobSystem.h"
+
+/**
+ * A fixed set of tasks and the dependencies between them, run as a whole on a
+ * JobSystem. A task is queued as soon as the last of its dependencies finishes,
+ * so independent branches run concurrently. Tasks flagged as caller-thread go
+ * through JobSystem::runOnThread() and are picked up by the thread that called
+ * run() while it waits there.
+ *
+ * The graph is built once and run as many times as needed; tasks read whatever
+ * per-run state they need from their owner.
+ */
+class TaskGraph
+{
+public:
+    using TaskId = uint32_t;
+
+    TaskGraph() = default;
+    DISALLOW_COPY(TaskGraph)
+
+    TaskId addTask(
+            std::string name,
+            std::function<void()> fn,
+            std::vector<TaskId> const& dependencies = {},
+            bool const& callerThread = false);
+
+    /**
+     * Runs every task once and waits for them. If a task throws, its dependents are
+     * skipped and the first exception is rethrown once the running tasks are done.
+     */
+    void run(JobSystem& jobs);
+
+    [[nodiscard]]
+    size_t size() const;
+
+    [[nodiscard]]
+    std::string const& taskName(TaskId const& id) const;
+
+protected:
+    void schedule(JobSystem& jobs, Jobs::Counter& done, TaskId const& id);
+
+private:
+    struct Task
+    {
+        std::string name;
+        std::function<void()> fn;
+        std::vector<TaskId> dependents;
+        uint32_t dependencyCount = 0;
+        bool callerThread = false;
+    };
+
+    std::vector<Task> tasks;
+    // unfinished dependencies of each task in the current run
+    std::unique_ptr<std::atomic<uint32_t>[]> remaining;
+    std::thread::id caller;
+};
@@ -0,0 +1,65 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include "common.h"
+#include <atomic>
+
+/**
+ * Lock-free single-producer, single-consumer channel that always hands the
+ * consumer the latest value. The producer fills back() and publish()es it, which
+ * swaps it with the shared middle slot; acquire() swaps the middle slot with the
+ * consumer's front() if anything was published since. Neither side ever waits:
+ * the producer overwrites values the consumer has not picked up, and the consumer
+ * keeps its current value until a new one comes in.
+ *
+ * front() stays untouched by the producer until the next acquire(), so the
+ * consumer may read it from as many threads as it likes in between.
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    DISALLOW_COPY(TripleBuffer)
+
+    // producer side
+    T& back()
+    {
+        return slots[backIdx];
+    }
+
+    void publish()
+    {
+        uint8_t previous = middle.exchange(backIdx | FRESH_BIT, std::memory_order_acq_rel);
+        backIdx = previous & INDEX_MASK;
+    }
+
+    // consumer side; false if nothing new was published
+    bool acquire()
+    {
+        if ((middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0)
+        {
+            return false;
+        }
+        uint8_t previous = middle.exchange(frontIdx, std::memory_order_acq_rel);
+        frontIdx = previous & INDEX_MASK;
+        return true;
+    }
+
+    T const& front() const
+    {
+        return slots[frontIdx];
+    }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    std::array<T, 3> slots;
+    // each index is only touched by its own side; middle is the handover
+    uint8_t backIdx = 0;
+    alignas(64) std::atomic<uint8_t> middle = 1;
+    alignas(64) uint8_t frontIdx = 2;
+};
@@ -5,6 +5,7 @@
 #pragma once
 #include "common.h"
 #include "Buffers.h"
+#include "FrameTimeline.h"
 
 
 
@@ -14,6 +15,14 @@ struct UniformObjects
     VEC4_ALIGN glm::vec4 cameraPos;
     glm::mat4 proj;
     glm::mat4 view;
+    // lights in the lights buffer; the first globalLightCount are shaded everywhere, the rest through their clusters
+    uint32_t lightCount;
+    uint32_t globalLightCount;
+    // cluster depth slice of a view-space depth d is log(d) * clusterDepthScale + clusterDepthBias
+    float clusterDepthScale;
+    float clusterDepthBias;
+    // inverse of proj * view, for rebuilding positions from depth in the deferred lighting pass
+    glm::mat4 invViewProj;
     static VkDescriptorSetLayoutBinding descriptorSetLayout(uint32_t binding=0);
     static VkWriteDescriptorSet descriptorWrite(
             uint32_t const& binding,
@@ -24,17 +33,15 @@ struct UniformObjects
 struct MeshUniform
 {
     glm::vec4 baseColor;
-    glm::vec4 params; // metallic, roughmess, F0, unused
-    glm::mat4 model;
-    glm::mat4 modelInvDual;
+    glm::vec4 params; // roughness, metallic, F0, specular (0 for a diffuse-only material)
+    glm::mat4 model; // normals are transformed by its cofactor matrix, built in the vertex shader
 
 
     static VkDescriptorSetLayoutBinding descriptorSetLayout(uint32_t binding=0);
 
     MeshUniform() = default;
-    explicit MeshUniform(glm::mat4 const& model) : model(model), modelInvDual(glm::inverseTranspose(model)) {}
+    explicit MeshUniform(glm::mat4 const& model) : model(model) {}
 
-    void computeInvDual();
     void setModelMatrix(glm::mat4 const& newModel);
 
 };
@@ -90,7 +97,8 @@ public:
 };
 
 /*
- * Desgined as a circular queue.
+ * Desgined as a circular queue. Each slot remembers the FrameTimeline value of the
+ * frame that last wrote it, and is only overwritten once that frame completed.
  */
 template<typename TUniformBuffer>
 class DynUniformObjBuffer : public Buffers::Buffer
@@ -114,7 +122,8 @@ public:
                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | additionalFlags,
                VMA_MEMORY_USAGE_CPU_TO_GPU,
                memoryFlags, usedQueues),
-        sizeCount(sizeCount), currentFreeIdx(0), strideSize(DynUniformObjBuffer::stride(physicalDev))
+        sizeCount(sizeCount), currentFreeIdx(0), strideSize(DynUniformObjBuffer::stride(physicalDev)),
+        slotValues(sizeCount, 0)
     {
     }
 
@@ -122,12 +131,19 @@ public:
     DynUniformObjBuffer& operator=(DynUniformObjBuffer const&) = delete;
 
     DynUniformObjBuffer(DynUniformObjBuffer&& dubo) noexcept :
-        Buffers::Buffer(std::move(dubo)), sizeCount(dubo.sizeCount) {}
+        Buffers::Buffer(std::move(dubo)), sizeCount(dubo.sizeCount), currentFreeIdx(dubo.currentFreeIdx),
+        strideSize(dubo.strideSize), slotValues(std::move(dubo.slotValues)),
+        timeline(dubo.timeline), frameValue(dubo.frameValue) {}
 
     DynUniformObjBuffer& operator= (DynUniformObjBuffer&& dubo) noexcept
     {
         Buffers::Buffer::operator=(std::move(dubo));
         sizeCount = dubo.sizeCount;
+        currentFreeIdx = dubo.currentFreeIdx;
+        strideSize = dubo.strideSize;
+        slotValues = std::move(dubo.slotValues);
+        timeline = dubo.timeline;
+        frameValue = dubo.frameValue;
         return *this;
     }
 
@@ -142,33 +158,28 @@ public:
         return strideResult;
     }
 
-    void beginFenceGroup(uint32_t const& frameIdx, VkFence fence)
+    // data placed from here on belongs to the frame signalling value on the timeline
+    void beginFrame(FrameTimeline& frameTimeline, uint64_t const& value)
     {
-        waitingFrame[currentFreeIdx] = frameIdx;
-        latestFrame[frameIdx] = currentFreeIdx;
-        frameFences[frameIdx] = fence;
+        timeline = &frameTimeline;
+        frameValue = value;
     }
 
     uint32_t placeNextData(TUniformBuffer const& data)
     {
-        // if we encounter a frame with marked fence,
-        auto it = waitingFrame.find(currentFreeIdx);
-        if (!ignoreFence && it != waitingFrame.end())
+        // wrapped around onto an older frame's data; usually already done, so no wait.
+        // Waiting on this frame's own value would never return; the ring is sized
+        // to hold several frames of draws, so that only happens if it is too small.
+        uint64_t slotValue = slotValues[currentFreeIdx];
+        if (slotValue != 0 && slotValue != frameValue)
         {
-            VkFence fen = frameFences[it->second];
-            if (fen != VK_NULL_HANDLE && latestFrame[it->second] == currentFreeIdx)
-            {
-                CHECK_VK_SUCCESS(
-                        vkWaitForFences(getLogicalDev(), 1, &frameFences[it->second], VK_TRUE, UINT64_MAX),
-                        "Cannot wait for fence!");
-                waitingFrame.erase(it);
-            }
+            CHECK_VK_SUCCESS(timeline->wait(slotValue), "Cannot wait for timeline semaphore!");
         }
         CHECK_VK_SUCCESS(loadDataIdx(data, currentFreeIdx), "Cannot load data!");
+        slotValues[currentFreeIdx] = frameValue;
 
         auto idx = currentFreeIdx * strideSize;
         currentFreeIdx = (currentFreeIdx + 1) % sizeCount;
-        ignoreFence = false;
         return idx;
     }
 
@@ -208,8 +219,7 @@ private:
     uint32_t sizeCount;
     uint32_t currentFreeIdx = 0;
     uint32_t strideSize;
-    std::map<uint32_t, uint32_t> waitingFrame;
-    VkFence frameFences[MAX_FRAMES_IN_FLIGHT] = {nullptr};
-    int32_t latestFrame[MAX_FRAMES_IN_FLIGHT] = {-1};
-    bool ignoreFence = false;
+    std::vector<uint64_t> slotValues;
+    FrameTimeline* timeline = nullptr;
+    uint64_t frameValue = 0;
 };
\ No newline at end of file
@@ -28,5 +28,46 @@ struct NVertex
     static std::array<VkVertexInputAttributeDescription,3> attributeDescription();
 };
 
+/**
+ * How a mesh buffer lays out its vertices. Interleaved buffers hold one stream of
+ * NVertex. Split buffers hold tightly packed positions, then the rest of every
+ * vertex as VertexAttributes, so passes reading positions only fetch 12 bytes per
+ * vertex instead of 32.
+ */
+enum VertexLayout : uint32_t
+{
+    VERTEX_LAYOUT_INTERLEAVED = 0,
+    VERTEX_LAYOUT_SPLIT_POSITIONS = 1,
+};
+
+// everything of an NVertex but its position, the second stream of a split layout
+struct VertexAttributes
+{
+    glm::vec3 normal;
+    glm::vec2 texCoord;
+};
+
+// where the vertex streams of a buffer start; stream i is bound at binding i
+struct VertexStreams
+{
+    static constexpr uint32_t MAX_STREAMS = 2;
+
+    uint32_t count = 1;
+    std::array<VkDeviceSize, MAX_STREAMS> offsets = {};
+
+    // streams of vertexCount vertices laid out from the start of a buffer
+    static VertexStreams of(VertexLayout const& layout, size_t const& vertexCount);
+};
+
+// vertex input state of pipelines drawing meshes of a layout
+struct VertexInputDescription
+{
+    std::vector<VkVertexInputBindingDescription> bindings;
+    std::vector<VkVertexInputAttributeDescription> attributes;
+
+    // with positionsOnly, only location 0 is fed, and split layouts only bind their position stream
+    static VertexInputDescription of(VertexLayout const& layout, bool const& positionsOnly = false);
+};
+
 
 
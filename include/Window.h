@@ -7,6 +7,35 @@
 #include "WindowBase.h"
 #include "Mesh.h"
 #include "Drawable.h"
+#include "RenderOptions.h"
+#include "BindlessTable.h"
+#include "DrawAddressTable.h"
+#include "DrawTransform.h"
+#include "MaterialTable.h"
+#include "InstanceBuffer.h"
+#include "GeometryBuffer.h"
+#include "CullingPass.h"
+#include "Benchmark.h"
+#include "CommandEncoder.h"
+#include "DrawKey.h"
+#include "SecondaryCommandPools.h"
+#include "JobSystem.h"
+#include "TaskGraph.h"
+#include "TripleBuffer.h"
+#include "SceneSnapshot.h"
+#include "PresentThread.h"
+#include "FrameTimeline.h"
+#include "DeletionQueue.h"
+#include "helpers.h"
+#include "DescriptorAllocator.h"
+#include "DescriptorLayoutCache.h"
+#include "PipelineCache.h"
+#include "PipelineManager.h"
+#include "ShaderPermutation.h"
+#include "LightClusters.h"
+#include "GpuTimer.h"
+#include "GBuffer.h"
+#include "DeferredLightingPass.h"
 
 class Window : public WindowBase
 {
@@ -15,7 +44,8 @@ public:
             size_t const& width,
             size_t const& height,
             std::string windowTitle,
-            float const& fov=60.f, float const& clipnear=0.1f, float const& clipfar=100.f);
+            float const& fov=60.f, float const& clipnear=0.1f, float const& clipfar=100.f,
+            RenderOptions const& renderOptions = {});
 
     ~Window() override;
     int mainLoop();
@@ -24,42 +54,175 @@ protected:
     // Callback functions
     static void onWindowSizeChange(GLFWwindow* ptr, int width, int height);
 
+    // steps the simulation; runs on the main thread and writes only simulation state
     virtual void updateFrame(float const& deltaTime);
     VkResult createCommandPool();
     VkResult createTransferCmdPool();
 
-    void recordCmd(uint32_t imageIdx, VkFence& submissionFence);
+    void recordCmd(uint32_t imageIdx, uint64_t const& frameValue);
+    void cullDrawables();
+    void sortDrawables();
+    void prepareDraws(VkCommandBuffer& cmdBuf, uint64_t const& frameValue);
+    void recordLightClusters(VkCommandBuffer& cmdBuf, uint32_t const& imageIdx);
+    [[nodiscard]]
+    uint32_t recordChunkCount() const;
+    // depthOnly records the depth pre-pass, through depthPipeline
+    void recordDraws(
+            CommandEncoder& encoder, uint32_t imageIdx, uint32_t first, uint32_t last, bool depthOnly = false);
+    BindStats recordParallelDraws(VkCommandBuffer& cmdBuf, uint32_t imageIdx, uint32_t chunkCount);
+    void recordDynamicUniformDraws(CommandEncoder& encoder, uint32_t imageIdx);
+    void encodeDrawTransforms();
+    void recordBindlessDraws(CommandEncoder& encoder, uint32_t first, uint32_t last);
+    void recordBufferAddressDraws(CommandEncoder& encoder, uint32_t first, uint32_t last);
+    void recordPushConstantDraws(CommandEncoder& encoder, uint32_t first, uint32_t last, bool depthOnly);
+    void buildInstanceBatches();
+    void recordInstancedDraws(CommandEncoder& encoder);
+    void recordGpuDrivenDraws(CommandEncoder& encoder);
+    void renderLoop();
+    void renderFrame();
+    void publishSnapshot();
+    void applySnapshot();
+    void syncWindowSize();
+    void buildFrameGraph();
     void drawFrame();
+    void acquireFrame();
+    void uploadFrameUniforms();
+    void recordFrame();
+    void submitFrame();
+    // signals the timeline value of a frame that acquired an image but was never submitted
+    void signalUnsubmittedFrame();
     void resetSwapChain();
 
-    void initBuffers();
+    void initBuffers(helpers::img_r8g8b8a8 const& image);
+    void initBindless();
+    void initBufferAddress();
+    void initPushConstants();
+    void initInstancing();
+    void initGpuDriven();
+    void initParallelRecording();
+    void initPresentThread();
+    void initMaterialTable();
+    void assignMaterials(
+            std::function<uint32_t(MaterialRecord const&)> const& registerMaterial,
+            uint32_t const& textureIdx = BINDLESS_NO_TEXTURE);
+    void addBenchmarkDrawables();
+    [[nodiscard]]
+    uint32_t maxDrawCount() const;
+    void createPipelines();
+    [[nodiscard]]
+    VkImageUsageFlags depthUsage() const;
+    // (re)creates the G-buffer for the current depth buffer; nothing with forward shading
+    void createGBuffer();
+    void savePipelineCache();
+    [[nodiscard]]
+    glm::mat4 viewMatrix() const;
     void setUniforms(UniformObjBuffer<UniformObjects>& bufObject);
-    void setLights(StorageBufferArray<Light>& storageObj);
+    void updateLights();
+    void requestPermutations();
+    void setLights(Buffers::Buffer& lightBuffer);
 
     void initCallbacks();
 private:
-    bool running = true;
+    std::atomic<bool> running = true;
+    RenderOptions options;
+    Benchmark benchmark;
+    JobSystem jobs;
+    TaskGraph frameGraph;
     std::unique_ptr<SwapchainComponents> swapchainComponent;
     VkCommandPool cmdPool = VK_NULL_HANDLE;
     VkCommandPool cmdTransferPool = VK_NULL_HANDLE;
+    // every pipeline is created through it
+    PipelineCache pipelineCache;
+
+    // declared before anything holding descriptor sets or layouts from them
+    DescriptorLayoutCache layoutCache;
+    DescriptorAllocator descriptorAllocator;
+    DescriptorAllocator persistentDescriptors; // never reset; for sets outliving the swapchain
+    FrameDescriptorAllocator frameDescriptors; // reset as each frame slot comes around
 
     std::unique_ptr<SwapchainImageBuffers> uniformData;
     std::unique_ptr<GraphicsPipeline> graphicsPipeline;
+    // position-only, with graphicsPipeline's layout; null without a depth pre-pass
+    std::unique_ptr<GraphicsPipeline> depthPipeline;
+    std::unique_ptr<PipelineManager> pipelineManager;
 
     std::unique_ptr<DynUniformObjBuffer<MeshUniform>> meshUniformGroup;
+    std::unique_ptr<BindlessTable> bindlessTable;
+    std::unique_ptr<DrawAddressTable> drawAddressTable;
+    std::unique_ptr<MaterialTable> materialTable;
+    std::unique_ptr<InstanceBuffer> instanceBuffer;
+    std::unique_ptr<GeometryBuffer> geometryBuffer;
+    std::unique_ptr<CullingPass> cullingPass;
+    // bins the clustered lights on the GPU; null with CPU binning
+    std::unique_ptr<ComputePipeline> clusterPipeline;
+    // shades the G-buffer in the second subpass; null with forward shading
+    std::unique_ptr<DeferredLightingPass> deferredLighting;
+
+    // null unless benchmarking on a queue with timestamps
+    std::unique_ptr<GpuTimer> gpuTimer;
 
     // buffers
+    FrameTimeline frameTimeline;
+    DeletionQueue deletionQueue;
     std::vector<FrameSemaphores> frameSemaphores;
     size_t currentFrame = 0;
+
+    // per-frame state shared between frame graph tasks
+    uint32_t frameImageIdx = 0;
+    uint64_t frameTimelineValue = 0;
+    bool frameAcquired = false;
+    bool frameSubmitted = false;
+    bool frameOutOfDate = false;
     Image::Image img;
     Image::Image depthBuffer;
+    // sized like depthBuffer; only created with deferred shading
+    GBuffer gbuffer;
     float totalTime = 0;
+    // shade every pixel
+    std::vector<Light> frameLights;
+    // ranged point lights after frameLights in the lights buffer, shaded through the light clusters
+    std::vector<Light> clusteredLights;
+    LightBinner lightBinner;
+    // what the lights need from the shaders; draws refine it by material
+    ShaderPermutation lightPermutation;
+
+    // simulation state, only touched by the main thread
+    float simTime = 0;
+    std::vector<glm::mat4> simModels;
+    // hands each simulation step over to the renderer
+    TripleBuffer<SceneSnapshot> snapshots;
+
+    // with a render thread, the main thread only handles events and the simulation
+    std::thread renderThread;
+    std::atomic<bool> stopRendering = false;
+    std::atomic<bool> renderingDone = false;
+    std::exception_ptr renderError;
+    std::unique_ptr<PresentThread> presentThread;
+    // last size from the resize callback, width in the upper half
+    std::atomic<uint64_t> windowExtent = 0;
 
     float fovDegrees;
     float clipNear, clipFar;
     glm::mat4 projectMat;
+    LightClusters::DepthSlicing clusterSlicing;
     glm::vec3 cameraPos;
 
     std::map<std::string, std::unique_ptr<Mesh>> meshStorage;
     std::vector<Drawable> drawables;
+    FrustumCuller frustumCuller;
+    DrawSorter drawSorter;
+    CommandEncoder primaryEncoder;
+    std::unique_ptr<SecondaryCommandPools> secondaryPools;
+    std::vector<CommandEncoder> workerEncoders; // one per secondary pool worker
+
+    // scratch space reused every frame, indexed like visibleDrawables
+    std::vector<uint32_t> visibleDrawables;
+    std::vector<DrawSortEntry> frameSortEntries;
+    std::vector<Mesh const*> frameSortMeshes;
+    std::vector<glm::mat4> frameModels;
+    std::vector<InstanceTransform> frameTransforms;
+    std::vector<uint32_t> frameBatchIndices;
+    std::vector<InstanceBatch> frameBatches;
+    std::vector<DrawRecord> frameInstances;
+    std::vector<uint32_t> frameUniformOffsets;
 };
\ No newline at end of file
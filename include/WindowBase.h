@@ -10,6 +10,8 @@
 #include "VertexBuffers.h"
 #include "SwapchainImgBuffers.h"
 #include "Image.h"
+#include "BindlessTable.h"
+#include "CullingPass.h"
 
 std::vector<char const*> getRequiredExts();
 bool deviceSuitable(VkPhysicalDevice const& dev);
@@ -36,6 +38,7 @@ protected:
     VkResult setupDebugMessenger();
 #endif
     VkResult createLogicalDevice();
+    void queryFeatures12();
     VkResult createAllocator();
     VkResult createSurface();
 
@@ -81,11 +84,27 @@ protected:
 #endif
     VkPhysicalDevice selectPhysicalDev();
 
+    [[nodiscard]]
+    bool pipelineLibrarySupported() const;
+
+    [[nodiscard]]
+    bool pipelineLibraryEnabled() const;
+
+    [[nodiscard]]
+    bool bindlessEnabled() const;
+
+    [[nodiscard]]
+    bool bufferDeviceAddressEnabled() const;
+
+    [[nodiscard]]
+    bool indirectCountEnabled() const;
+
 protected:
     QueueFamilies queueFamilyIndex;
     VkQueue graphicsQueue = {};
     VkQueue presentQueue = {};
     VkQueue transferQueue = {};
+    VkQueue computeQueue = {}; // may be the graphics queue
 
     size_t width, height;
     std::string title;
@@ -96,4 +115,11 @@ protected:
     VkDevice logicalDev = {};
     VmaAllocator allocator = VK_NULL_HANDLE;
     VkSurfaceKHR surface = VK_NULL_HANDLE;
+
+    VkPhysicalDeviceFeatures supportedFeatures = {};
+    VkPhysicalDeviceFeatures enabledFeatures = {};
+    VkPhysicalDeviceVulkan12Features supportedFeatures12 = {};
+    VkPhysicalDeviceVulkan12Features enabledFeatures12 = {};
+    // VK_EXT_graphics_pipeline_library
+    bool pipelineLibrary = false;
 };
@@ -0,0 +1,59 @@
+#include "ubo.hlsli"
+#include "brdf.hlsli"
+
+// PixelShaderInput plus the material, forwarded by bda.vert from the draw record
+struct MaterialPixelShaderInput
+{
+    float4 scrPos : SV_POSITION;
+
+    [[vk::location(1)]]
+    float3 worldPos;
+
+    [[vk::location(2)]]
+    float3 inNormal;
+
+    [[vk::location(3)]]
+    float2 outTexCoord;
+
+    [[vk::location(4)]]
+    nointerpolation float4 baseColor;
+
+    [[vk::location(5)]]
+    nointerpolation float4 materialParams;
+};
+
+SurfaceMaterial draw_material(MaterialPixelShaderInput psi)
+{
+    SurfaceMaterial mat;
+    mat.baseColor = psi.baseColor.rgb;
+    mat.roughness = psi.materialParams.x;
+    mat.metallic = psi.materialParams.y;
+    mat.f0 = psi.materialParams.z;
+    mat.specular = psi.materialParams.w;
+    return mat;
+}
+
+#if defined(VARIANT_GBUFFER)
+#include "gbuffer.hlsli"
+
+GBufferOutput main(MaterialPixelShaderInput psi)
+{
+    return write_gbuffer(draw_material(psi), psi.inNormal);
+}
+#else
+struct PixelShaderOutput
+{
+    [[vk::location(0)]]
+    float4 fragColor : SV_TARGET;
+};
+
+PixelShaderOutput main(MaterialPixelShaderInput psi)
+{
+    PixelShaderOutput pso;
+    float3 normal = normalize(psi.inNormal);
+    float3 viewVec = normalize(cameraPos.xyz - psi.worldPos);
+
+    pso.fragColor = float4(shade_all_lights(draw_material(psi), viewVec, normal, psi.worldPos), 1);
+    return pso;
+}
+#endif
@@ -0,0 +1,69 @@
+#version 460
+#extension GL_EXT_buffer_reference : require
+
+// Written in GLSL since glslang's HLSL front end has no buffer pointers.
+// Layouts mirror ubo.hlsli, vertexinput.hlsli and pixelshader.hlsli.
+
+layout(set = 0, binding = 0) uniform UBO
+{
+    float time;
+    vec4 cameraPos;
+    mat4 proj;
+    mat4 view;
+};
+
+// matches MeshUniform on the host
+layout(buffer_reference, std430, buffer_reference_align = 16) readonly buffer MeshRecord
+{
+    vec4 baseColor;
+    vec4 params;
+    mat4 model;
+};
+
+// inverse-transpose of the upper 3x3 up to scale: its cofactor matrix, see transforms.hlsli
+vec3 affineNormal(mat4 m, vec3 normal)
+{
+    vec3 c0 = m[0].xyz;
+    vec3 c1 = m[1].xyz;
+    vec3 c2 = m[2].xyz;
+    vec3 x = cross(c1, c2);
+    vec3 cofactorNormal = normal.x * x + normal.y * cross(c2, c0) + normal.z * cross(c0, c1);
+    return normalize(dot(c0, x) < 0 ? -cofactorNormal : cofactorNormal);
+}
+
+layout(push_constant) uniform DrawAddress
+{
+    MeshRecord record;
+};
+
+layout(location = 0) in vec3 inPosition;
+#if !defined(VARIANT_DEPTH)
+// the depth pre-pass fetches positions only
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 texCoord;
+#endif
+
+// the depth pre-pass variant must compute exactly the depth of the lit pass
+invariant gl_Position;
+
+layout(location = 1) out vec3 outWorldPos;
+layout(location = 2) out vec3 outNormal;
+layout(location = 3) out vec2 outTexCoord;
+layout(location = 4) flat out vec4 outBaseColor;
+layout(location = 5) flat out vec4 outMaterialParams;
+
+void main()
+{
+    vec4 inPos4 = vec4(inPosition, 1);
+    vec4 worldPos = record.model * inPos4;
+
+    gl_Position = proj * view * worldPos;
+#if !defined(VARIANT_DEPTH)
+    outWorldPos = worldPos.xyz;
+    outNormal = affineNormal(record.model, inNormal);
+    outTexCoord = texCoord;
+
+    outBaseColor = record.baseColor;
+    outMaterialParams = record.params;
+#endif
+}
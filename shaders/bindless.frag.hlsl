@@ -0,0 +1,48 @@
+#include "pixelshader.hlsli"
+#include "ubo.hlsli"
+#include "bindless.hlsli"
+#include "brdf.hlsli"
+
+SurfaceMaterial draw_material(PixelShaderInput psi)
+{
+    MaterialRecord material = materials[draws[drawIdx].materialIdx];
+
+    SurfaceMaterial mat;
+    mat.baseColor = material.baseColor.rgb;
+    mat.roughness = material.roughness;
+    mat.metallic = material.metallic;
+    mat.f0 = material.f0;
+    mat.specular = material.specular;
+
+    if (material.textureIdx != BINDLESS_NO_TEXTURE)
+    {
+        mat.baseColor *= bindlessTextures[NonUniformResourceIndex(material.textureIdx)]
+            .Sample(bindlessSampler, psi.outTexCoord).rgb;
+    }
+    return mat;
+}
+
+#if defined(VARIANT_GBUFFER)
+#include "gbuffer.hlsli"
+
+GBufferOutput main(PixelShaderInput psi)
+{
+    return write_gbuffer(draw_material(psi), psi.inNormal);
+}
+#else
+struct PixelShaderOutput
+{
+    [[vk::location(0)]]
+    float4 fragColor : SV_TARGET;
+};
+
+PixelShaderOutput main(PixelShaderInput psi)
+{
+    PixelShaderOutput pso;
+    float3 normal = normalize(psi.inNormal);
+    float3 viewVec = normalize(cameraPos.xyz - psi.worldPos);
+
+    pso.fragColor = float4(shade_all_lights(draw_material(psi), viewVec, normal, psi.worldPos), 1);
+    return pso;
+}
+#endif
@@ -0,0 +1,23 @@
+#include "vertexinput.hlsli"
+#include "pixelshader.hlsli"
+#include "ubo.hlsli"
+#include "bindless.hlsli"
+#include "transforms.hlsli"
+
+
+PixelShaderInput main(VertexInput vi)
+{
+    PixelShaderInput psi;
+    DrawRecord draw = draws[drawIdx];
+    precise float3 worldPos = affine_transform_point(
+            draw.modelRows[0], draw.modelRows[1], draw.modelRows[2], vi.inPosition);
+
+    psi.scrPos = mul(proj, mul(view, float4(worldPos, 1)));
+#if !defined(VARIANT_DEPTH)
+    psi.inNormal = affine_normal_from_rows(
+            draw.modelRows[0].xyz, draw.modelRows[1].xyz, draw.modelRows[2].xyz, vi.inNormal);
+    psi.outTexCoord = vi.texCoord;
+#endif
+    psi.worldPos = worldPos;
+    return psi;
+}
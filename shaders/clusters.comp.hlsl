@@ -0,0 +1,63 @@
+#include "ubo.hlsli"
+#include "lights.hlsli"
+#define CLUSTER_LIGHTS_WRITABLE
+#include "clusters.hlsli"
+
+// matches LightClusters::WORKGROUP_SIZE on the host
+#define CLUSTER_THREADS 64
+
+// a batch of lights in view space (xyz) with their range (w), shared by the workgroup
+groupshared float4 batchLights[CLUSTER_THREADS];
+
+// one thread per cluster; every thread of the group reaches the barriers
+[numthreads(CLUSTER_THREADS, 1, 1)]
+void main(uint3 threadId : SV_DispatchThreadID, uint3 localId : SV_GroupThreadID)
+{
+    uint cluster = threadId.x;
+    bool active = cluster < CLUSTER_COUNT;
+
+    // view-space bounds of the cluster: its tile's corners at the near and far depth of its slice
+    uint3 cell = uint3(cluster % CLUSTER_X, (cluster / CLUSTER_X) % CLUSTER_Y, cluster / (CLUSTER_X * CLUSTER_Y));
+    float2 unitScale = float2(proj[0][0], proj[1][1]);
+    float2 tileMin = (float2(cell.xy) / float2(CLUSTER_X, CLUSTER_Y) * 2 - 1) / unitScale;
+    float2 tileMax = (float2(cell.xy + 1) / float2(CLUSTER_X, CLUSTER_Y) * 2 - 1) / unitScale;
+    float depthNear = cluster_slice_depth(cell.z);
+    float depthFar = cluster_slice_depth(cell.z + 1);
+
+    float2 lo = min(min(tileMin * depthNear, tileMax * depthNear), min(tileMin * depthFar, tileMax * depthFar));
+    float2 hi = max(max(tileMin * depthNear, tileMax * depthNear), max(tileMin * depthFar, tileMax * depthFar));
+    // view space is left-handed, so depth is +z
+    float3 boundsMin = float3(lo, depthNear);
+    float3 boundsMax = float3(hi, depthFar);
+
+    uint count = 0;
+    for (uint batch = globalLightCount; batch < lightCount; batch += CLUSTER_THREADS)
+    {
+        uint lightIdx = batch + localId.x;
+        if (lightIdx < lightCount)
+        {
+            Light lig = lightsObj[lightIdx];
+            batchLights[localId.x] = float4(mul(view, float4(lig.position.xyz, 1)).xyz, lig.parameters.x);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        uint batchSize = min(CLUSTER_THREADS, lightCount - batch);
+        for (uint j = 0; active && j < batchSize; ++j)
+        {
+            // squared distance from the light to the cluster's bounds
+            float4 sphere = batchLights[j];
+            float3 outside = max(0, max(boundsMin - sphere.xyz, sphere.xyz - boundsMax));
+            if (dot(outside, outside) <= sphere.w * sphere.w && count < MAX_LIGHTS_PER_CLUSTER)
+            {
+                clusterLights[cluster_light_slot(cluster, count)] = batch + j;
+                ++count;
+            }
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (active)
+    {
+        clusterLights[cluster] = count;
+    }
+}
@@ -0,0 +1,76 @@
+#include "drawrecord.hlsli"
+#include "culling.hlsli"
+#include "transforms.hlsli"
+
+#define MAX_INSTANCES 65536
+
+// matches CullingPass on the host
+[[vk::binding(0,0)]]
+tbuffer instanceRecords
+{
+    uint instanceCount;
+    DrawRecord instances[MAX_INSTANCES];
+};
+
+[[vk::binding(1,0)]]
+tbuffer meshRecords
+{
+    uint meshCount;
+    MeshRange meshes[MAX_MESHES];
+};
+
+[[vk::binding(2,0)]]
+RWStructuredBuffer<DrawIndexedIndirectCommand> drawCommands;
+
+[[vk::binding(3,0)]]
+RWStructuredBuffer<uint> drawCount;
+
+// matches CullPushConstant on the host
+[[vk::push_constant]]
+cbuffer Frustum
+{
+    float4 frustumPlanes[6];
+};
+
+[numthreads(64, 1, 1)]
+void main(uint3 threadId : SV_DispatchThreadID)
+{
+    uint instanceIdx = threadId.x;
+    if (instanceIdx >= instanceCount)
+    {
+        return;
+    }
+
+    DrawRecord instance = instances[instanceIdx];
+    MeshRange mesh = meshes[instance.meshIdx];
+
+    float4 r0 = instance.modelRows[0];
+    float4 r1 = instance.modelRows[1];
+    float4 r2 = instance.modelRows[2];
+    float3 center = affine_transform_point(r0, r1, r2, mesh.boundingSphere.xyz);
+
+    // the largest column of the upper 3x3 bounds how much the sphere can grow
+    float3 c0 = float3(r0.x, r1.x, r2.x);
+    float3 c1 = float3(r0.y, r1.y, r2.y);
+    float3 c2 = float3(r0.z, r1.z, r2.z);
+    float radius = mesh.boundingSphere.w * sqrt(max(dot(c0, c0), max(dot(c1, c1), dot(c2, c2))));
+
+    for (uint i = 0; i < 6; ++i)
+    {
+        if (dot(frustumPlanes[i].xyz, center) + frustumPlanes[i].w < -radius)
+        {
+            return;
+        }
+    }
+
+    uint drawIdx;
+    InterlockedAdd(drawCount[0], 1, drawIdx);
+
+    DrawIndexedIndirectCommand command;
+    command.indexCount = mesh.indexCount;
+    command.instanceCount = 1;
+    command.firstIndex = mesh.firstIndex;
+    command.vertexOffset = mesh.vertexOffset;
+    command.firstInstance = instanceIdx;
+    drawCommands[drawIdx] = command;
+}
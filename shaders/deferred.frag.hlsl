@@ -0,0 +1,50 @@
+#include "ubo.hlsli"
+#include "brdf.hlsli"
+#include "deferred.hlsli"
+
+// written by the geometry subpass; see gbuffer.hlsli
+[[vk::input_attachment_index(0)]] [[vk::binding(0,1)]]
+SubpassInput<float4> gbufferAlbedo;
+
+[[vk::input_attachment_index(1)]] [[vk::binding(1,1)]]
+SubpassInput<float4> gbufferNormal;
+
+[[vk::input_attachment_index(2)]] [[vk::binding(2,1)]]
+SubpassInput<float4> gbufferMaterial;
+
+[[vk::input_attachment_index(3)]] [[vk::binding(3,1)]]
+SubpassInput<float> gbufferDepth;
+
+struct PixelShaderOutput
+{
+    [[vk::location(0)]]
+    float4 fragColor : SV_TARGET;
+};
+
+PixelShaderOutput main(LightingPixelShaderInput psi)
+{
+    // nothing was drawn here; keep the clear color
+    float depth = gbufferDepth.SubpassLoad();
+    if (depth >= 1)
+    {
+        discard;
+    }
+
+    float4 worldPos = mul(invViewProj, float4(psi.ndc, depth, 1));
+    worldPos /= worldPos.w;
+
+    float4 params = gbufferMaterial.SubpassLoad();
+    SurfaceMaterial mat;
+    mat.baseColor = gbufferAlbedo.SubpassLoad().rgb;
+    mat.roughness = params.x;
+    mat.metallic = params.y;
+    mat.f0 = params.z;
+    mat.specular = params.w;
+
+    float3 normal = normalize(gbufferNormal.SubpassLoad().xyz * 2 - 1);
+    float3 viewVec = normalize(cameraPos.xyz - worldPos.xyz);
+
+    PixelShaderOutput pso;
+    pso.fragColor = float4(shade_all_lights(mat, viewVec, normal, worldPos.xyz), 1);
+    return pso;
+}
@@ -0,0 +1,11 @@
+#include "deferred.hlsli"
+
+// one triangle covering the screen, with no vertex buffer
+LightingPixelShaderInput main(uint vertexIdx : SV_VertexID)
+{
+    LightingPixelShaderInput psi;
+    float2 uv = float2((vertexIdx << 1) & 2, vertexIdx & 2);
+    psi.ndc = uv * 2 - 1;
+    psi.scrPos = float4(psi.ndc, 0, 1);
+    return psi;
+}
@@ -0,0 +1,48 @@
+#include "pixelshader.hlsli"
+#include "ubo.hlsli"
+#include "meshubo.hlsli"
+#include "brdf.hlsli"
+
+[[vk::binding(1)]]
+Texture2D<float4> tex;
+
+[[vk::binding(1)]]
+SamplerState sLinear;
+
+SurfaceMaterial draw_material()
+{
+    SurfaceMaterial mat;
+    mat.baseColor = baseColor.rgb;
+    mat.roughness = roughness;
+    mat.metallic = metallic;
+    mat.f0 = f0;
+    mat.specular = specular;
+    return mat;
+}
+
+#if defined(VARIANT_GBUFFER)
+#include "gbuffer.hlsli"
+
+GBufferOutput main(PixelShaderInput psi)
+{
+    return write_gbuffer(draw_material(), psi.inNormal);
+}
+#else
+struct PixelShaderOutput
+{
+    [[vk::location(0)]]
+    float4 fragColor : SV_TARGET;
+};
+
+PixelShaderOutput main(PixelShaderInput psi)
+{
+    PixelShaderOutput pso;
+    float3 normal = normalize(psi.inNormal);
+    float3 viewVec = normalize(cameraPos.xyz - psi.worldPos);
+
+    float3 outColor = shade_all_lights(draw_material(), viewVec, normal, psi.worldPos);
+
+    pso.fragColor = float4(outColor, 1); // float4(multValue * psi.inColor,1);
+    return pso;
+}
+#endif
@@ -0,0 +1,26 @@
+#include "vertexinput.hlsli"
+#include "pixelshader.hlsli"
+#include "ubo.hlsli"
+#include "meshubo.hlsli"
+#include "transforms.hlsli"
+
+
+PixelShaderInput main(VertexInput vi)
+{
+    PixelShaderInput psi;
+    float4 inPos4 = float4(vi.inPosition,1);
+
+    float4x4 MVP = mul(proj, mul(view, meshModel));
+    psi.scrPos = mul(MVP, inPos4);
+
+#if !defined(VARIANT_DEPTH)
+    psi.inNormal = affine_normal_from_columns(
+            mul(meshModel, float4(1,0,0,0)).xyz,
+            mul(meshModel, float4(0,1,0,0)).xyz,
+            mul(meshModel, float4(0,0,1,0)).xyz,
+            vi.inNormal);
+    psi.outTexCoord = vi.texCoord;
+#endif
+    psi.worldPos = mul(meshModel, inPos4).xyz;
+    return psi;
+}
\ No newline at end of file
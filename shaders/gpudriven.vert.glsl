@@ -0,0 +1,70 @@
+#version 460
+
+// Written in GLSL since gl_InstanceIndex includes the firstInstance written by
+// cull.comp, which glslang's SV_InstanceID does not guarantee.
+// Layouts mirror ubo.hlsli, drawrecord.hlsli and instancing.hlsli.
+
+layout(set = 0, binding = 0) uniform UBO
+{
+    float time;
+    vec4 cameraPos;
+    mat4 proj;
+    mat4 view;
+};
+
+struct DrawRecord
+{
+    vec4 modelRows[3];
+    uint materialIdx;
+    uint meshIdx;
+    uvec2 _unused;
+};
+
+// matches InstanceBuffer on the host
+layout(std430, set = 2, binding = 0) readonly buffer InstanceRecords
+{
+    uint instanceCount;
+    DrawRecord instances[];
+};
+
+// see transforms.hlsli
+vec3 affineNormalFromRows(vec3 r0, vec3 r1, vec3 r2, vec3 normal)
+{
+    vec3 c0 = cross(r1, r2);
+    vec3 cofactorNormal = vec3(dot(c0, normal), dot(cross(r2, r0), normal), dot(cross(r0, r1), normal));
+    return normalize(dot(r0, c0) < 0 ? -cofactorNormal : cofactorNormal);
+}
+
+layout(location = 0) in vec3 inPosition;
+#if !defined(VARIANT_DEPTH)
+// the depth pre-pass fetches positions only
+layout(location = 1) in vec3 inNormal;
+layout(location = 2) in vec2 texCoord;
+#endif
+
+// the depth pre-pass variant must compute exactly the depth of the lit pass
+invariant gl_Position;
+
+layout(location = 1) out vec3 outWorldPos;
+layout(location = 2) out vec3 outNormal;
+layout(location = 3) out vec2 outTexCoord;
+layout(location = 4) flat out uint outMaterialIdx;
+
+void main()
+{
+    DrawRecord instance = instances[gl_InstanceIndex];
+    vec4 inPos4 = vec4(inPosition, 1);
+    vec3 worldPos = vec3(
+            dot(instance.modelRows[0], inPos4),
+            dot(instance.modelRows[1], inPos4),
+            dot(instance.modelRows[2], inPos4));
+
+    gl_Position = proj * view * vec4(worldPos, 1);
+#if !defined(VARIANT_DEPTH)
+    outWorldPos = worldPos;
+    outNormal = affineNormalFromRows(
+            instance.modelRows[0].xyz, instance.modelRows[1].xyz, instance.modelRows[2].xyz, inNormal);
+    outTexCoord = texCoord;
+    outMaterialIdx = instance.materialIdx;
+#endif
+}
@@ -0,0 +1,32 @@
+#include "materials.hlsli"
+#include "drawrecord.hlsli"
+
+#define BINDLESS_NO_TEXTURE 0xFFFFFFFF
+#define BINDLESS_MAX_DRAWS 4096
+#define BINDLESS_MAX_MATERIALS 1024
+
+[[vk::binding(0,1)]]
+tbuffer drawRecords
+{
+    uint drawCount;
+    DrawRecord draws[BINDLESS_MAX_DRAWS];
+};
+
+[[vk::binding(1,1)]]
+tbuffer materialRecords
+{
+    uint materialCount;
+    MaterialRecord materials[BINDLESS_MAX_MATERIALS];
+};
+
+[[vk::binding(2,1)]]
+SamplerState bindlessSampler;
+
+[[vk::binding(3,1)]]
+Texture2D<float4> bindlessTextures[];
+
+[[vk::push_constant]]
+cbuffer DrawConstants
+{
+    uint drawIdx;
+};
@@ -0,0 +1,130 @@
+// requires ubo.hlsli for the light counts and the camera
+#include "lights.hlsli"
+#include "clusters.hlsli"
+#include "permutation.hlsli"
+
+struct SurfaceMaterial
+{
+    float3 baseColor;
+    float roughness;
+    float metallic;
+    float f0;
+    // 1 for a specular lobe, 0 for a purely diffuse material
+    float specular;
+};
+
+float Fresnel(float ndoth, float f0)
+{
+    // schlick's approximation
+    return f0 + (1-f0) * pow(1-ndoth, 5);
+}
+
+float DBeckmann(float ndoth, float r2)
+{
+    float ndoth2 = ndoth * ndoth;
+    float r4 = r2 * r2;
+    float num = exp((ndoth2 - 1) / (r4 * ndoth2));
+    float denom = r4 * ndoth2 * ndoth2;
+    return num * rcp(denom);
+}
+
+float GValdenom(float ndotV, float r2)
+{
+    float k = (r2 + 1) * (r2 + 1)/8;
+    return ndotV * (1-k) + k;
+}
+
+float GVal(float ndotv, float ndotl, float r2)
+{
+    return rcp(GValdenom(ndotv,r2)*GValdenom(ndotl,r2));
+}
+
+float3 BRDF(SurfaceMaterial mat, float3 viewDir, float3 lightDir, float3 normal)
+{
+    // materials with specular = 0 skip the lobe here too, so the diffuse variant
+    // shades them exactly as the generic one does
+#if MATERIAL_SPECULAR
+    if (mat.specular != 0)
+    {
+        float roughness2 = mat.roughness * mat.roughness;
+        float3 halfvec = normalize(viewDir + lightDir);
+
+        float ndotl = saturate(dot(normal, lightDir));
+        float ndotv = saturate(dot(normal, viewDir));
+        float ndoth = saturate(dot(normal, halfvec));
+
+        float specularVal =
+            DBeckmann(ndoth, roughness2) * Fresnel(ndoth, mat.f0) * GVal(ndotv, ndotl, roughness2) * 0.25;
+        return mat.baseColor + specularVal;
+    }
+#endif
+    return mat.baseColor;
+}
+
+float3 compute_light_point(SurfaceMaterial mat, float3 viewVec, float3 normal, float3 worldPosition, Light lig)
+{
+    float3 lightDistance = lig.position.xyz - worldPosition;
+    float distance2 = dot(lightDistance, lightDistance);
+    float attenuation = rcp(distance2);
+
+    // ranged lights fade to nothing at their range, so clusters beyond it can leave them out
+    float range = lig.parameters.x;
+    if (range > 0)
+    {
+        float ratio2 = distance2 / (range * range);
+        float falloff = saturate(1 - ratio2 * ratio2);
+        attenuation *= falloff * falloff;
+    }
+
+    float3 lightColor = lig.intensity * lig.color.rgb * attenuation;
+
+    float lightDirDot = saturate(dot(normalize(lightDistance), normal));
+    return BRDF(mat, viewVec, normalize(lightDistance), normal) * lightColor * lightDirDot;
+}
+
+float3 compute_light_dir(SurfaceMaterial mat, float3 viewVec, float3 normal, Light lig)
+{
+    float3 lightDistance = normalize(lig.position.xyz);
+    float3 lightColor = lig.intensity * lig.color.rgb;
+    float lightDirDot = saturate(dot(lightDistance, normal));
+    return BRDF(mat, viewVec, lightDistance, normal) * lightColor * lightDirDot;
+}
+
+float3 shade_all_lights(SurfaceMaterial mat, float3 viewVec, float3 normal, float3 worldPos)
+{
+    float3 outColor = float3(0,0,0);
+    for (uint i=0; i < min(globalLightCount, MAX_LIGHT_COUNT); ++i)
+    {
+        // with a single light type the branch folds away when the pipeline is specialized
+        if (LIGHT_TYPES == LIGHT_TYPE_POINT_BIT)
+        {
+            outColor += compute_light_point(mat, viewVec, normal, worldPos, lightsObj[i]);
+        }
+        else if (LIGHT_TYPES == LIGHT_TYPE_DIRECTIONAL_BIT)
+        {
+            outColor += compute_light_dir(mat, viewVec, normal, lightsObj[i]);
+        }
+        else
+        {
+            [branch] switch(lightsObj[i].lightType)
+            {
+                case POINT_LIGHT:
+                    outColor += compute_light_point(mat, viewVec, normal, worldPos, lightsObj[i]);
+                break;
+
+                case DIRECTIONAL_LIGHT:
+                    outColor += compute_light_dir(mat, viewVec, normal, lightsObj[i]);
+                break;
+            }
+        }
+    }
+
+    // ranged point lights, only those binned into this pixel's cluster
+    uint cluster = cluster_index(worldPos);
+    uint clusterLightCount = clusterLights[cluster];
+    for (uint j=0; j < clusterLightCount; ++j)
+    {
+        outColor += compute_light_point(mat, viewVec, normal, worldPos, lightsObj[clusterLights[cluster_light_slot(cluster, j)]]);
+    }
+    return outColor;
+}
@@ -0,0 +1,39 @@
+// froxel grid of clustered lighting; matches LightClusters.h on the host.
+// requires ubo.hlsli for the camera and depth slicing
+#define CLUSTER_X 16
+#define CLUSTER_Y 9
+#define CLUSTER_Z 24
+#define CLUSTER_COUNT (CLUSTER_X * CLUSTER_Y * CLUSTER_Z)
+#define MAX_LIGHTS_PER_CLUSTER 256
+
+// the light count of every cluster, then MAX_LIGHTS_PER_CLUSTER light indices per cluster
+#if defined(CLUSTER_LIGHTS_WRITABLE)
+[[vk::binding(3,0)]]
+RWStructuredBuffer<uint> clusterLights;
+#else
+[[vk::binding(3,0)]]
+StructuredBuffer<uint> clusterLights;
+#endif
+
+uint cluster_light_slot(uint cluster, uint i)
+{
+    return CLUSTER_COUNT + cluster * MAX_LIGHTS_PER_CLUSTER + i;
+}
+
+// view depth where a slice starts; slices are spaced exponentially between the clip planes
+float cluster_slice_depth(uint slice)
+{
+    return exp((slice - clusterDepthBias) / clusterDepthScale);
+}
+
+uint cluster_index(float3 worldPos)
+{
+    float4 viewPos = mul(view, float4(worldPos, 1));
+    float4 clipPos = mul(proj, viewPos);
+    float2 tile = saturate(clipPos.xy / clipPos.w * 0.5 + 0.5) * float2(CLUSTER_X, CLUSTER_Y);
+    // view space is left-handed (GLM_FORCE_LEFT_HANDED): the camera looks down +z
+    float slice = log(max(viewPos.z, 1e-6)) * clusterDepthScale + clusterDepthBias;
+
+    uint3 cell = min(uint3(max(float3(tile, slice), 0)), uint3(CLUSTER_X - 1, CLUSTER_Y - 1, CLUSTER_Z - 1));
+    return (cell.z * CLUSTER_Y + cell.y) * CLUSTER_X + cell.x;
+}
@@ -0,0 +1,21 @@
+#define MAX_MESHES 256
+
+// matches MeshRange on the host
+struct MeshRange
+{
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint _unused;
+    float4 boundingSphere; // model space
+};
+
+// matches VkDrawIndexedIndirectCommand
+struct DrawIndexedIndirectCommand
+{
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
@@ -0,0 +1,9 @@
+// shared by the full-screen lighting pass of the deferred renderer
+struct LightingPixelShaderInput
+{
+    float4 scrPos : SV_POSITION;
+
+    // normalized device coordinates of the pixel
+    [[vk::location(0)]]
+    float2 ndc;
+};
@@ -0,0 +1,8 @@
+// matches DrawRecord on the host
+struct DrawRecord
+{
+    float4 modelRows[3]; // InstanceTransform
+    uint materialIdx;
+    uint meshIdx;
+    uint2 _unused;
+};
@@ -0,0 +1,9 @@
+#include "transforms.hlsli"
+
+// matches DrawTransformPushConstant on the host
+[[vk::push_constant]]
+cbuffer DrawTransform
+{
+    float4 modelRows[3]; // InstanceTransform: top three rows of the affine model matrix
+    uint materialIdx;
+};
@@ -0,0 +1,25 @@
+// G-buffer of the deferred renderer; attachment order and formats match GBuffer.h on the host.
+// requires brdf.hlsli for SurfaceMaterial
+struct GBufferOutput
+{
+    // base color in rgb
+    [[vk::location(0)]]
+    float4 albedo : SV_TARGET0;
+
+    // world-space normal mapped to [0, 1]
+    [[vk::location(1)]]
+    float4 normal : SV_TARGET1;
+
+    // roughness, metallic, F0 and the specular flag
+    [[vk::location(2)]]
+    float4 material : SV_TARGET2;
+};
+
+GBufferOutput write_gbuffer(SurfaceMaterial mat, float3 normal)
+{
+    GBufferOutput gbo;
+    gbo.albedo = float4(mat.baseColor, 1);
+    gbo.normal = float4(normalize(normal) * 0.5 + 0.5, 0);
+    gbo.material = float4(mat.roughness, mat.metallic, mat.f0, mat.specular);
+    return gbo;
+}
@@ -0,0 +1,19 @@
+// vertex to pixel interface of the instanced path; the material index is
+// taken from the instance record and passed down flat.
+struct InstancedPixelShaderInput
+{
+    // precise, so the depth pre-pass variant computes the same depth as the lit pass
+    precise float4 scrPos : SV_POSITION;
+
+    [[vk::location(1)]]
+    float3 worldPos;
+
+    [[vk::location(2)]]
+    float3 inNormal;
+
+    [[vk::location(3)]]
+    float2 outTexCoord;
+
+    [[vk::location(4)]]
+    nointerpolation uint materialIdx;
+};
@@ -9,12 +9,9 @@ struct Light
 
     float4 color;
     float4 position;
-    float4 parameters;
+    float4 parameters; // x: range of a point light, 0 for unbounded
 };
 
+// global lights first, then the ranged point lights binned into clusters; the counts are in ubo.hlsli
 [[vk::binding(2,0)]]
-tbuffer lights
-{
-    uint lightCount;
-    Light lightsObj[64];
-};
\ No newline at end of file
+StructuredBuffer<Light> lightsObj;
@@ -0,0 +1,10 @@
+struct MaterialRecord
+{
+    float4 baseColor;
+    float roughness;
+    float metallic;
+    float f0;
+    float specular;
+    uint textureIdx;
+    uint3 _unused;
+};
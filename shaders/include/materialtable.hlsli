@@ -0,0 +1,32 @@
+#include "materials.hlsli"
+#include "brdf.hlsli"
+
+#define MAX_MATERIALS 1024
+
+// matches MaterialTable on the host
+[[vk::binding(0,1)]]
+tbuffer materialRecords
+{
+    uint materialCount;
+    MaterialRecord materials[MAX_MATERIALS];
+};
+
+SurfaceMaterial table_material(uint materialIdx)
+{
+    MaterialRecord material = materials[materialIdx];
+
+    SurfaceMaterial mat;
+    mat.baseColor = material.baseColor.rgb;
+    mat.roughness = material.roughness;
+    mat.metallic = material.metallic;
+    mat.f0 = material.f0;
+    mat.specular = material.specular;
+    return mat;
+}
+
+// requires ubo.hlsli for the camera position
+float3 shade_table_material(uint materialIdx, float3 worldPos, float3 normal)
+{
+    float3 viewVec = normalize(cameraPos.xyz - worldPos);
+    return shade_all_lights(table_material(materialIdx), viewVec, normalize(normal), worldPos);
+}
@@ -0,0 +1,10 @@
+[[vk::binding(0,1)]]
+cbuffer MeshUBO
+{
+    float4 baseColor;
+    float roughness;
+    float metallic;
+    float f0;
+    float specular;
+    float4x4 meshModel;
+};
\ No newline at end of file
@@ -0,0 +1,16 @@
+// selects the permutation of the lit shaders; ids and bits match ShaderPermutation.h.
+// The defaults make the generic permutation, which handles any scene and material.
+
+#define LIGHT_TYPE_POINT_BIT (1 << POINT_LIGHT)
+#define LIGHT_TYPE_DIRECTIONAL_BIT (1 << DIRECTIONAL_LIGHT)
+
+// light types present in the scene, and an upper bound on its light count
+[[vk::constant_id(0)]] const uint LIGHT_TYPES = LIGHT_TYPE_POINT_BIT | LIGHT_TYPE_DIRECTIONAL_BIT;
+[[vk::constant_id(1)]] const uint MAX_LIGHT_COUNT = 64;
+
+// material features are compiled variants, built from SHADER_VARIANTS in CMakeLists.txt
+#if defined(VARIANT_DIFFUSE)
+#define MATERIAL_SPECULAR 0
+#else
+#define MATERIAL_SPECULAR 1
+#endif
@@ -1,6 +1,7 @@
 struct PixelShaderInput
 {
-    float4 scrPos : SV_POSITION;
+    // precise, so a depth pre-pass variant computes the same depth as the lit pass
+    precise float4 scrPos : SV_POSITION;
 
     [[vk::location(1)]]
     float3 worldPos;
@@ -0,0 +1,27 @@
+// Normals go through the inverse-transpose of the upper 3x3, which equals its
+// cofactor matrix divided by the determinant. Only the sign of the determinant
+// matters once the result is normalized, so no inverse is needed.
+
+float3 affine_transform_point(float4 r0, float4 r1, float4 r2, float3 pos)
+{
+    // precise: it feeds SV_POSITION, which must match between the depth pre-pass and lit pass
+    float4 pos4 = float4(pos, 1);
+    precise float3 transformed = float3(dot(r0, pos4), dot(r1, pos4), dot(r2, pos4));
+    return transformed;
+}
+
+// r0..r2: rows of the upper 3x3
+float3 affine_normal_from_rows(float3 r0, float3 r1, float3 r2, float3 normal)
+{
+    float3 c0 = cross(r1, r2);
+    float3 cofactorNormal = float3(dot(c0, normal), dot(cross(r2, r0), normal), dot(cross(r0, r1), normal));
+    return normalize(dot(r0, c0) < 0 ? -cofactorNormal : cofactorNormal);
+}
+
+// c0..c2: columns of the upper 3x3
+float3 affine_normal_from_columns(float3 c0, float3 c1, float3 c2, float3 normal)
+{
+    float3 x = cross(c1, c2);
+    float3 cofactorNormal = normal.x * x + normal.y * cross(c2, c0) + normal.z * cross(c0, c1);
+    return normalize(dot(c0, x) < 0 ? -cofactorNormal : cofactorNormal);
+}
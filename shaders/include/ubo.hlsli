@@ -5,16 +5,13 @@ cbuffer UBO
     float4 cameraPos;
     float4x4 proj;
     float4x4 view;
-};
 
-[[vk::binding(0,1)]]
-cbuffer MeshUBO
-{
-    float4 baseColor;
-    float roughness;
-    float metallic;
-    float f0;
-    float _unused;
-    float4x4 meshModel;
-    float4x4 meshModelInvDual;
-};
\ No newline at end of file
+    // lights [0, globalLightCount) shade every pixel, the rest only their clusters
+    uint lightCount;
+    uint globalLightCount;
+    // cluster slice of a view depth d is log(d) * clusterDepthScale + clusterDepthBias
+    float clusterDepthScale;
+    float clusterDepthBias;
+    // inverse of proj * view, so the deferred lighting pass can rebuild positions from depth
+    float4x4 invViewProj;
+};
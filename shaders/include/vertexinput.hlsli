@@ -3,9 +3,12 @@ struct VertexInput
     [[vk::location(0)]]
     float3 inPosition : VTX_INPUT;
 
+#if !defined(VARIANT_DEPTH)
+    // the depth pre-pass fetches positions only
     [[vk::location(1)]]
     float3 inNormal;
 
     [[vk::location(2)]]
     float2 texCoord;
+#endif
 };
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "ubo.hlsli"
+#include "instancing.hlsli"
+#include "materialtable.hlsli"
+
+#if defined(VARIANT_GBUFFER)
+#include "gbuffer.hlsli"
+
+GBufferOutput main(InstancedPixelShaderInput psi)
+{
+    return write_gbuffer(table_material(psi.materialIdx), psi.inNormal);
+}
+#else
+struct PixelShaderOutput
+{
+    [[vk::location(0)]]
+    float4 fragColor : SV_TARGET;
+};
+
+PixelShaderOutput main(InstancedPixelShaderInput psi)
+{
+    PixelShaderOutput pso;
+    pso.fragColor = float4(shade_table_material(psi.materialIdx, psi.worldPos, psi.inNormal), 1);
+    return pso;
+}
+#endif
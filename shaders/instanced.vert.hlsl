@@ -0,0 +1,41 @@
+#include "vertexinput.hlsli"
+#include "ubo.hlsli"
+#include "drawrecord.hlsli"
+#include "instancing.hlsli"
+#include "transforms.hlsli"
+
+#define MAX_INSTANCES 65536
+
+// matches InstanceBuffer on the host
+[[vk::binding(0,2)]]
+tbuffer instanceRecords
+{
+    uint instanceCount;
+    DrawRecord instances[MAX_INSTANCES];
+};
+
+// matches InstanceBatchPushConstant on the host
+[[vk::push_constant]]
+cbuffer InstanceBatch
+{
+    uint instanceBase;
+};
+
+InstancedPixelShaderInput main(VertexInput vi, uint instanceId : SV_InstanceID)
+{
+    InstancedPixelShaderInput psi;
+    // batches are drawn with firstInstance = 0, so instanceId is relative to the batch
+    DrawRecord instance = instances[instanceBase + instanceId];
+    precise float3 worldPos = affine_transform_point(
+            instance.modelRows[0], instance.modelRows[1], instance.modelRows[2], vi.inPosition);
+
+    psi.scrPos = mul(proj, mul(view, float4(worldPos, 1)));
+#if !defined(VARIANT_DEPTH)
+    psi.inNormal = affine_normal_from_rows(
+            instance.modelRows[0].xyz, instance.modelRows[1].xyz, instance.modelRows[2].xyz, vi.inNormal);
+    psi.outTexCoord = vi.texCoord;
+#endif
+    psi.worldPos = worldPos;
+    psi.materialIdx = instance.materialIdx;
+    return psi;
+}
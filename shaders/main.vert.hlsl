@@ -1,19 +1,20 @@
 #include "vertexinput.hlsli"
 #include "pixelshader.hlsli"
 #include "ubo.hlsli"
+#include "drawtransform.hlsli"
 
 
 PixelShaderInput main(VertexInput vi)
 {
     PixelShaderInput psi;
-    float4 inPos4 = float4(vi.inPosition,1);
+    precise float3 worldPos = affine_transform_point(modelRows[0], modelRows[1], modelRows[2], vi.inPosition);
 
-    float4x4 MVP = mul(proj, mul(view, meshModel));
-    psi.scrPos = mul(MVP, inPos4);
-
-    float4 inNormalZ = mul(meshModelInvDual, float4(vi.inNormal,0));
-    psi.inNormal = normalize(inNormalZ.xyz);
+    psi.scrPos = mul(proj, mul(view, float4(worldPos, 1)));
+#if !defined(VARIANT_DEPTH)
+    psi.inNormal = affine_normal_from_rows(
+            modelRows[0].xyz, modelRows[1].xyz, modelRows[2].xyz, vi.inNormal);
     psi.outTexCoord = vi.texCoord;
-    psi.worldPos = mul(meshModel, inPos4).xyz;
+#endif
+    psi.worldPos = worldPos;
     return psi;
-}
\ No newline at end of file
+}
@@ -0,0 +1,93 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "Benchmark.h"
+#include <iomanip>
+#include <numeric>
+
+Benchmark::Benchmark(uint32_t const& frames, uint32_t const& warmup) :
+        frameCount(frames), warmupFrames(warmup)
+{
+}
+
+bool Benchmark::enabled() const
+{
+    return frameCount > 0;
+}
+
+bool Benchmark::finished() const
+{
+    return enabled() && framesSeen >= warmupFrames + frameCount;
+}
+
+void Benchmark::addSample(std::string const& name, double const& milliseconds)
+{
+    if (not enabled() || framesSeen < warmupFrames)
+    {
+        return;
+    }
+    samples[name].push_back(milliseconds);
+}
+
+void Benchmark::addCount(std::string const& name, uint64_t const& count)
+{
+    if (not enabled() || framesSeen < warmupFrames)
+    {
+        return;
+    }
+    counts[name].push_back(count);
+}
+
+void Benchmark::endFrame()
+{
+    if (enabled())
+    {
+        ++framesSeen;
+    }
+}
+
+void Benchmark::report(std::ostream& out, std::string const& label) const
+{
+    out << "Benchmark: " << label << ", " << frameCount << " frames" << std::endl;
+    out << std::fixed << std::setprecision(4);
+    for (auto const& [name, values] : samples)
+    {
+        if (values.empty())
+        {
+            continue;
+        }
+
+        std::vector<double> sorted(values);
+        std::sort(sorted.begin(), sorted.end());
+        double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(sorted.size());
+        auto percentile = [&sorted](double p)
+        {
+            auto idx = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+            return sorted[idx];
+        };
+
+        out << "  " << std::left << std::setw(20) << name << std::right
+            << " mean " << mean << " ms"
+            << " | p50 " << percentile(0.5) << " ms"
+            << " | p99 " << percentile(0.99) << " ms"
+            << " | min " << sorted.front() << " ms"
+            << " | max " << sorted.back() << " ms" << std::endl;
+    }
+
+    for (auto const& [name, values] : counts)
+    {
+        if (values.empty())
+        {
+            continue;
+        }
+
+        auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+        double mean = static_cast<double>(std::accumulate(values.begin(), values.end(), uint64_t(0))) /
+                static_cast<double>(values.size());
+        out << "  " << std::left << std::setw(20) << name << std::right
+            << " mean " << mean
+            << " | min " << *minIt
+            << " | max " << *maxIt << std::endl;
+    }
+}
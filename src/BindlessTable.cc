@@ -0,0 +1,354 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "BindlessTable.h"
+
+constexpr uint32_t DRAW_RECORD_BINDING = 0;
+constexpr uint32_t MATERIAL_BINDING = 1;
+constexpr uint32_t SAMPLER_BINDING = 2;
+constexpr uint32_t TEXTURE_ARRAY_BINDING = 3;
+
+VkPushConstantRange DrawPushConstant::pushConstantRange()
+{
+    VkPushConstantRange range = {};
+    range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    range.offset = 0;
+    range.size = sizeof(DrawPushConstant);
+    return range;
+}
+
+BindlessTable::BindlessTable(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice const& physDev) :
+        AVkGraphicsBase(logicalDev), allocator(allocator)
+{
+    VkPhysicalDeviceVulkan12Properties props12 = {};
+    props12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+    VkPhysicalDeviceProperties2 props = {};
+    props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    props.pNext = &props12;
+    vkGetPhysicalDeviceProperties2(physDev, &props);
+
+    maxTextures = std::min({
+        MAX_TEXTURES,
+        props12.maxDescriptorSetUpdateAfterBindSampledImages,
+        props12.maxPerStageDescriptorUpdateAfterBindSampledImages});
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        drawRecordBuffers.emplace_back(
+                logicalDev, allocator, physDev, MAX_DRAWS,
+                nullopt, 0,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        // one per frame, so a material change never lands in a buffer a pending frame reads
+        materialBuffers.emplace_back(
+                logicalDev, allocator, physDev, MAX_MATERIALS,
+                nullopt, 0,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    }
+
+    CHECK_VK_SUCCESS(createSampler(), ErrorMessages::FAILED_CANNOT_CREATE_SAMPLER);
+    CHECK_VK_SUCCESS(createDescriptorSetLayout(), "Cannot create bindless descriptor set layout!");
+    CHECK_VK_SUCCESS(createDescriptorPool(), ErrorMessages::FAILED_CANNOT_CREATE_DESC_POOL);
+    CHECK_VK_SUCCESS(createDescriptorSets(), "Cannot create bindless descriptor sets!");
+
+    writeBufferDescriptors();
+}
+
+BindlessTable::BindlessTable(BindlessTable&& table) noexcept :
+        AVkGraphicsBase(std::move(table)),
+        descriptorSetLayout(table.descriptorSetLayout),
+        descriptorPool(table.descriptorPool),
+        sampler(table.sampler),
+        descriptorSets(std::move(table.descriptorSets)),
+        allocator(table.allocator),
+        maxTextures(table.maxTextures),
+        drawRecordBuffers(std::move(table.drawRecordBuffers)),
+        materialBuffers(std::move(table.materialBuffers)),
+        materials(std::move(table.materials)),
+        staleMaterialFrames(table.staleMaterialFrames),
+        textureCount(table.textureCount)
+{
+    table.descriptorSetLayout = VK_NULL_HANDLE;
+    table.descriptorPool = VK_NULL_HANDLE;
+    table.sampler = VK_NULL_HANDLE;
+}
+
+BindlessTable& BindlessTable::operator=(BindlessTable&& table) noexcept
+{
+    dispose();
+
+    descriptorSetLayout = table.descriptorSetLayout;
+    descriptorPool = table.descriptorPool;
+    sampler = table.sampler;
+    descriptorSets = std::move(table.descriptorSets);
+    allocator = table.allocator;
+    maxTextures = table.maxTextures;
+    drawRecordBuffers = std::move(table.drawRecordBuffers);
+    materialBuffers = std::move(table.materialBuffers);
+    materials = std::move(table.materials);
+    staleMaterialFrames = table.staleMaterialFrames;
+    textureCount = table.textureCount;
+
+    table.descriptorSetLayout = VK_NULL_HANDLE;
+    table.descriptorPool = VK_NULL_HANDLE;
+    table.sampler = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(table));
+    return *this;
+}
+
+BindlessTable::~BindlessTable()
+{
+    dispose();
+}
+
+void BindlessTable::dispose()
+{
+    if (initialized())
+    {
+        // descriptor sets are freed along with the pool
+        vkDestroyDescriptorPool(getLogicalDev(), descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(getLogicalDev(), descriptorSetLayout, nullptr);
+        vkDestroySampler(getLogicalDev(), sampler, nullptr);
+    }
+}
+
+bool BindlessTable::supported(VkPhysicalDeviceVulkan12Features const& features)
+{
+    return features.descriptorIndexing
+        && features.runtimeDescriptorArray
+        && features.descriptorBindingPartiallyBound
+        && features.descriptorBindingVariableDescriptorCount
+        && features.descriptorBindingSampledImageUpdateAfterBind
+        && features.shaderSampledImageArrayNonUniformIndexing;
+}
+
+VkResult BindlessTable::createSampler()
+{
+    VkSamplerCreateInfo samplerInfo = {};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerInfo.anisotropyEnable = VK_TRUE;
+    samplerInfo.maxAnisotropy = 16;
+    samplerInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
+    samplerInfo.unnormalizedCoordinates = VK_FALSE;
+    samplerInfo.compareEnable = VK_FALSE;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.mipLodBias = 0.0f;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+
+    return vkCreateSampler(getLogicalDev(), &samplerInfo, nullptr, &sampler);
+}
+
+VkResult BindlessTable::createDescriptorSetLayout()
+{
+    VkDescriptorSetLayoutBinding samplerBinding = {};
+    samplerBinding.binding = SAMPLER_BINDING;
+    samplerBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    samplerBinding.descriptorCount = 1;
+    samplerBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    samplerBinding.pImmutableSamplers = &sampler;
+
+    VkDescriptorSetLayoutBinding textureBinding = {};
+    textureBinding.binding = TEXTURE_ARRAY_BINDING;
+    textureBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    textureBinding.descriptorCount = maxTextures;
+    textureBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    textureBinding.pImmutableSamplers = nullptr;
+
+    std::vector<VkDescriptorSetLayoutBinding> bindings = {
+            StorageBufferArray<DrawRecord>::DescriptorSetLayout(DRAW_RECORD_BINDING),
+            StorageBufferArray<MaterialRecord>::DescriptorSetLayout(MATERIAL_BINDING),
+            samplerBinding,
+            textureBinding
+    };
+
+    // only the texture array is written while the set may be in use;
+    // it must be the last binding to have a variable count.
+    std::vector<VkDescriptorBindingFlags> bindingFlags = {
+            0,
+            0,
+            0,
+            VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+            VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+            VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {};
+    bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+    bindingFlagsInfo.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+    bindingFlagsInfo.pBindingFlags = bindingFlags.data();
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.pNext = &bindingFlagsInfo;
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+    layoutInfo.pBindings = bindings.data();
+
+    return vkCreateDescriptorSetLayout(getLogicalDev(), &layoutInfo, nullptr, &descriptorSetLayout);
+}
+
+VkResult BindlessTable::createDescriptorPool()
+{
+    auto const frameCount = static_cast<uint32_t>(MAX_FRAMES_IN_FLIGHT);
+
+    VkDescriptorPoolSize poolSize[3] = {{}, {}, {}};
+    poolSize[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize[0].descriptorCount = 2 * frameCount;
+
+    poolSize[1].type = VK_DESCRIPTOR_TYPE_SAMPLER;
+    poolSize[1].descriptorCount = frameCount;
+
+    poolSize[2].type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    poolSize[2].descriptorCount = maxTextures * frameCount;
+
+    VkDescriptorPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    createInfo.poolSizeCount = 3;
+    createInfo.pPoolSizes = poolSize;
+    createInfo.maxSets = frameCount;
+
+    return vkCreateDescriptorPool(getLogicalDev(), &createInfo, nullptr, &descriptorPool);
+}
+
+VkResult BindlessTable::createDescriptorSets()
+{
+    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    std::vector<uint32_t> variableCounts(MAX_FRAMES_IN_FLIGHT, maxTextures);
+
+    VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo = {};
+    variableCountInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+    variableCountInfo.descriptorSetCount = static_cast<uint32_t>(variableCounts.size());
+    variableCountInfo.pDescriptorCounts = variableCounts.data();
+
+    VkDescriptorSetAllocateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    createInfo.pNext = &variableCountInfo;
+    createInfo.descriptorPool = descriptorPool;
+    createInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
+    createInfo.pSetLayouts = layouts.data();
+
+    descriptorSets.resize(MAX_FRAMES_IN_FLIGHT);
+    return vkAllocateDescriptorSets(getLogicalDev(), &createInfo, descriptorSets.data());
+}
+
+void BindlessTable::writeBufferDescriptors()
+{
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        VkDescriptorBufferInfo drawBufferInfo = {};
+        drawBufferInfo.buffer = drawRecordBuffers[i].vertexBuffer;
+        drawBufferInfo.offset = 0;
+        drawBufferInfo.range = drawRecordBuffers[i].getSize();
+
+        VkDescriptorBufferInfo materialBufferInfo = {};
+        materialBufferInfo.buffer = materialBuffers[i].vertexBuffer;
+        materialBufferInfo.offset = 0;
+        materialBufferInfo.range = materialBuffers[i].getSize();
+
+        VkWriteDescriptorSet writes[2] = {{}, {}};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = descriptorSets[i];
+        writes[0].dstBinding = DRAW_RECORD_BINDING;
+        writes[0].dstArrayElement = 0;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[0].descriptorCount = 1;
+        writes[0].pBufferInfo = &drawBufferInfo;
+
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = descriptorSets[i];
+        writes[1].dstBinding = MATERIAL_BINDING;
+        writes[1].dstArrayElement = 0;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[1].descriptorCount = 1;
+        writes[1].pBufferInfo = &materialBufferInfo;
+
+        vkUpdateDescriptorSets(getLogicalDev(), 2, writes, 0, nullptr);
+    }
+}
+
+uint32_t BindlessTable::registerTexture(Image::Image const& img)
+{
+    if (textureCount >= maxTextures)
+    {
+        throw std::runtime_error("Bindless texture table is full!");
+    }
+
+    uint32_t idx = textureCount++;
+
+    VkDescriptorImageInfo imageInfo = {};
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    imageInfo.imageView = img.imgView;
+    imageInfo.sampler = VK_NULL_HANDLE;
+
+    std::vector<VkWriteDescriptorSet> writes(MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = descriptorSets[i];
+        writes[i].dstBinding = TEXTURE_ARRAY_BINDING;
+        writes[i].dstArrayElement = idx;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        writes[i].descriptorCount = 1;
+        writes[i].pImageInfo = &imageInfo;
+    }
+
+    // update-after-bind: safe even if the sets are bound in a pending command buffer,
+    // since this slot is not accessed by any in-flight draw.
+    vkUpdateDescriptorSets(
+            getLogicalDev(), static_cast<uint32_t>(writes.size()),
+            writes.data(), 0, nullptr);
+    return idx;
+}
+
+uint32_t BindlessTable::registerMaterial(MaterialRecord const& material)
+{
+    if (materials.size() >= MAX_MATERIALS)
+    {
+        throw std::runtime_error("Bindless material table is full!");
+    }
+
+    materials.push_back(material);
+    staleMaterialFrames = (1u << MAX_FRAMES_IN_FLIGHT) - 1;
+    return static_cast<uint32_t>(materials.size() - 1);
+}
+
+void BindlessTable::updateMaterial(uint32_t const& idx, MaterialRecord const& material)
+{
+    materials.at(idx) = material;
+    staleMaterialFrames = (1u << MAX_FRAMES_IN_FLIGHT) - 1;
+}
+
+VkResult BindlessTable::setDrawRecords(uint32_t const& frameIdx, std::vector<DrawRecord> const& records)
+{
+    return drawRecordBuffers[frameIdx].loadDataAndSetSize(records);
+}
+
+VkResult BindlessTable::syncMaterials(uint32_t const& frameIdx)
+{
+    uint32_t frameBit = 1u << frameIdx;
+    if ((staleMaterialFrames & frameBit) == 0)
+    {
+        return VK_SUCCESS;
+    }
+
+    VkResult ret = materialBuffers[frameIdx].loadDataAndSetSize(materials);
+    if (ret == VK_SUCCESS)
+    {
+        staleMaterialFrames &= ~frameBit;
+    }
+    return ret;
+}
+
+uint32_t BindlessTable::textureCapacity() const
+{
+    return maxTextures;
+}
@@ -52,29 +52,41 @@ namespace Buffers
     Buffer::Buffer(Buffer&& buf) noexcept:
             AVkGraphicsBase(std::move(buf)), allocator(std::move(buf.allocator)),
             size(std::move(buf.size)),
-            vertexBuffer(std::move(buf.vertexBuffer)), allocation(std::move(buf.allocation))
+            vertexBuffer(std::move(buf.vertexBuffer)), allocation(std::move(buf.allocation)),
+            mappedMemory(buf.mappedMemory)
     {
+        buf.mappedMemory = nullptr;
     }
 
     Buffer& Buffer::operator=(Buffer&& buf) noexcept
     {
-        AVkGraphicsBase::operator=(std::move(buf));
+        // destroy whatever's left here; retire it to a DeletionQueue first if the GPU may still use it
+        dispose();
 
         allocator = std::move(buf.allocator);
         size = std::move(buf.size);
         vertexBuffer = std::move(buf.vertexBuffer);
         allocation = std::move(buf.allocation);
+        mappedMemory = buf.mappedMemory;
+        buf.mappedMemory = nullptr;
 
+        AVkGraphicsBase::operator=(std::move(buf));
         return *this;
     }
 
     Buffer::~Buffer()
+    {
+        dispose();
+    }
+
+    void Buffer::dispose()
     {
         if (initialized())
         {
             if (mappedMemory)
             {
                 vmaUnmapMemory(*allocator, allocation);
+                mappedMemory = nullptr;
             }
             vmaDestroyBuffer(*allocator, vertexBuffer, allocation);
         }
@@ -85,6 +97,14 @@ namespace Buffers
         return static_cast<uint32_t>(size);
     }
 
+    VkDeviceAddress Buffer::deviceAddress() const
+    {
+        VkBufferDeviceAddressInfo addressInfo = {};
+        addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+        addressInfo.buffer = vertexBuffer;
+        return vkGetBufferDeviceAddress(getLogicalDev(), &addressInfo);
+    }
+
     VkResult Buffer::createVertexBuffer(
             VkBufferUsageFlags const& bufferUsageFlags,
             VmaMemoryUsage const& memoryUsage,
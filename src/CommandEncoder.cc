@@ -0,0 +1,130 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "CommandEncoder.h"
+
+void CommandEncoder::begin(VkCommandBuffer const& commandBuffer)
+{
+    cmdBuf = commandBuffer;
+    bindStats = {};
+
+    boundPipeline = VK_NULL_HANDLE;
+    boundLayout = VK_NULL_HANDLE;
+    for (auto& boundSet : boundSets)
+    {
+        boundSet.set = VK_NULL_HANDLE;
+        boundSet.dynamicOffsets.clear();
+    }
+    boundVertexBuffer = VK_NULL_HANDLE;
+    boundIndexBuffer = VK_NULL_HANDLE;
+}
+
+void CommandEncoder::bindPipeline(VkPipeline const& pipeline)
+{
+    if (pipeline == boundPipeline)
+    {
+        ++bindStats.skipped;
+        return;
+    }
+
+    vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    boundPipeline = pipeline;
+    ++bindStats.issued;
+}
+
+void CommandEncoder::bindDescriptorSets(
+        VkPipelineLayout const& layout,
+        uint32_t const& firstSet,
+        uint32_t const& setCount,
+        VkDescriptorSet const* sets,
+        uint32_t const& dynamicOffsetCount,
+        uint32_t const* dynamicOffsets)
+{
+    assert(firstSet + setCount <= MAX_DESCRIPTOR_SETS);
+
+    // sets bound under another layout may have been disturbed; assume nothing survives
+    if (layout != boundLayout)
+    {
+        for (auto& boundSet : boundSets)
+        {
+            boundSet.set = VK_NULL_HANDLE;
+            boundSet.dynamicOffsets.clear();
+        }
+        boundLayout = layout;
+    }
+
+    BoundSet& first = boundSets[firstSet];
+    bool unchanged =
+            first.dynamicOffsets.size() == dynamicOffsetCount &&
+            std::equal(first.dynamicOffsets.begin(), first.dynamicOffsets.end(), dynamicOffsets);
+    for (uint32_t i = 0; i < setCount && unchanged; ++i)
+    {
+        BoundSet const& boundSet = boundSets[firstSet + i];
+        unchanged = boundSet.set == sets[i] && (i == 0 || boundSet.dynamicOffsets.empty());
+    }
+
+    if (unchanged)
+    {
+        ++bindStats.skipped;
+        return;
+    }
+
+    vkCmdBindDescriptorSets(
+            cmdBuf,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            layout,
+            firstSet,
+            setCount, sets,
+            dynamicOffsetCount, dynamicOffsets);
+
+    for (uint32_t i = 0; i < setCount; ++i)
+    {
+        boundSets[firstSet + i].set = sets[i];
+        boundSets[firstSet + i].dynamicOffsets.clear();
+    }
+    first.dynamicOffsets.assign(dynamicOffsets, dynamicOffsets + dynamicOffsetCount);
+    ++bindStats.issued;
+}
+
+void CommandEncoder::bindVertexStreams(VkBuffer const& buffer, VertexStreams const& streams)
+{
+    if (buffer == boundVertexBuffer && streams.count == boundVertexStreams.count &&
+        std::equal(streams.offsets.begin(), streams.offsets.begin() + streams.count, boundVertexStreams.offsets.begin()))
+    {
+        ++bindStats.skipped;
+        return;
+    }
+
+    std::array<VkBuffer, VertexStreams::MAX_STREAMS> vertBuffers;
+    vertBuffers.fill(buffer);
+    vkCmdBindVertexBuffers(cmdBuf, 0, streams.count, vertBuffers.data(), streams.offsets.data());
+    boundVertexBuffer = buffer;
+    boundVertexStreams = streams;
+    ++bindStats.issued;
+}
+
+void CommandEncoder::bindIndexBuffer(VkBuffer const& buffer, VkDeviceSize const& offset, VkIndexType const& indexType)
+{
+    if (buffer == boundIndexBuffer && offset == boundIndexOffset && indexType == boundIndexType)
+    {
+        ++bindStats.skipped;
+        return;
+    }
+
+    vkCmdBindIndexBuffer(cmdBuf, buffer, offset, indexType);
+    boundIndexBuffer = buffer;
+    boundIndexOffset = offset;
+    boundIndexType = indexType;
+    ++bindStats.issued;
+}
+
+VkCommandBuffer const& CommandEncoder::commandBuffer() const
+{
+    return cmdBuf;
+}
+
+BindStats const& CommandEncoder::stats() const
+{
+    return bindStats;
+}
@@ -0,0 +1,99 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "ComputePipeline.h"
+
+ComputePipeline::ComputePipeline(
+        VkDevice* device,
+        VkPipelineCache const& pipelineCache,
+        std::string const& compShader,
+        std::vector<VkDescriptorSetLayout> const& descriptorSetLayout,
+        std::vector<VkPushConstantRange> const& pushConstantRanges) :
+        AVkGraphicsBase(device), pushConstantRanges(pushConstantRanges)
+{
+    CHECK_VK_SUCCESS(
+            createComputePipeline(pipelineCache, compShader, descriptorSetLayout, pushConstantRanges),
+            "Cannot create compute pipeline!");
+}
+
+VkResult ComputePipeline::createComputePipeline(
+        VkPipelineCache const& pipelineCache,
+        std::string const& compShaderName,
+        std::vector<VkDescriptorSetLayout> const& descriptorSetLayout,
+        std::vector<VkPushConstantRange> const& pushConstantRanges)
+{
+    auto [compShader, ret] = Shaders::createShaderModule(getLogicalDev(), compShaderName);
+    if (ret != VK_SUCCESS)
+    {
+        throw std::runtime_error("Cannot create shader");
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayout.size());
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayout.data();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+    pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
+
+    CHECK_VK_SUCCESS(vkCreatePipelineLayout(getLogicalDev(), &pipelineLayoutCreateInfo, nullptr, &pipelineLayout),
+                     "Cannot create pipeline layout!");
+
+    VkComputePipelineCreateInfo pipelineCreateInfo = {};
+    pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineCreateInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineCreateInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineCreateInfo.stage.module = compShader;
+    pipelineCreateInfo.stage.pName = "main";
+    pipelineCreateInfo.layout = pipelineLayout;
+    pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+    pipelineCreateInfo.basePipelineIndex = -1;
+
+    auto retFinal = vkCreateComputePipelines(
+            getLogicalDev(), pipelineCache, 1, &pipelineCreateInfo, nullptr,
+            &pipeline);
+    vkDestroyShaderModule(getLogicalDev(), compShader, nullptr);
+
+    return retFinal;
+}
+
+ComputePipeline::ComputePipeline(ComputePipeline&& computePipeline) noexcept:
+        AVkGraphicsBase(std::move(computePipeline)),
+        pipeline(computePipeline.pipeline),
+        pipelineLayout(computePipeline.pipelineLayout),
+        pushConstantRanges(std::move(computePipeline.pushConstantRanges))
+{
+    computePipeline.pipeline = VK_NULL_HANDLE;
+    computePipeline.pipelineLayout = VK_NULL_HANDLE;
+}
+
+ComputePipeline& ComputePipeline::operator=(ComputePipeline&& computePipeline) noexcept
+{
+    dispose();
+
+    pipeline = computePipeline.pipeline;
+    pipelineLayout = computePipeline.pipelineLayout;
+    pushConstantRanges = std::move(computePipeline.pushConstantRanges);
+
+    computePipeline.pipeline = VK_NULL_HANDLE;
+    computePipeline.pipelineLayout = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(computePipeline));
+    return *this;
+}
+
+ComputePipeline::~ComputePipeline()
+{
+    dispose();
+}
+
+void ComputePipeline::dispose()
+{
+    if (initialized())
+    {
+        vkDestroyPipeline(getLogicalDev(), pipeline, nullptr);
+        vkDestroyPipelineLayout(getLogicalDev(), pipelineLayout, nullptr);
+        pipeline = VK_NULL_HANDLE;
+        pipelineLayout = VK_NULL_HANDLE;
+    }
+}
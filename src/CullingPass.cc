@@ -0,0 +1,296 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "CullingPass.h"
+
+constexpr uint32_t INSTANCE_BINDING = 0;
+constexpr uint32_t MESH_BINDING = 1;
+constexpr uint32_t DRAW_COMMAND_BINDING = 2;
+constexpr uint32_t DRAW_COUNT_BINDING = 3;
+
+CullPushConstant CullPushConstant::fromViewProj(glm::mat4 const& viewProj)
+{
+    Frustum frustum = Frustum::fromViewProj(viewProj);
+    CullPushConstant pushConstant = {};
+    std::copy(std::begin(frustum.planes), std::end(frustum.planes), pushConstant.frustumPlanes);
+    return pushConstant;
+}
+
+VkPushConstantRange CullPushConstant::pushConstantRange()
+{
+    VkPushConstantRange range = {};
+    range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    range.offset = 0;
+    range.size = sizeof(CullPushConstant);
+    return range;
+}
+
+CullingPass::CullingPass(
+        VkDevice* logicalDev,
+        VmaAllocator* allocator,
+        VkPhysicalDevice const& physDev,
+        QueueFamilies& queueFamilies,
+        DescriptorAllocator& descAllocator,
+        DescriptorLayoutCache& layoutCache,
+        GeometryBuffer const& geometry,
+        InstanceBuffer const& instances,
+        VkPipelineCache const& pipelineCache,
+        std::string const& cullShader) :
+        AVkGraphicsBase(logicalDev)
+{
+    auto const& ranges = geometry.meshRanges();
+    if (ranges.size() > MAX_MESHES)
+    {
+        throw std::runtime_error("Too many meshes to cull!");
+    }
+
+    meshBuffer = std::make_unique<StorageBufferArray<MeshRange>>(
+            logicalDev, allocator, physDev, MAX_MESHES,
+            nullopt, 0,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    CHECK_VK_SUCCESS(meshBuffer->loadDataAndSetSize(ranges), "Cannot upload mesh ranges!");
+
+    // written by the compute queue, read by the graphics queue
+    drawCommandBuffers.reserve(MAX_FRAMES_IN_FLIGHT);
+    drawCountBuffers.reserve(MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        drawCommandBuffers.emplace_back(
+                logicalDev, allocator, physDev,
+                InstanceBuffer::MAX_INSTANCES * sizeof(VkDrawIndexedIndirectCommand),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                VMA_MEMORY_USAGE_GPU_ONLY,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                queueFamilies.queuesForCompute());
+
+        drawCountBuffers.emplace_back(
+                logicalDev, allocator, physDev, sizeof(uint32_t),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                VMA_MEMORY_USAGE_GPU_ONLY,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                queueFamilies.queuesForCompute());
+    }
+
+    auto storageBinding = [](uint32_t binding)
+    {
+        VkDescriptorSetLayoutBinding layoutBinding = {};
+        layoutBinding.binding = binding;
+        layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        layoutBinding.descriptorCount = 1;
+        layoutBinding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        layoutBinding.pImmutableSamplers = nullptr;
+        return layoutBinding;
+    };
+
+    descriptorSetLayout = layoutCache.getLayout({
+            storageBinding(INSTANCE_BINDING),
+            StorageBufferArray<MeshRange>::DescriptorSetLayout(MESH_BINDING),
+            storageBinding(DRAW_COMMAND_BINDING),
+            storageBinding(DRAW_COUNT_BINDING)
+    });
+
+    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    CHECK_VK_SUCCESS(descAllocator.allocate(layouts, descriptorSets), "Cannot create culling descriptor sets!");
+    writeDescriptorSets(instances);
+
+    pipeline = std::make_unique<ComputePipeline>(
+            logicalDev, pipelineCache, cullShader,
+            std::vector<VkDescriptorSetLayout> { descriptorSetLayout },
+            std::vector<VkPushConstantRange> { CullPushConstant::pushConstantRange() });
+
+    CHECK_VK_SUCCESS(createCommandPool(queueFamilies.computeQueueFamily()), ErrorMessages::CREATE_COMMAND_POOL_FAILED);
+    CHECK_VK_SUCCESS(createCommandBuffers(), ErrorMessages::CREATE_COMMAND_BUFFERS_FAILED);
+    CHECK_VK_SUCCESS(createSemaphores(), "Cannot create Semaphore!");
+}
+
+CullingPass::CullingPass(CullingPass&& cullingPass) noexcept :
+        AVkGraphicsBase(std::move(cullingPass)),
+        descriptorSetLayout(cullingPass.descriptorSetLayout),
+        descriptorSets(std::move(cullingPass.descriptorSets)),
+        pipeline(std::move(cullingPass.pipeline)),
+        meshBuffer(std::move(cullingPass.meshBuffer)),
+        drawCommandBuffers(std::move(cullingPass.drawCommandBuffers)),
+        drawCountBuffers(std::move(cullingPass.drawCountBuffers)),
+        cmdPool(cullingPass.cmdPool),
+        cmdBuffers(std::move(cullingPass.cmdBuffers)),
+        cullFinished(std::move(cullingPass.cullFinished))
+{
+    cullingPass.cmdPool = VK_NULL_HANDLE;
+    cullingPass.cullFinished.clear();
+}
+
+CullingPass& CullingPass::operator=(CullingPass&& cullingPass) noexcept
+{
+    dispose();
+
+    descriptorSetLayout = cullingPass.descriptorSetLayout;
+    descriptorSets = std::move(cullingPass.descriptorSets);
+    pipeline = std::move(cullingPass.pipeline);
+    meshBuffer = std::move(cullingPass.meshBuffer);
+    drawCommandBuffers = std::move(cullingPass.drawCommandBuffers);
+    drawCountBuffers = std::move(cullingPass.drawCountBuffers);
+    cmdPool = cullingPass.cmdPool;
+    cmdBuffers = std::move(cullingPass.cmdBuffers);
+    cullFinished = std::move(cullingPass.cullFinished);
+
+    cullingPass.cmdPool = VK_NULL_HANDLE;
+    cullingPass.cullFinished.clear();
+
+    AVkGraphicsBase::operator=(std::move(cullingPass));
+    return *this;
+}
+
+CullingPass::~CullingPass()
+{
+    dispose();
+}
+
+void CullingPass::dispose()
+{
+    if (initialized())
+    {
+        for (auto& semaphore : cullFinished)
+        {
+            vkDestroySemaphore(getLogicalDev(), semaphore, nullptr);
+        }
+        cullFinished.clear();
+
+        // command buffers are freed along with the pool
+        vkDestroyCommandPool(getLogicalDev(), cmdPool, nullptr);
+        cmdPool = VK_NULL_HANDLE;
+    }
+}
+
+bool CullingPass::supported(VkPhysicalDeviceFeatures const& features, VkPhysicalDeviceVulkan12Features const& features12)
+{
+    return features.multiDrawIndirect
+        && features.drawIndirectFirstInstance
+        && features12.drawIndirectCount;
+}
+
+VkResult CullingPass::createCommandPool(uint32_t const& computeFamily)
+{
+    VkCommandPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.queueFamilyIndex = computeFamily;
+    createInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    return vkCreateCommandPool(getLogicalDev(), &createInfo, nullptr, &cmdPool);
+}
+
+VkResult CullingPass::createCommandBuffers()
+{
+    cmdBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    VkCommandBufferAllocateInfo allocateInfo = {};
+    allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocateInfo.commandPool = cmdPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = static_cast<uint32_t>(cmdBuffers.size());
+
+    return vkAllocateCommandBuffers(getLogicalDev(), &allocateInfo, cmdBuffers.data());
+}
+
+VkResult CullingPass::createSemaphores()
+{
+    VkSemaphoreCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    cullFinished.resize(MAX_FRAMES_IN_FLIGHT, VK_NULL_HANDLE);
+    for (auto& semaphore : cullFinished)
+    {
+        VkResult ret = vkCreateSemaphore(getLogicalDev(), &createInfo, nullptr, &semaphore);
+        if (ret != VK_SUCCESS)
+        {
+            return ret;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+void CullingPass::writeDescriptorSets(InstanceBuffer const& instances)
+{
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        auto const frameIdx = static_cast<uint32_t>(i);
+        VkDescriptorBufferInfo bufferInfos[4] = {
+                { instances.records(frameIdx).vertexBuffer, 0, instances.records(frameIdx).getSize() },
+                { meshBuffer->vertexBuffer, 0, meshBuffer->getSize() },
+                { drawCommandBuffers[i].vertexBuffer, 0, drawCommandBuffers[i].getSize() },
+                { drawCountBuffers[i].vertexBuffer, 0, drawCountBuffers[i].getSize() }
+        };
+        uint32_t const bindings[4] = { INSTANCE_BINDING, MESH_BINDING, DRAW_COMMAND_BINDING, DRAW_COUNT_BINDING };
+
+        VkWriteDescriptorSet descriptorWrites[4] = {};
+        for (size_t j = 0; j < 4; ++j)
+        {
+            descriptorWrites[j].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            descriptorWrites[j].dstSet = descriptorSets[i];
+            descriptorWrites[j].dstBinding = bindings[j];
+            descriptorWrites[j].dstArrayElement = 0;
+            descriptorWrites[j].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            descriptorWrites[j].descriptorCount = 1;
+            descriptorWrites[j].pBufferInfo = &bufferInfos[j];
+        }
+
+        vkUpdateDescriptorSets(getLogicalDev(), 4, descriptorWrites, 0, nullptr);
+    }
+}
+
+VkSemaphore CullingPass::submit(
+        uint32_t const& frameIdx,
+        VkQueue const& computeQueue,
+        uint32_t const& instanceCount,
+        CullPushConstant const& frustum)
+{
+    VkCommandBuffer& cmdBuf = cmdBuffers[frameIdx];
+    vkResetCommandBuffer(cmdBuf, 0);
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    CHECK_VK_SUCCESS(vkBeginCommandBuffer(cmdBuf, &beginInfo), "Failed to begin buffer recording!");
+
+    vkCmdFillBuffer(cmdBuf, drawCountBuffers[frameIdx].vertexBuffer, 0, sizeof(uint32_t), 0);
+
+    VkMemoryBarrier clearBarrier = {};
+    clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(
+            cmdBuf,
+            VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+
+    vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipeline);
+    vkCmdBindDescriptorSets(
+            cmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->pipelineLayout,
+            0, 1, &descriptorSets[frameIdx], 0, nullptr);
+    vkCmdPushConstants(
+            cmdBuf, pipeline->pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(CullPushConstant), &frustum);
+    vkCmdDispatch(cmdBuf, (instanceCount + WORKGROUP_SIZE - 1) / WORKGROUP_SIZE, 1, 1);
+
+    CHECK_VK_SUCCESS(vkEndCommandBuffer(cmdBuf), "Cannot end command buffer!");
+
+    // the semaphore makes the results visible to the graphics queue
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmdBuf;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &cullFinished[frameIdx];
+
+    CHECK_VK_SUCCESS(vkQueueSubmit(computeQueue, 1, &submitInfo, VK_NULL_HANDLE), "Cannot submit culling!");
+    return cullFinished[frameIdx];
+}
+
+void CullingPass::cmdDraw(VkCommandBuffer& cmdBuf, uint32_t const& frameIdx, uint32_t const& maxDrawCount) const
+{
+    vkCmdDrawIndexedIndirectCount(
+            cmdBuf,
+            drawCommandBuffers[frameIdx].vertexBuffer, 0,
+            drawCountBuffers[frameIdx].vertexBuffer, 0,
+            maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
+}
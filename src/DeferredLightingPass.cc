@@ -0,0 +1,117 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DeferredLightingPass.h"
+
+DeferredLightingPass::DeferredLightingPass(
+        VkDevice* device,
+        VkPipelineCache const& pipelineCache,
+        VkRenderPass const& renderPass,
+        std::vector<VkDescriptorSetLayout> const& descriptorSetLayout) :
+        AVkGraphicsBase(device)
+{
+    CHECK_VK_SUCCESS(
+            createPipeline(pipelineCache, renderPass, descriptorSetLayout),
+            ErrorMessages::CREATE_GRAPHICS_PIPELINE_FAILED);
+}
+
+VkResult DeferredLightingPass::createPipeline(
+        VkPipelineCache const& pipelineCache,
+        VkRenderPass const& renderPass,
+        std::vector<VkDescriptorSetLayout> const& descriptorSetLayout)
+{
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayout.size());
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayout.data();
+
+    CHECK_VK_SUCCESS(vkCreatePipelineLayout(getLogicalDev(), &pipelineLayoutCreateInfo, nullptr, &pipelineLayout),
+                     "Cannot create pipeline layout!");
+
+    PipelineShaderStage vertStage(getLogicalDev(), VK_SHADER_STAGE_VERTEX_BIT, "deferred.vert.spv");
+    PipelineShaderStage fragStage(getLogicalDev(), VK_SHADER_STAGE_FRAGMENT_BIT, "deferred.frag.spv");
+    VkPipelineShaderStageCreateInfo stages[] = {vertStage.info, fragStage.info};
+
+    // the triangle comes from the vertex index alone, and the subpass has no depth attachment
+    PipelineFixedState fixedState(false);
+    fixedState.vertexInput.vertexBindingDescriptionCount = 0;
+    fixedState.vertexInput.vertexAttributeDescriptionCount = 0;
+    fixedState.rasterizer.cullMode = VK_CULL_MODE_NONE;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.stageCount = 2;
+    createInfo.pStages = stages;
+    fixedState.fill(createInfo);
+    createInfo.pDepthStencilState = nullptr;
+    createInfo.layout = pipelineLayout;
+    createInfo.renderPass = renderPass;
+    createInfo.subpass = 1;
+    createInfo.basePipelineIndex = -1;
+
+    return vkCreateGraphicsPipelines(getLogicalDev(), pipelineCache, 1, &createInfo, nullptr, &pipeline);
+}
+
+void DeferredLightingPass::cmdDraw(
+        VkCommandBuffer& cmdBuf,
+        VkDescriptorSet const& frameSet,
+        VkDescriptorSet const& gbufferSet,
+        VkExtent2D const& extent) const
+{
+    vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+    VkDescriptorSet descSets[2] = {frameSet, gbufferSet};
+    vkCmdBindDescriptorSets(
+            cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+            0, 2, descSets, 0, nullptr);
+
+    VkViewport viewport = {};
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    VkRect2D scissor = {{0, 0}, extent};
+    vkCmdSetViewport(cmdBuf, 0, 1, &viewport);
+    vkCmdSetScissor(cmdBuf, 0, 1, &scissor);
+
+    vkCmdDraw(cmdBuf, 3, 1, 0, 0);
+}
+
+DeferredLightingPass::DeferredLightingPass(DeferredLightingPass&& lightingPass) noexcept:
+        AVkGraphicsBase(std::move(lightingPass)),
+        pipeline(lightingPass.pipeline),
+        pipelineLayout(lightingPass.pipelineLayout)
+{
+    lightingPass.pipeline = VK_NULL_HANDLE;
+    lightingPass.pipelineLayout = VK_NULL_HANDLE;
+}
+
+DeferredLightingPass& DeferredLightingPass::operator=(DeferredLightingPass&& lightingPass) noexcept
+{
+    dispose();
+
+    pipeline = lightingPass.pipeline;
+    pipelineLayout = lightingPass.pipelineLayout;
+
+    lightingPass.pipeline = VK_NULL_HANDLE;
+    lightingPass.pipelineLayout = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(lightingPass));
+    return *this;
+}
+
+DeferredLightingPass::~DeferredLightingPass()
+{
+    dispose();
+}
+
+void DeferredLightingPass::dispose()
+{
+    if (initialized())
+    {
+        vkDestroyPipeline(getLogicalDev(), pipeline, nullptr);
+        vkDestroyPipelineLayout(getLogicalDev(), pipelineLayout, nullptr);
+        pipeline = VK_NULL_HANDLE;
+        pipelineLayout = VK_NULL_HANDLE;
+    }
+}
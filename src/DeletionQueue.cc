@@ -0,0 +1,54 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DeletionQueue.h"
+
+DeletionQueue::~DeletionQueue()
+{
+    flush();
+}
+
+void DeletionQueue::defer(uint64_t const& value, std::function<void()> destroy)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ value, std::move(destroy) });
+}
+
+void DeletionQueue::collect(FrameTimeline& timeline)
+{
+    std::vector<Entry> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (not entries.empty() && timeline.reached(entries.front().value))
+        {
+            done.push_back(std::move(entries.front()));
+            entries.pop_front();
+        }
+    }
+
+    // outside the lock, so destructors may retire further objects
+    for (auto& entry : done)
+    {
+        entry.destroy();
+    }
+}
+
+void DeletionQueue::flush()
+{
+    std::deque<Entry> done;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.swap(entries);
+    }
+    for (auto& entry : done)
+    {
+        entry.destroy();
+    }
+}
+
+size_t DeletionQueue::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
@@ -0,0 +1,220 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DescriptorAllocator.h"
+
+DescriptorAllocator::DescriptorAllocator(
+        VkDevice* logicalDev,
+        std::vector<PoolSizeRatio> poolRatios,
+        uint32_t const& initialSetsPerPool,
+        VkDescriptorPoolCreateFlags const& poolFlags) :
+        AVkGraphicsBase(logicalDev), ratios(std::move(poolRatios)),
+        flags(poolFlags), setsPerPool(initialSetsPerPool)
+{
+}
+
+DescriptorAllocator::DescriptorAllocator(DescriptorAllocator&& descAllocator) noexcept :
+        AVkGraphicsBase(std::move(descAllocator)),
+        ratios(std::move(descAllocator.ratios)),
+        flags(descAllocator.flags),
+        setsPerPool(descAllocator.setsPerPool),
+        currentPool(descAllocator.currentPool),
+        usedPools(std::move(descAllocator.usedPools)),
+        freePools(std::move(descAllocator.freePools))
+{
+    descAllocator.currentPool = VK_NULL_HANDLE;
+    descAllocator.usedPools.clear();
+    descAllocator.freePools.clear();
+}
+
+DescriptorAllocator& DescriptorAllocator::operator=(DescriptorAllocator&& descAllocator) noexcept
+{
+    dispose();
+
+    ratios = std::move(descAllocator.ratios);
+    flags = descAllocator.flags;
+    setsPerPool = descAllocator.setsPerPool;
+    currentPool = descAllocator.currentPool;
+    usedPools = std::move(descAllocator.usedPools);
+    freePools = std::move(descAllocator.freePools);
+
+    descAllocator.currentPool = VK_NULL_HANDLE;
+    descAllocator.usedPools.clear();
+    descAllocator.freePools.clear();
+
+    AVkGraphicsBase::operator=(std::move(descAllocator));
+    return *this;
+}
+
+DescriptorAllocator::~DescriptorAllocator()
+{
+    dispose();
+}
+
+void DescriptorAllocator::dispose()
+{
+    if (initialized())
+    {
+        for (auto const& [pool, setCount] : usedPools)
+        {
+            vkDestroyDescriptorPool(getLogicalDev(), pool, nullptr);
+        }
+        for (auto const& [pool, setCount] : freePools)
+        {
+            vkDestroyDescriptorPool(getLogicalDev(), pool, nullptr);
+        }
+        usedPools.clear();
+        freePools.clear();
+        currentPool = VK_NULL_HANDLE;
+    }
+}
+
+std::vector<DescriptorAllocator::PoolSizeRatio> DescriptorAllocator::defaultPoolRatios()
+{
+    return {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.f },
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.f },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1.f },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2.f },
+    };
+}
+
+VkResult DescriptorAllocator::createPool(uint32_t const& setCount, VkDescriptorPool& pool)
+{
+    std::vector<VkDescriptorPoolSize> poolSizes;
+    poolSizes.reserve(ratios.size());
+    for (auto const& [type, ratio] : ratios)
+    {
+        VkDescriptorPoolSize& poolSize = poolSizes.emplace_back();
+        poolSize.type = type;
+        poolSize.descriptorCount = std::max(1u, static_cast<uint32_t>(ratio * static_cast<float>(setCount)));
+    }
+
+    VkDescriptorPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    createInfo.flags = flags;
+    createInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+    createInfo.pPoolSizes = poolSizes.data();
+    createInfo.maxSets = setCount;
+
+    return vkCreateDescriptorPool(getLogicalDev(), &createInfo, nullptr, &pool);
+}
+
+VkResult DescriptorAllocator::grabPool(uint32_t const& minSetCount)
+{
+    auto it = std::find_if(freePools.begin(), freePools.end(),
+                           [&minSetCount](auto const& freePool) { return freePool.second >= minSetCount; });
+    if (it != freePools.end())
+    {
+        usedPools.push_back(*it);
+        currentPool = it->first;
+        freePools.erase(it);
+        return VK_SUCCESS;
+    }
+
+    uint32_t setCount = std::max(setsPerPool, minSetCount);
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    VkResult ret = createPool(setCount, pool);
+    if (ret != VK_SUCCESS)
+    {
+        return ret;
+    }
+
+    usedPools.emplace_back(pool, setCount);
+    currentPool = pool;
+
+    // the next pool in the chain will be bigger
+    setsPerPool = std::min(setsPerPool * 2, MAX_SETS_PER_POOL);
+    return VK_SUCCESS;
+}
+
+VkResult DescriptorAllocator::allocate(VkDescriptorSetLayout const& layout, VkDescriptorSet& set)
+{
+    std::vector<VkDescriptorSet> sets;
+    VkResult ret = allocate(std::vector<VkDescriptorSetLayout> { layout }, sets);
+    if (ret == VK_SUCCESS)
+    {
+        set = sets[0];
+    }
+    return ret;
+}
+
+VkResult DescriptorAllocator::allocate(
+        std::vector<VkDescriptorSetLayout> const& layouts, std::vector<VkDescriptorSet>& sets)
+{
+    auto const setCount = static_cast<uint32_t>(layouts.size());
+    if (currentPool == VK_NULL_HANDLE)
+    {
+        VkResult poolRet = grabPool(setCount);
+        if (poolRet != VK_SUCCESS)
+        {
+            return poolRet;
+        }
+    }
+
+    VkDescriptorSetAllocateInfo allocInfo = {};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = currentPool;
+    allocInfo.descriptorSetCount = setCount;
+    allocInfo.pSetLayouts = layouts.data();
+
+    sets.resize(setCount);
+    VkResult ret = vkAllocateDescriptorSets(getLogicalDev(), &allocInfo, sets.data());
+
+    if (ret == VK_ERROR_OUT_OF_POOL_MEMORY || ret == VK_ERROR_FRAGMENTED_POOL)
+    {
+        // current pool is exhausted; move on to the next one in the chain
+        VkResult poolRet = grabPool(setCount);
+        if (poolRet != VK_SUCCESS)
+        {
+            return poolRet;
+        }
+
+        allocInfo.descriptorPool = currentPool;
+        ret = vkAllocateDescriptorSets(getLogicalDev(), &allocInfo, sets.data());
+    }
+
+    return ret;
+}
+
+void DescriptorAllocator::reset()
+{
+    if (not initialized())
+    {
+        return;
+    }
+
+    for (auto const& usedPool : usedPools)
+    {
+        vkResetDescriptorPool(getLogicalDev(), usedPool.first, 0);
+        freePools.push_back(usedPool);
+    }
+    usedPools.clear();
+    currentPool = VK_NULL_HANDLE;
+}
+
+size_t DescriptorAllocator::poolCount() const
+{
+    return usedPools.size() + freePools.size();
+}
+
+FrameDescriptorAllocator::FrameDescriptorAllocator(
+        VkDevice* logicalDev, std::vector<DescriptorAllocator::PoolSizeRatio> const& poolRatios)
+{
+    for (auto& frameAllocator : frameAllocators)
+    {
+        frameAllocator = DescriptorAllocator(logicalDev, poolRatios);
+    }
+}
+
+void FrameDescriptorAllocator::beginFrame(uint32_t const& frameIdx)
+{
+    currentFrame = frameIdx;
+    frameAllocators[currentFrame].reset();
+}
+
+VkResult FrameDescriptorAllocator::allocate(VkDescriptorSetLayout const& layout, VkDescriptorSet& set)
+{
+    return frameAllocators[currentFrame].allocate(layout, set);
+}
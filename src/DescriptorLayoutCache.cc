@@ -0,0 +1,123 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DescriptorLayoutCache.h"
+#include <boost/functional/hash.hpp>
+
+DescriptorLayoutCache::DescriptorLayoutCache(VkDevice* logicalDev) : AVkGraphicsBase(logicalDev)
+{
+}
+
+DescriptorLayoutCache::DescriptorLayoutCache(DescriptorLayoutCache&& cache) noexcept :
+        AVkGraphicsBase(std::move(cache)), layouts(std::move(cache.layouts))
+{
+    cache.layouts.clear();
+}
+
+DescriptorLayoutCache& DescriptorLayoutCache::operator=(DescriptorLayoutCache&& cache) noexcept
+{
+    dispose();
+    layouts = std::move(cache.layouts);
+    cache.layouts.clear();
+
+    AVkGraphicsBase::operator=(std::move(cache));
+    return *this;
+}
+
+DescriptorLayoutCache::~DescriptorLayoutCache()
+{
+    dispose();
+}
+
+void DescriptorLayoutCache::dispose()
+{
+    if (initialized())
+    {
+        for (auto const& [key, layout] : layouts)
+        {
+            vkDestroyDescriptorSetLayout(getLogicalDev(), layout, nullptr);
+        }
+        layouts.clear();
+    }
+}
+
+VkDescriptorSetLayout DescriptorLayoutCache::getLayout(
+        std::vector<VkDescriptorSetLayoutBinding> const& bindings,
+        VkDescriptorSetLayoutCreateFlags const& flags)
+{
+    // the key does not own sampler arrays, so they cannot be compared later on
+    if (std::any_of(bindings.begin(), bindings.end(),
+                    [](VkDescriptorSetLayoutBinding const& binding) { return binding.pImmutableSamplers != nullptr; }))
+    {
+        throw std::runtime_error("Cannot cache layouts with immutable samplers!");
+    }
+
+    LayoutKey key = { bindings, flags };
+    std::sort(key.bindings.begin(), key.bindings.end(),
+              [](VkDescriptorSetLayoutBinding const& a, VkDescriptorSetLayoutBinding const& b)
+              {
+                  return a.binding < b.binding;
+              });
+
+    auto it = layouts.find(key);
+    if (it != layouts.end())
+    {
+        return it->second;
+    }
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.flags = flags;
+    layoutInfo.bindingCount = static_cast<uint32_t>(key.bindings.size());
+    layoutInfo.pBindings = key.bindings.data();
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+    CHECK_VK_SUCCESS(
+            vkCreateDescriptorSetLayout(getLogicalDev(), &layoutInfo, nullptr, &layout),
+            "Cannot create descriptor set layout!");
+
+    layouts.emplace(std::move(key), layout);
+    return layout;
+}
+
+size_t DescriptorLayoutCache::size() const
+{
+    return layouts.size();
+}
+
+bool DescriptorLayoutCache::LayoutKey::operator==(LayoutKey const& other) const
+{
+    if (flags != other.flags || bindings.size() != other.bindings.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < bindings.size(); ++i)
+    {
+        auto const& a = bindings[i];
+        auto const& b = other.bindings[i];
+        if (a.binding != b.binding ||
+            a.descriptorType != b.descriptorType ||
+            a.descriptorCount != b.descriptorCount ||
+            a.stageFlags != b.stageFlags)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t DescriptorLayoutCache::LayoutKeyHash::operator()(LayoutKey const& key) const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, key.flags);
+    for (auto const& binding : key.bindings)
+    {
+        boost::hash_combine(seed, binding.binding);
+        boost::hash_combine(seed, static_cast<uint32_t>(binding.descriptorType));
+        boost::hash_combine(seed, binding.descriptorCount);
+        boost::hash_combine(seed, binding.stageFlags);
+    }
+    return seed;
+}
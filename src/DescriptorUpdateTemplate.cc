@@ -0,0 +1,69 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DescriptorUpdateTemplate.h"
+
+DescriptorUpdateTemplate::DescriptorUpdateTemplate(
+        VkDevice* logicalDev,
+        VkDescriptorSetLayout const& layout,
+        std::vector<VkDescriptorUpdateTemplateEntry> const& entries) : AVkGraphicsBase(logicalDev)
+{
+    VkDescriptorUpdateTemplateCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+    createInfo.descriptorUpdateEntryCount = static_cast<uint32_t>(entries.size());
+    createInfo.pDescriptorUpdateEntries = entries.data();
+    createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET;
+    createInfo.descriptorSetLayout = layout;
+
+    CHECK_VK_SUCCESS(
+            vkCreateDescriptorUpdateTemplate(*logicalDev, &createInfo, nullptr, &updateTemplate),
+            "Cannot create descriptor update template!");
+}
+
+DescriptorUpdateTemplate::DescriptorUpdateTemplate(DescriptorUpdateTemplate&& updTemplate) noexcept :
+        AVkGraphicsBase(std::move(updTemplate)), updateTemplate(updTemplate.updateTemplate)
+{
+    updTemplate.updateTemplate = VK_NULL_HANDLE;
+}
+
+DescriptorUpdateTemplate& DescriptorUpdateTemplate::operator=(DescriptorUpdateTemplate&& updTemplate) noexcept
+{
+    dispose();
+    updateTemplate = updTemplate.updateTemplate;
+    updTemplate.updateTemplate = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(updTemplate));
+    return *this;
+}
+
+DescriptorUpdateTemplate::~DescriptorUpdateTemplate()
+{
+    dispose();
+}
+
+void DescriptorUpdateTemplate::dispose()
+{
+    if (initialized())
+    {
+        vkDestroyDescriptorUpdateTemplate(getLogicalDev(), updateTemplate, nullptr);
+        updateTemplate = VK_NULL_HANDLE;
+    }
+}
+
+VkDescriptorUpdateTemplateEntry DescriptorUpdateTemplate::entry(
+        uint32_t const& binding,
+        VkDescriptorType const& descriptorType,
+        size_t const& offset,
+        uint32_t const& descriptorCount,
+        size_t const& stride)
+{
+    VkDescriptorUpdateTemplateEntry templateEntry = {};
+    templateEntry.dstBinding = binding;
+    templateEntry.dstArrayElement = 0;
+    templateEntry.descriptorCount = descriptorCount;
+    templateEntry.descriptorType = descriptorType;
+    templateEntry.offset = offset;
+    templateEntry.stride = stride;
+    return templateEntry;
+}
@@ -51,6 +51,24 @@ VkResult DisposableCmdBuffer::submit(VkQueue& queue)
     return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
 }
 
+VkResult DisposableCmdBuffer::submit(VkQueue& queue, VkSemaphore timeline, uint64_t const& signalValue)
+{
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &signalValue;
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &cmdBuffer;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &timeline;
+
+    return vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+}
+
 void DisposableCmdBuffer::finish()
 {
     if (initialized() && !disposed)
@@ -0,0 +1,58 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DrawAddressTable.h"
+
+VkPushConstantRange DrawAddressPushConstant::pushConstantRange()
+{
+    VkPushConstantRange range = {};
+    range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    range.offset = 0;
+    range.size = sizeof(DrawAddressPushConstant);
+    return range;
+}
+
+DrawAddressTable::DrawAddressTable(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice const& physDev) :
+        recordBuffer(
+                logicalDev, allocator, physDev,
+                sizeof(MeshUniform) * MAX_DRAWS * MAX_FRAMES_IN_FLIGHT,
+                VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+                VMA_MEMORY_USAGE_CPU_TO_GPU,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)
+{
+    baseAddress = recordBuffer.deviceAddress();
+}
+
+bool DrawAddressTable::supported(VkPhysicalDeviceVulkan12Features const& features)
+{
+    return features.bufferDeviceAddress == VK_TRUE;
+}
+
+VkDeviceSize DrawAddressTable::frameOffset(uint32_t const& frameIdx) const
+{
+    return static_cast<VkDeviceSize>(frameIdx) * MAX_DRAWS * sizeof(MeshUniform);
+}
+
+VkResult DrawAddressTable::setRecords(uint32_t const& frameIdx, std::vector<MeshUniform> const& records)
+{
+    if (records.size() > MAX_DRAWS)
+    {
+        throw std::runtime_error("Too many draw records!");
+    }
+    if (records.empty())
+    {
+        return VK_SUCCESS;
+    }
+
+    // the buffer stays mapped after the first write
+    return recordBuffer.loadData(
+            records.data(),
+            static_cast<uint32_t>(frameOffset(frameIdx)),
+            static_cast<uint32_t>(records.size() * sizeof(MeshUniform)));
+}
+
+VkDeviceAddress DrawAddressTable::recordAddress(uint32_t const& frameIdx, uint32_t const& drawIdx) const
+{
+    return baseAddress + frameOffset(frameIdx) + static_cast<VkDeviceSize>(drawIdx) * sizeof(MeshUniform);
+}
@@ -0,0 +1,65 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DrawKey.h"
+
+namespace
+{
+    constexpr uint64_t fieldMask(uint32_t const& bits)
+    {
+        return (uint64_t(1) << bits) - 1;
+    }
+}
+
+uint64_t DrawKey::make(uint32_t const& pipeline, uint32_t const& mesh, uint32_t const& material, float const& depth)
+{
+    auto depthBucket = static_cast<uint64_t>(
+            glm::clamp(depth, 0.f, 1.f) * static_cast<float>(fieldMask(DEPTH_BITS)));
+
+    uint64_t key = pipeline & fieldMask(PIPELINE_BITS);
+    key = (key << MESH_BITS) | (mesh & fieldMask(MESH_BITS));
+    key = (key << MATERIAL_BITS) | (material & fieldMask(MATERIAL_BITS));
+    key = (key << DEPTH_BITS) | depthBucket;
+    return key;
+}
+
+void DrawSorter::sort(std::vector<DrawSortEntry>& entries)
+{
+    // one read pass builds the histograms of every byte
+    std::array<std::array<uint32_t, RADIX_SIZE>, PASS_COUNT> histograms = {};
+    for (auto const& entry : entries)
+    {
+        for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+        {
+            ++histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1)];
+        }
+    }
+
+    scratch.resize(entries.size());
+    for (uint32_t pass = 0; pass < PASS_COUNT; ++pass)
+    {
+        auto& histogram = histograms[pass];
+        uint32_t const shift = pass * RADIX_BITS;
+        if (entries.empty() ||
+            histogram[(entries[0].key >> shift) & (RADIX_SIZE - 1)] == entries.size())
+        {
+            continue;
+        }
+
+        // exclusive prefix sum turns counts into scatter offsets
+        uint32_t offset = 0;
+        for (auto& count : histogram)
+        {
+            uint32_t bucketCount = count;
+            count = offset;
+            offset += bucketCount;
+        }
+
+        for (auto const& entry : entries)
+        {
+            scratch[histogram[(entry.key >> shift) & (RADIX_SIZE - 1)]++] = entry;
+        }
+        entries.swap(scratch);
+    }
+}
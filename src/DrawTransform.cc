@@ -0,0 +1,14 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DrawTransform.h"
+
+VkPushConstantRange DrawTransformPushConstant::pushConstantRange()
+{
+    VkPushConstantRange range = {};
+    range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    range.offset = 0;
+    range.size = sizeof(DrawTransformPushConstant);
+    return range;
+}
@@ -4,9 +4,8 @@
 #include "FrameSemaphores.h"
 
 constexpr char const* CREATE_SEMAPHORE_FAILED = "Cannot create Semaphore!";
-constexpr char const* CREATE_FENCE_FAILED = "Cannot create Fence!";
 
-FrameSemaphores::FrameSemaphores(VkDevice* logicalDev, VkFenceCreateFlags const& fenceFlags) :
+FrameSemaphores::FrameSemaphores(VkDevice* logicalDev) :
         AVkGraphicsBase(logicalDev)
 {
     VkSemaphoreCreateInfo createInfo = {};
@@ -18,14 +17,6 @@ FrameSemaphores::FrameSemaphores(VkDevice* logicalDev, VkFenceCreateFlags const&
     CHECK_VK_SUCCESS(
             vkCreateSemaphore(*logicalDev, &createInfo, nullptr, &renderFinished),
             CREATE_SEMAPHORE_FAILED);
-
-    VkFenceCreateInfo fenceCreateInfo = {};
-    fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-    fenceCreateInfo.flags = fenceFlags;
-
-    CHECK_VK_SUCCESS(
-            vkCreateFence(*logicalDev, &fenceCreateInfo, nullptr, &inFlight),
-            CREATE_FENCE_FAILED);
 }
 
 FrameSemaphores::FrameSemaphores(FrameSemaphores&& frameSem) noexcept:
@@ -33,11 +24,10 @@ FrameSemaphores::FrameSemaphores(FrameSemaphores&& frameSem) noexcept:
 {
     imgAvailable = frameSem.imgAvailable;
     renderFinished = frameSem.renderFinished;
-    inFlight = frameSem.inFlight;
+    timelineValue = frameSem.timelineValue;
 
     frameSem.imgAvailable = VK_NULL_HANDLE;
     frameSem.renderFinished = VK_NULL_HANDLE;
-    frameSem.inFlight = VK_NULL_HANDLE;
 }
 
 FrameSemaphores& FrameSemaphores::operator=(FrameSemaphores&& frameSem) noexcept
@@ -45,10 +35,10 @@ FrameSemaphores& FrameSemaphores::operator=(FrameSemaphores&& frameSem) noexcept
     AVkGraphicsBase::operator=(std::move(frameSem));
     imgAvailable = frameSem.imgAvailable;
     renderFinished = frameSem.renderFinished;
+    timelineValue = frameSem.timelineValue;
 
     frameSem.imgAvailable = VK_NULL_HANDLE;
     frameSem.renderFinished = VK_NULL_HANDLE;
-    frameSem.inFlight = VK_NULL_HANDLE;
 
     return *this;
 }
@@ -59,7 +49,6 @@ FrameSemaphores::~FrameSemaphores()
     {
         vkDestroySemaphore(getLogicalDev(), imgAvailable, nullptr);
         vkDestroySemaphore(getLogicalDev(), renderFinished, nullptr);
-        vkDestroyFence(getLogicalDev(), inFlight, nullptr);
     }
 }
 
@@ -0,0 +1,113 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "FrameTimeline.h"
+
+FrameTimeline::FrameTimeline(VkDevice* logicalDev) : AVkGraphicsBase(logicalDev)
+{
+    VkSemaphoreTypeCreateInfo typeInfo = {};
+    typeInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    typeInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    createInfo.pNext = &typeInfo;
+
+    CHECK_VK_SUCCESS(
+            vkCreateSemaphore(*logicalDev, &createInfo, nullptr, &semaphore),
+            "Cannot create timeline semaphore!");
+}
+
+FrameTimeline::FrameTimeline(FrameTimeline&& timeline) noexcept :
+        AVkGraphicsBase(std::move(timeline)), semaphore(timeline.semaphore),
+        submittedValue(timeline.submittedValue), completedValue(timeline.completedValue.load())
+{
+    timeline.semaphore = VK_NULL_HANDLE;
+}
+
+FrameTimeline& FrameTimeline::operator=(FrameTimeline&& timeline) noexcept
+{
+    dispose();
+    semaphore = timeline.semaphore;
+    submittedValue = timeline.submittedValue;
+    completedValue.store(timeline.completedValue.load());
+    timeline.semaphore = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(timeline));
+    return *this;
+}
+
+FrameTimeline::~FrameTimeline()
+{
+    dispose();
+}
+
+void FrameTimeline::dispose()
+{
+    if (initialized() && semaphore != VK_NULL_HANDLE)
+    {
+        vkDestroySemaphore(getLogicalDev(), semaphore, nullptr);
+        semaphore = VK_NULL_HANDLE;
+    }
+}
+
+uint64_t FrameTimeline::advance()
+{
+    return ++submittedValue;
+}
+
+uint64_t FrameTimeline::lastValue() const
+{
+    return submittedValue;
+}
+
+uint64_t FrameTimeline::completed()
+{
+    uint64_t value = 0;
+    CHECK_VK_SUCCESS(
+            vkGetSemaphoreCounterValue(getLogicalDev(), semaphore, &value),
+            "Cannot read timeline semaphore!");
+    updateCompleted(value);
+    return completedValue.load(std::memory_order_acquire);
+}
+
+bool FrameTimeline::reached(uint64_t const& value)
+{
+    if (completedValue.load(std::memory_order_acquire) >= value)
+    {
+        return true;
+    }
+    return completed() >= value;
+}
+
+VkResult FrameTimeline::wait(uint64_t const& value, uint64_t const& timeout)
+{
+    if (completedValue.load(std::memory_order_acquire) >= value)
+    {
+        return VK_SUCCESS;
+    }
+
+    VkSemaphoreWaitInfo waitInfo = {};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &value;
+
+    VkResult result = vkWaitSemaphores(getLogicalDev(), &waitInfo, timeout);
+    if (result == VK_SUCCESS)
+    {
+        updateCompleted(value);
+    }
+    return result;
+}
+
+void FrameTimeline::updateCompleted(uint64_t const& value)
+{
+    uint64_t current = completedValue.load(std::memory_order_relaxed);
+    while (current < value
+           && not completedValue.compare_exchange_weak(current, value, std::memory_order_acq_rel))
+    {
+    }
+}
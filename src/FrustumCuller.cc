@@ -0,0 +1,213 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "FrustumCuller.h"
+#include <bitset>
+
+#if defined(FRUSTUM_CULLER_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+#if defined(FRUSTUM_CULLER_AVX2)
+    inline __m256 madd(__m256 const& a, __m256 const& b, __m256 const& c)
+    {
+#if defined(__FMA__)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    inline uint32_t lowestBit(uint32_t const& mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long idx;
+        _BitScanForward(&idx, mask);
+        return static_cast<uint32_t>(idx);
+#else
+        return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+    }
+
+    inline uint32_t bitCount(uint32_t const& mask)
+    {
+        return static_cast<uint32_t>(std::bitset<32>(mask).count());
+    }
+#endif
+}
+
+Frustum Frustum::fromViewProj(glm::mat4 const& viewProj)
+{
+    // glm is column-major; rows of the clip transform, for planes in world space
+    auto row = [&viewProj](int i)
+    {
+        return glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+    };
+
+    // clip space is -w <= x, y <= w and 0 <= z <= w
+    Frustum frustum = {};
+    frustum.planes[0] = row(3) + row(0);
+    frustum.planes[1] = row(3) - row(0);
+    frustum.planes[2] = row(3) + row(1);
+    frustum.planes[3] = row(3) - row(1);
+    frustum.planes[4] = row(2);
+    frustum.planes[5] = row(3) - row(2);
+
+    for (auto& plane : frustum.planes)
+    {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+void FrustumCuller::resize(size_t const& newCount)
+{
+    count = newCount;
+    size_t padded = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    centerX.resize(padded, 0.f);
+    centerY.resize(padded, 0.f);
+    centerZ.resize(padded, 0.f);
+    radius.resize(padded, 0.f);
+}
+
+void FrustumCuller::setBounds(size_t const& idx, glm::vec4 const& sphere)
+{
+    centerX[idx] = sphere.x;
+    centerY[idx] = sphere.y;
+    centerZ[idx] = sphere.z;
+    radius[idx] = sphere.w;
+}
+
+CullStats FrustumCuller::cull(
+        Frustum const& frustum,
+        glm::vec3 const& cameraPos,
+        float const& pixelsPerUnit,
+        float const& minPixels,
+        std::vector<uint32_t>& visible) const
+{
+#if defined(FRUSTUM_CULLER_AVX2)
+    return cullAvx2(frustum, cameraPos, pixelsPerUnit, minPixels, visible);
+#else
+    return cullScalar(frustum, cameraPos, pixelsPerUnit, minPixels, visible);
+#endif
+}
+
+CullStats FrustumCuller::cullScalar(
+        Frustum const& frustum,
+        glm::vec3 const& cameraPos,
+        float const& pixelsPerUnit,
+        float const& minPixels,
+        std::vector<uint32_t>& visible) const
+{
+    // small-object test without square roots: the projected diameter 2r * pixelsPerUnit / dist
+    // is below minPixels when (2r * pixelsPerUnit)^2 < minPixels^2 * dist^2
+    float const sizeScale = 4.f * pixelsPerUnit * pixelsPerUnit;
+    float const minPixels2 = minPixels * minPixels;
+
+    CullStats stats;
+    visible.clear();
+    visible.reserve(count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        glm::vec3 center(centerX[i], centerY[i], centerZ[i]);
+        bool inside = std::all_of(
+                std::begin(frustum.planes), std::end(frustum.planes),
+                [&center, r = radius[i]](glm::vec4 const& plane)
+                {
+                    return glm::dot(glm::vec3(plane), center) + plane.w >= -r;
+                });
+        if (not inside)
+        {
+            ++stats.frustumCulled;
+            continue;
+        }
+
+        glm::vec3 diff = center - cameraPos;
+        if (radius[i] * radius[i] * sizeScale < glm::dot(diff, diff) * minPixels2)
+        {
+            ++stats.smallCulled;
+            continue;
+        }
+        visible.push_back(static_cast<uint32_t>(i));
+    }
+
+    stats.visible = static_cast<uint32_t>(visible.size());
+    return stats;
+}
+
+#if defined(FRUSTUM_CULLER_AVX2)
+CullStats FrustumCuller::cullAvx2(
+        Frustum const& frustum,
+        glm::vec3 const& cameraPos,
+        float const& pixelsPerUnit,
+        float const& minPixels,
+        std::vector<uint32_t>& visible) const
+{
+    // the same tests as cullScalar, eight spheres at a time
+    float const sizeScale = 4.f * pixelsPerUnit * pixelsPerUnit;
+    float const minPixels2 = minPixels * minPixels;
+
+    CullStats stats;
+    visible.clear();
+    visible.reserve(count);
+
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; ++p)
+    {
+        planeX[p] = _mm256_set1_ps(frustum.planes[p].x);
+        planeY[p] = _mm256_set1_ps(frustum.planes[p].y);
+        planeZ[p] = _mm256_set1_ps(frustum.planes[p].z);
+        planeW[p] = _mm256_set1_ps(frustum.planes[p].w);
+    }
+    __m256 const camX = _mm256_set1_ps(cameraPos.x);
+    __m256 const camY = _mm256_set1_ps(cameraPos.y);
+    __m256 const camZ = _mm256_set1_ps(cameraPos.z);
+    __m256 const sizeScale8 = _mm256_set1_ps(sizeScale);
+    __m256 const minPixels8 = _mm256_set1_ps(minPixels2);
+    __m256 const zero = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < count; i += SIMD_WIDTH)
+    {
+        __m256 cx = _mm256_loadu_ps(centerX.data() + i);
+        __m256 cy = _mm256_loadu_ps(centerY.data() + i);
+        __m256 cz = _mm256_loadu_ps(centerZ.data() + i);
+        __m256 r = _mm256_loadu_ps(radius.data() + i);
+        __m256 negR = _mm256_sub_ps(zero, r);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p)
+        {
+            __m256 dist = madd(planeX[p], cx, madd(planeY[p], cy, madd(planeZ[p], cz, planeW[p])));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(dist, negR, _CMP_GE_OQ));
+        }
+
+        __m256 dx = _mm256_sub_ps(cx, camX);
+        __m256 dy = _mm256_sub_ps(cy, camY);
+        __m256 dz = _mm256_sub_ps(cz, camZ);
+        __m256 dist2 = madd(dx, dx, madd(dy, dy, _mm256_mul_ps(dz, dz)));
+        __m256 size2 = _mm256_mul_ps(_mm256_mul_ps(r, r), sizeScale8);
+        __m256 large = _mm256_cmp_ps(size2, _mm256_mul_ps(dist2, minPixels8), _CMP_GE_OQ);
+
+        // lanes past the end are padding
+        size_t lanes = std::min(SIMD_WIDTH, count - i);
+        uint32_t validMask = (1u << lanes) - 1;
+        auto insideMask = static_cast<uint32_t>(_mm256_movemask_ps(inside)) & validMask;
+        uint32_t visibleMask = insideMask & static_cast<uint32_t>(_mm256_movemask_ps(large));
+
+        stats.frustumCulled += bitCount(validMask & ~insideMask);
+        stats.smallCulled += bitCount(insideMask & ~visibleMask);
+        while (visibleMask != 0)
+        {
+            visible.push_back(static_cast<uint32_t>(i) + lowestBit(visibleMask));
+            visibleMask &= visibleMask - 1;
+        }
+    }
+
+    stats.visible = static_cast<uint32_t>(visible.size());
+    return stats;
+}
+#endif
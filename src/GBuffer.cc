@@ -0,0 +1,105 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "GBuffer.h"
+
+namespace
+{
+    bool hasLazilyAllocatedMemory(VkPhysicalDevice const& physDev)
+    {
+        VkPhysicalDeviceMemoryProperties memProperties = {};
+        vkGetPhysicalDeviceMemoryProperties(physDev, &memProperties);
+        for (uint32_t i = 0; i < memProperties.memoryTypeCount; ++i)
+        {
+            if (memProperties.memoryTypes[i].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+GBuffer::GBuffer(
+        VkDevice* logicalDev,
+        VmaAllocator* allocator,
+        VkPhysicalDevice const& physDev,
+        std::pair<uint32_t, uint32_t> const& size,
+        VkImageView const& depthView,
+        DescriptorLayoutCache& layoutCache) :
+        logicalDev(logicalDev), depthView(depthView)
+{
+    // desktop GPUs have no lazily allocated memory and simply keep the attachments in VRAM
+    VkMemoryPropertyFlags memoryFlags = hasLazilyAllocatedMemory(physDev) ?
+            VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+    for (uint32_t i = 0; i < COLOR_ATTACHMENT_COUNT; ++i)
+    {
+        attachments[i] = Image::Image(
+                logicalDev, allocator, size,
+                FORMATS[i],
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT |
+                VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT,
+                memoryFlags,
+                nullopt);
+    }
+
+    descriptorSetLayout = layoutCache.getLayout(layoutBindings());
+}
+
+VkResult GBuffer::allocateLightingSet(FrameDescriptorAllocator& frameDescriptors, VkDescriptorSet& set) const
+{
+    VkResult result = frameDescriptors.allocate(descriptorSetLayout, set);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    std::array<VkDescriptorImageInfo, COLOR_ATTACHMENT_COUNT + 1> imageInfos = {};
+    std::array<VkWriteDescriptorSet, COLOR_ATTACHMENT_COUNT + 1> writes = {};
+    for (uint32_t i = 0; i < writes.size(); ++i)
+    {
+        // layouts the lighting subpass reads them in; see SwapchainComponents::createRenderPass
+        imageInfos[i].imageView = i == DEPTH_BINDING ? depthView : attachments[i].imgView;
+        imageInfos[i].imageLayout = i == DEPTH_BINDING ?
+                VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = set;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        writes[i].pImageInfo = &imageInfos[i];
+    }
+    vkUpdateDescriptorSets(*logicalDev, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    return VK_SUCCESS;
+}
+
+std::vector<VkImageView> GBuffer::attachmentViews() const
+{
+    std::vector<VkImageView> views;
+    views.reserve(COLOR_ATTACHMENT_COUNT);
+    for (auto const& attachment : attachments)
+    {
+        views.push_back(attachment.imgView);
+    }
+    return views;
+}
+
+std::vector<VkDescriptorSetLayoutBinding> GBuffer::layoutBindings()
+{
+    std::vector<VkDescriptorSetLayoutBinding> bindings(COLOR_ATTACHMENT_COUNT + 1);
+    for (uint32_t i = 0; i < bindings.size(); ++i)
+    {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    }
+    return bindings;
+}
+
+std::vector<DescriptorAllocator::PoolSizeRatio> GBuffer::poolRatios()
+{
+    return {{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, COLOR_ATTACHMENT_COUNT + 1.f }};
+}
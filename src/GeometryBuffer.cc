@@ -0,0 +1,107 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "GeometryBuffer.h"
+
+GeometryBuffer::GeometryBuffer(
+        VkDevice* logicalDev,
+        VmaAllocator* allocator,
+        VkPhysicalDevice const& physDev,
+        std::vector<Mesh const*> meshes) :
+        logicalDev(logicalDev), allocator(allocator), physDev(physDev), meshes(std::move(meshes))
+{
+    if (not this->meshes.empty())
+    {
+        layout = this->meshes.front()->vertexLayout();
+    }
+    for (auto const* mesh : this->meshes)
+    {
+        if (mesh->vertexLayout() != layout)
+        {
+            throw std::runtime_error("Meshes of a geometry buffer must share their vertex layout!");
+        }
+
+        MeshRange& range = ranges.emplace_back();
+        range.indexCount = static_cast<uint32_t>(mesh->idxCount());
+        range.firstIndex = static_cast<uint32_t>(indexCount);
+        range.vertexOffset = static_cast<int32_t>(vertexCount);
+        range.boundingSphere = mesh->boundingSphere();
+
+        vertexCount += mesh->vertices().size();
+        indexCount += mesh->idxCount();
+    }
+
+    buf = Buffers::Buffer(
+            logicalDev, allocator, physDev, idxOffset() + indexCount * sizeof(uint32_t),
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VMA_MEMORY_USAGE_GPU_ONLY,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+size_t GeometryBuffer::idxOffset() const
+{
+    return vertexCount * sizeof(NVertex);
+}
+
+VertexStreams GeometryBuffer::vertexStreams() const
+{
+    return VertexStreams::of(layout, vertexCount);
+}
+
+std::shared_ptr<Buffers::StagingBuffer> GeometryBuffer::stagingBuffer(std::set<uint32_t> const& transferQueues)
+{
+    auto stg_ptr = std::make_shared<Buffers::StagingBuffer>(
+            logicalDev, allocator, physDev, buf.getSize(),
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            transferQueues);
+
+    // indices stay relative to their mesh; draws add vertexOffset
+    VertexStreams streams = vertexStreams();
+    std::vector<std::tuple<void const*, size_t, size_t>> regions;
+    // split streams are built for the upload only, and must outlive loadData
+    std::vector<std::vector<glm::vec3>> positionStreams(meshes.size());
+    std::vector<std::vector<VertexAttributes>> attributeStreams(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+    {
+        auto const& verts = meshes[i]->vertices();
+        auto const& indices = meshes[i]->vertexIndices();
+        if (layout == VERTEX_LAYOUT_SPLIT_POSITIONS)
+        {
+            auto const& positions = positionStreams[i] = meshes[i]->positionStream();
+            auto const& attributes = attributeStreams[i] = meshes[i]->attributeStream();
+            regions.emplace_back(
+                    positions.data(), streams.offsets[0] + ranges[i].vertexOffset * sizeof(glm::vec3),
+                    positions.size() * sizeof(glm::vec3));
+            regions.emplace_back(
+                    attributes.data(), streams.offsets[1] + ranges[i].vertexOffset * sizeof(VertexAttributes),
+                    attributes.size() * sizeof(VertexAttributes));
+        }
+        else
+        {
+            regions.emplace_back(
+                    verts.data(), ranges[i].vertexOffset * sizeof(NVertex), verts.size() * sizeof(NVertex));
+        }
+        regions.emplace_back(
+                indices.data(), idxOffset() + ranges[i].firstIndex * sizeof(uint32_t),
+                indices.size() * sizeof(uint32_t));
+    }
+
+    stg_ptr->loadData(regions);
+    return stg_ptr;
+}
+
+uint32_t GeometryBuffer::meshIndex(Mesh const* mesh) const
+{
+    auto it = std::find(meshes.begin(), meshes.end(), mesh);
+    if (it == meshes.end())
+    {
+        throw std::runtime_error("Mesh is not part of the geometry buffer!");
+    }
+    return static_cast<uint32_t>(it - meshes.begin());
+}
+
+std::vector<MeshRange> const& GeometryBuffer::meshRanges() const
+{
+    return ranges;
+}
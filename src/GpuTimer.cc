@@ -0,0 +1,117 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "GpuTimer.h"
+
+GpuTimer::GpuTimer(VkDevice* logicalDev, VkPhysicalDevice const& physDev, uint32_t const& queueFamily) :
+        AVkGraphicsBase(logicalDev)
+{
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physDev, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physDev, &familyCount, families.data());
+
+    uint32_t validBits = queueFamily < familyCount ? families[queueFamily].timestampValidBits : 0;
+    if (validBits == 0)
+    {
+        return;
+    }
+    timestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physDev, &properties);
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    createInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    createInfo.queryCount = 2 * MAX_FRAMES_IN_FLIGHT;
+
+    CHECK_VK_SUCCESS(
+            vkCreateQueryPool(*logicalDev, &createInfo, nullptr, &queryPool),
+            "Cannot create query pool!");
+}
+
+GpuTimer::GpuTimer(GpuTimer&& gpuTimer) noexcept :
+        AVkGraphicsBase(std::move(gpuTimer)), queryPool(gpuTimer.queryPool),
+        timestampPeriod(gpuTimer.timestampPeriod), timestampMask(gpuTimer.timestampMask),
+        written(gpuTimer.written)
+{
+    gpuTimer.queryPool = VK_NULL_HANDLE;
+}
+
+GpuTimer& GpuTimer::operator=(GpuTimer&& gpuTimer) noexcept
+{
+    dispose();
+    queryPool = gpuTimer.queryPool;
+    timestampPeriod = gpuTimer.timestampPeriod;
+    timestampMask = gpuTimer.timestampMask;
+    written = gpuTimer.written;
+    gpuTimer.queryPool = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(gpuTimer));
+    return *this;
+}
+
+GpuTimer::~GpuTimer()
+{
+    dispose();
+}
+
+void GpuTimer::dispose()
+{
+    if (initialized() && queryPool != VK_NULL_HANDLE)
+    {
+        vkDestroyQueryPool(getLogicalDev(), queryPool, nullptr);
+        queryPool = VK_NULL_HANDLE;
+    }
+}
+
+bool GpuTimer::supported() const
+{
+    return queryPool != VK_NULL_HANDLE;
+}
+
+std::optional<double> GpuTimer::read(uint32_t const& frameIdx)
+{
+    if (not supported() or not written[frameIdx])
+    {
+        return nullopt;
+    }
+    written[frameIdx] = false;
+
+    // value and availability of each query
+    std::array<uint64_t, 4> results = {};
+    VkResult ret = vkGetQueryPoolResults(
+            getLogicalDev(), queryPool, 2 * frameIdx, 2,
+            sizeof(results), results.data(), 2 * sizeof(uint64_t),
+            VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+    if (ret != VK_SUCCESS or results[1] == 0 or results[3] == 0)
+    {
+        return nullopt;
+    }
+
+    uint64_t ticks = (results[2] - results[0]) & timestampMask;
+    return static_cast<double>(ticks) * timestampPeriod / 1e6;
+}
+
+void GpuTimer::cmdBegin(VkCommandBuffer const& cmdBuf, uint32_t const& frameIdx)
+{
+    if (not supported())
+    {
+        return;
+    }
+    vkCmdResetQueryPool(cmdBuf, queryPool, 2 * frameIdx, 2);
+    vkCmdWriteTimestamp(cmdBuf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, 2 * frameIdx);
+}
+
+void GpuTimer::cmdEnd(VkCommandBuffer const& cmdBuf, uint32_t const& frameIdx)
+{
+    if (not supported())
+    {
+        return;
+    }
+    vkCmdWriteTimestamp(cmdBuf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, 2 * frameIdx + 1);
+    written[frameIdx] = true;
+}
@@ -3,91 +3,59 @@
 //
 
 #include "GraphicsPipeline.h"
-
-VkResult GraphicsPipeline::createGraphicsPipeline(
-        std::string const& vertShaderName,
-        std::string const& fragShaderName,
-        VkExtent2D const& extent,
-        VkRenderPass const& renderPass,
-        std::vector<VkDescriptorSetLayout> const& descriptorSetLayout,
-        bool enableDepthTest)
+#include <boost/functional/hash.hpp>
+
+PipelineFixedState::PipelineFixedState(
+        bool const& enableDepthTest,
+        DepthPrePass const& depthPrePass,
+        VertexLayout const& vertexLayout,
+        uint32_t const& colorAttachmentCount) :
+        depthTestEnabled(enableDepthTest),
+        // the pre-pass only fetches positions, attribute 0, and only binds their stream
+        vertexInputDesc(VertexInputDescription::of(vertexLayout, depthPrePass == DEPTH_PRE_PASS_WRITE))
 {
-    auto [vertShader, ret] = Shaders::createShaderModule(getLogicalDev(), vertShaderName);
-    auto [fragShader, ret2] = Shaders::createShaderModule(getLogicalDev(), fragShaderName);
-    if (ret != VK_SUCCESS or ret2 != VK_SUCCESS)
-    {
-        throw std::runtime_error("Cannot create shader");
-    }
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = static_cast<uint32_t>(vertexInputDesc.bindings.size());
+    vertexInput.pVertexBindingDescriptions = vertexInputDesc.bindings.data();
+    vertexInput.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInputDesc.attributes.size());
+    vertexInput.pVertexAttributeDescriptions = vertexInputDesc.attributes.data();
 
-    VkPipelineShaderStageCreateInfo vertShaderInfo = {};
-    vertShaderInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderInfo.module = vertShader;
-    vertShaderInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragShaderInfo = {};
-    fragShaderInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderInfo.module = fragShader;
-    fragShaderInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo stages[] = {vertShaderInfo, fragShaderInfo};
-
-    auto bindingDesc = Vertex::bindingDescription();
-    auto attribDesc = Vertex::attributeDescription();
-
-    VkPipelineVertexInputStateCreateInfo vertInputInfo = {};
-    vertInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertInputInfo.vertexBindingDescriptionCount = 1;
-    vertInputInfo.pVertexBindingDescriptions = &bindingDesc;
-    vertInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attribDesc.size());
-    vertInputInfo.pVertexAttributeDescriptions = attribDesc.data();
-
-    VkPipelineInputAssemblyStateCreateInfo inputAsmStateInfo = {};
-    inputAsmStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    inputAsmStateInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    inputAsmStateInfo.primitiveRestartEnable = VK_FALSE;
-
-    VkViewport viewport = {};
-    viewport.x = 0.0f;
-    viewport.y = 0.0f;
-    viewport.width = (float)extent.width;
-    viewport.height=(float)extent.height;
-    viewport.minDepth=0.0f;
-    viewport.maxDepth=1.0f;
-
-    VkRect2D scissor = {};
-    scissor.offset = {0,0};
-    scissor.extent = extent;
-    VkPipelineViewportStateCreateInfo viewportState = {};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    inputAssembly.primitiveRestartEnable = VK_FALSE;
+
+    // viewport and scissor are set when recording, so the pipeline outlives swapchain resizes
     viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewportState.viewportCount = 1;
-    viewportState.pViewports = &viewport;
+    viewportState.pViewports = nullptr;
     viewportState.scissorCount = 1;
-    viewportState.pScissors = &scissor;
-
-    VkPipelineRasterizationStateCreateInfo rasterizerCreateInfo = {};
-    rasterizerCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    rasterizerCreateInfo.depthClampEnable = VK_FALSE;
-    rasterizerCreateInfo.rasterizerDiscardEnable = VK_FALSE;
-    rasterizerCreateInfo.polygonMode = VK_POLYGON_MODE_FILL;
-    rasterizerCreateInfo.lineWidth = 1.0f;
-    rasterizerCreateInfo.cullMode = VK_CULL_MODE_BACK_BIT;
-    rasterizerCreateInfo.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-    rasterizerCreateInfo.depthBiasEnable = VK_FALSE;
-
-    rasterizerCreateInfo.depthBiasConstantFactor = 0.0f;
-    rasterizerCreateInfo.depthBiasClamp = 0.0f;
-    rasterizerCreateInfo.depthBiasSlopeFactor = 0.0f;
-
-    VkPipelineMultisampleStateCreateInfo multisampleInfo = {};
-    multisampleInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    multisampleInfo.sampleShadingEnable = VK_FALSE;
-    multisampleInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-    multisampleInfo.minSampleShading = 1.0f;
-    multisampleInfo.pSampleMask = nullptr;
-    multisampleInfo.alphaToCoverageEnable = VK_FALSE;
-    multisampleInfo.alphaToOneEnable = VK_FALSE;
+    viewportState.pScissors = nullptr;
+
+    dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStates.size());
+    dynamicState.pDynamicStates = dynamicStates.data();
+
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.depthClampEnable = VK_FALSE;
+    rasterizer.rasterizerDiscardEnable = VK_FALSE;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.lineWidth = 1.0f;
+    rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
+    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterizer.depthBiasEnable = VK_FALSE;
+
+    rasterizer.depthBiasConstantFactor = 0.0f;
+    rasterizer.depthBiasClamp = 0.0f;
+    rasterizer.depthBiasSlopeFactor = 0.0f;
+
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.sampleShadingEnable = VK_FALSE;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    multisample.minSampleShading = 1.0f;
+    multisample.pSampleMask = nullptr;
+    multisample.alphaToCoverageEnable = VK_FALSE;
+    multisample.alphaToOneEnable = VK_FALSE;
 
     VkPipelineColorBlendAttachmentState colorBlendAttachment = {};
     colorBlendAttachment.colorWriteMask =
@@ -95,6 +63,11 @@ VkResult GraphicsPipeline::createGraphicsPipeline(
             VK_COLOR_COMPONENT_G_BIT |
             VK_COLOR_COMPONENT_B_BIT |
             VK_COLOR_COMPONENT_A_BIT;
+    if (depthPrePass == DEPTH_PRE_PASS_WRITE)
+    {
+        // has no fragment shader, so there is nothing to write
+        colorBlendAttachment.colorWriteMask = 0;
+    }
 
     colorBlendAttachment.blendEnable = VK_FALSE;
     colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
@@ -103,32 +76,20 @@ VkResult GraphicsPipeline::createGraphicsPipeline(
     colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
     colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
     colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    colorBlendAttachments.assign(colorAttachmentCount, colorBlendAttachment);
 
-    VkPipelineColorBlendStateCreateInfo colorBlendCreateInfo = {};
-    colorBlendCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    colorBlendCreateInfo.logicOpEnable = VK_FALSE;
-    colorBlendCreateInfo.logicOp = VK_LOGIC_OP_COPY;
-    colorBlendCreateInfo.attachmentCount = 1;
-    colorBlendCreateInfo.pAttachments = &colorBlendAttachment;
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.logicOpEnable = VK_FALSE;
+    colorBlend.logicOp = VK_LOGIC_OP_COPY;
+    colorBlend.attachmentCount = colorAttachmentCount;
+    colorBlend.pAttachments = colorBlendAttachments.data();
 
-    for (float& blendConstant : colorBlendCreateInfo.blendConstants)
+    for (float& blendConstant : colorBlend.blendConstants)
     {
         blendConstant = 0.0f;
     }
 
-    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
-    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayout.size());
-    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayout.data();
-    pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-    pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
-
-    CHECK_VK_SUCCESS(vkCreatePipelineLayout(getLogicalDev(), &pipelineLayoutCreateInfo, nullptr, &pipelineLayout),
-                     "Cannot create pipeline layout!");
-
-    VkPipelineDepthStencilStateCreateInfo depthStencil {};
     depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-
     if (enableDepthTest)
     {
         depthStencil.depthTestEnable = VK_TRUE;
@@ -141,21 +102,119 @@ VkResult GraphicsPipeline::createGraphicsPipeline(
         depthStencil.stencilTestEnable = VK_FALSE;
         depthStencil.front = {};
         depthStencil.back = {};
+
+        if (depthPrePass == DEPTH_PRE_PASS_TEST)
+        {
+            // depth is final after the pre-pass. Both passes compute positions from the
+            // same shader source, but LESS_OR_EQUAL forgives a last-bit difference one way
+            depthStencil.depthWriteEnable = VK_FALSE;
+            depthStencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+        }
+    }
+}
+
+void PipelineFixedState::fill(VkGraphicsPipelineCreateInfo& createInfo) const
+{
+    createInfo.pVertexInputState = &vertexInput;
+    createInfo.pInputAssemblyState = &inputAssembly;
+    createInfo.pViewportState = &viewportState;
+    createInfo.pRasterizationState = &rasterizer;
+    createInfo.pMultisampleState = &multisample;
+    createInfo.pDepthStencilState = depthTestEnabled ? &depthStencil : nullptr;
+    createInfo.pColorBlendState = &colorBlend;
+    createInfo.pDynamicState = &dynamicState;
+}
+
+PipelineShaderStage::PipelineShaderStage(
+        VkDevice const& logicalDev,
+        VkShaderStageFlagBits const& stage,
+        std::string const& fileName,
+        std::vector<uint32_t> const& constants) :
+        logicalDev(logicalDev), constants(constants)
+{
+    auto [shader, ret] = Shaders::createShaderModule(logicalDev, fileName);
+    if (ret != VK_SUCCESS)
+    {
+        throw std::runtime_error("Cannot create shader");
     }
+    module = shader;
 
+    // constant i is constant_id i; stages ignore ids they do not declare
+    for (uint32_t i = 0; i < this->constants.size(); ++i)
+    {
+        specEntries.push_back({ i, static_cast<uint32_t>(i * sizeof(uint32_t)), sizeof(uint32_t) });
+    }
+    specInfo.mapEntryCount = static_cast<uint32_t>(specEntries.size());
+    specInfo.pMapEntries = specEntries.data();
+    specInfo.dataSize = this->constants.size() * sizeof(uint32_t);
+    specInfo.pData = this->constants.data();
+
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    info.stage = stage;
+    info.module = module;
+    info.pName = "main";
+    info.pSpecializationInfo = this->constants.empty() ? nullptr : &specInfo;
+}
+
+PipelineShaderStage::~PipelineShaderStage()
+{
+    vkDestroyShaderModule(logicalDev, module, nullptr);
+}
+
+bool PipelineVariant::operator==(PipelineVariant const& other) const
+{
+    return vertShader == other.vertShader && fragShader == other.fragShader && constants == other.constants;
+}
+
+size_t PipelineVariant::hash() const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, vertShader);
+    boost::hash_combine(seed, fragShader);
+    boost::hash_range(seed, constants.begin(), constants.end());
+    return seed;
+}
+
+VkResult GraphicsPipeline::createGraphicsPipeline(
+        VkPipelineCache const& pipelineCache,
+        std::string const& vertShaderName,
+        std::string const& fragShaderName,
+        VkRenderPass const& renderPass,
+        std::vector<VkDescriptorSetLayout> const& descriptorSetLayout,
+        bool enableDepthTest,
+        std::vector<VkPushConstantRange> const& pushConstantRanges,
+        DepthPrePass depthPrePass,
+        VertexLayout vertexLayout,
+        uint32_t colorAttachmentCount)
+{
+    // the depth pre-pass has no fragment shader
+    std::vector<VkPipelineShaderStageCreateInfo> stages;
+    PipelineShaderStage vertStage(getLogicalDev(), VK_SHADER_STAGE_VERTEX_BIT, vertShaderName);
+    stages.push_back(vertStage.info);
+    std::optional<PipelineShaderStage> fragStage;
+    if (not fragShaderName.empty())
+    {
+        fragStage.emplace(getLogicalDev(), VK_SHADER_STAGE_FRAGMENT_BIT, fragShaderName);
+        stages.push_back(fragStage->info);
+    }
+
+    PipelineFixedState fixedState(enableDepthTest, depthPrePass, vertexLayout, colorAttachmentCount);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = {};
+    pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutCreateInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayout.size());
+    pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayout.data();
+    pipelineLayoutCreateInfo.pushConstantRangeCount = static_cast<uint32_t>(pushConstantRanges.size());
+    pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
+
+    CHECK_VK_SUCCESS(vkCreatePipelineLayout(getLogicalDev(), &pipelineLayoutCreateInfo, nullptr, &pipelineLayout),
+                     "Cannot create pipeline layout!");
 
     VkGraphicsPipelineCreateInfo pipelineCreateInfo = {};
     pipelineCreateInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineCreateInfo.stageCount = 2;
-    pipelineCreateInfo.pStages = stages;
-    pipelineCreateInfo.pVertexInputState = &vertInputInfo;
-    pipelineCreateInfo.pInputAssemblyState = &inputAsmStateInfo;
-    pipelineCreateInfo.pViewportState = &viewportState;
-    pipelineCreateInfo.pRasterizationState = &rasterizerCreateInfo;
-    pipelineCreateInfo.pMultisampleState = &multisampleInfo;
-    pipelineCreateInfo.pDepthStencilState = enableDepthTest ? &depthStencil : nullptr;
-    pipelineCreateInfo.pColorBlendState = &colorBlendCreateInfo;
-    pipelineCreateInfo.pDynamicState = nullptr;
+    pipelineCreateInfo.stageCount = static_cast<uint32_t>(stages.size());
+    pipelineCreateInfo.pStages = stages.data();
+    fixedState.fill(pipelineCreateInfo);
 
     pipelineCreateInfo.layout = pipelineLayout;
     pipelineCreateInfo.renderPass = renderPass;
@@ -164,37 +223,41 @@ VkResult GraphicsPipeline::createGraphicsPipeline(
     pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     pipelineCreateInfo.basePipelineIndex = -1;
 
-    auto retFinal = vkCreateGraphicsPipelines(
-            getLogicalDev(), VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr,
+    return vkCreateGraphicsPipelines(
+            getLogicalDev(), pipelineCache, 1, &pipelineCreateInfo, nullptr,
             &pipeline);
-    vkDestroyShaderModule(getLogicalDev(), vertShader, nullptr);
-    vkDestroyShaderModule(getLogicalDev(), fragShader, nullptr);
-
-    return retFinal;
 }
 
 GraphicsPipeline::GraphicsPipeline(
         VkDevice* device,
         VkPhysicalDevice const& physDev,
         VkCommandPool* cmdPool,
+        VkPipelineCache const& pipelineCache,
         std::string const& vertShader,
         std::string const& fragShader,
-        VkExtent2D const& extent,
         size_t const& swpchainImgCount,
         VkRenderPass const& renderPass,
         std::vector<VkDescriptorSetLayout> const& descriptorSetLayout,
-        bool enableDepthTest) :
-        AVkGraphicsBase(device), cmdPool(cmdPool)
+        bool enableDepthTest,
+        std::vector<VkPushConstantRange> const& pushConstantRanges,
+        DepthPrePass depthPrePass,
+        VertexLayout vertexLayout,
+        uint32_t colorAttachmentCount) :
+        AVkGraphicsBase(device), pushConstantRanges(pushConstantRanges), cmdPool(cmdPool)
 {
     CHECK_VK_SUCCESS(
             createGraphicsPipeline(
-                    vertShader, fragShader, extent, renderPass, descriptorSetLayout,
-                    enableDepthTest),
+                    pipelineCache, vertShader, fragShader, renderPass, descriptorSetLayout,
+                    enableDepthTest, pushConstantRanges, depthPrePass, vertexLayout, colorAttachmentCount),
             ErrorMessages::CREATE_GRAPHICS_PIPELINE_FAILED);
 
-    CHECK_VK_SUCCESS(
-            createCmdBuffers(swpchainImgCount),
-            ErrorMessages::CREATE_COMMAND_BUFFERS_FAILED);
+    // pipelines recorded into another pipeline's command buffers ask for none
+    if (swpchainImgCount > 0)
+    {
+        CHECK_VK_SUCCESS(
+                createCmdBuffers(swpchainImgCount),
+                ErrorMessages::CREATE_COMMAND_BUFFERS_FAILED);
+    }
 }
 
 VkResult GraphicsPipeline::createCmdBuffers(size_t const& swpchainImgCount)
@@ -214,7 +277,8 @@ GraphicsPipeline::GraphicsPipeline(GraphicsPipeline&& graphicspipeline) noexcept
         AVkGraphicsBase(std::move(graphicspipeline)),
         pipeline(std::move(graphicspipeline.pipeline)),
         pipelineLayout(std::move(graphicspipeline.pipelineLayout)),
-        cmdBuffers(std::move(graphicspipeline.cmdBuffers))
+        cmdBuffers(std::move(graphicspipeline.cmdBuffers)),
+        pushConstantRanges(std::move(graphicspipeline.pushConstantRanges))
 {
 }
 
@@ -222,9 +286,12 @@ GraphicsPipeline& GraphicsPipeline::operator=(GraphicsPipeline&& graphicspipelin
 {
     if (initialized())
     {
-        vkFreeCommandBuffers(getLogicalDev(), *cmdPool,
-                             static_cast<uint32_t>(cmdBuffers.size()),
-                             cmdBuffers.data());
+        if (not cmdBuffers.empty())
+        {
+            vkFreeCommandBuffers(getLogicalDev(), *cmdPool,
+                                 static_cast<uint32_t>(cmdBuffers.size()),
+                                 cmdBuffers.data());
+        }
         vkDestroyPipeline(getLogicalDev(), pipeline, nullptr);
         vkDestroyPipelineLayout(getLogicalDev(), pipelineLayout, nullptr);
     }
@@ -232,6 +299,7 @@ GraphicsPipeline& GraphicsPipeline::operator=(GraphicsPipeline&& graphicspipelin
     pipeline = std::move(graphicspipeline.pipeline);
     pipelineLayout = std::move(graphicspipeline.pipelineLayout);
     cmdBuffers = std::move(graphicspipeline.cmdBuffers);
+    pushConstantRanges = std::move(graphicspipeline.pushConstantRanges);
     AVkGraphicsBase::operator=(std::move(graphicspipeline));
     return *this;
 }
@@ -242,12 +310,25 @@ GraphicsPipeline::~GraphicsPipeline()
 {
     if (initialized())
     {
-        vkFreeCommandBuffers(getLogicalDev(), *cmdPool,
-                             static_cast<uint32_t>(cmdBuffers.size()),
-                             cmdBuffers.data());
+        if (not cmdBuffers.empty())
+        {
+            vkFreeCommandBuffers(getLogicalDev(), *cmdPool,
+                                 static_cast<uint32_t>(cmdBuffers.size()),
+                                 cmdBuffers.data());
+        }
         vkDestroyPipeline(getLogicalDev(), pipeline, nullptr);
         vkDestroyPipelineLayout(getLogicalDev(), pipelineLayout, nullptr);
         pipeline = VK_NULL_HANDLE;
         pipelineLayout = VK_NULL_HANDLE;
     }
-}
\ No newline at end of file
+}
+
+VkShaderStageFlags GraphicsPipeline::pushConstantStages() const
+{
+    VkShaderStageFlags stages = 0;
+    for (auto const& range : pushConstantRanges)
+    {
+        stages |= range.stageFlags;
+    }
+    return stages;
+}
@@ -171,7 +171,7 @@ namespace Image
 
     Image& Image::Image::operator=(Image&& im) noexcept
     {
-        // destroy whatever's left here.
+        // destroy whatever's left here; retire it to a DeletionQueue first if the GPU may still use it
         dispose();
 
         img = std::move(im.img);
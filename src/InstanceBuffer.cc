@@ -0,0 +1,67 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "InstanceBuffer.h"
+
+VkPushConstantRange InstanceBatchPushConstant::pushConstantRange()
+{
+    VkPushConstantRange range = {};
+    range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    range.offset = 0;
+    range.size = sizeof(InstanceBatchPushConstant);
+    return range;
+}
+
+InstanceBuffer::InstanceBuffer(
+        VkDevice* logicalDev,
+        VmaAllocator* allocator,
+        VkPhysicalDevice const& physDev,
+        DescriptorAllocator& descAllocator,
+        DescriptorLayoutCache& layoutCache,
+        Buffers::optUint32Set const& usedQueues)
+{
+    descriptorSetLayout = layoutCache.getLayout({
+            StorageBufferArray<DrawRecord>::DescriptorSetLayout(0)
+    });
+
+    std::vector<VkDescriptorSetLayout> layouts(MAX_FRAMES_IN_FLIGHT, descriptorSetLayout);
+    CHECK_VK_SUCCESS(descAllocator.allocate(layouts, descriptorSets),
+                     "Cannot create instance descriptor sets!");
+
+    instanceBuffers.reserve(MAX_FRAMES_IN_FLIGHT);
+    std::vector<VkDescriptorBufferInfo> bufferInfos(MAX_FRAMES_IN_FLIGHT);
+    std::vector<VkWriteDescriptorSet> descriptorWrites(MAX_FRAMES_IN_FLIGHT);
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+    {
+        auto& instanceBuffer = instanceBuffers.emplace_back(
+                logicalDev, allocator, physDev, MAX_INSTANCES,
+                usedQueues, 0,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        bufferInfos[i].buffer = instanceBuffer.vertexBuffer;
+        bufferInfos[i].offset = 0;
+        bufferInfos[i].range = instanceBuffer.getSize();
+
+        descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrites[i].dstSet = descriptorSets[i];
+        descriptorWrites[i].dstBinding = 0;
+        descriptorWrites[i].dstArrayElement = 0;
+        descriptorWrites[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        descriptorWrites[i].descriptorCount = 1;
+        descriptorWrites[i].pBufferInfo = &bufferInfos[i];
+    }
+
+    vkUpdateDescriptorSets(
+            *logicalDev, static_cast<uint32_t>(descriptorWrites.size()), descriptorWrites.data(), 0, nullptr);
+}
+
+VkResult InstanceBuffer::setInstances(uint32_t const& frameIdx, std::vector<DrawRecord> const& records)
+{
+    return instanceBuffers[frameIdx].loadDataAndSetSize(records);
+}
+
+StorageBufferArray<DrawRecord> const& InstanceBuffer::records(uint32_t const& frameIdx) const
+{
+    return instanceBuffers[frameIdx];
+}
@@ -0,0 +1,117 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "InstanceTransform.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define INSTANCE_TRANSFORM_SSE
+#include <xmmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // glm matrices are column-major, so the rows are the transpose of the columns
+    inline void encodeOne(float const* columns, float* rows)
+    {
+#if defined(INSTANCE_TRANSFORM_SSE)
+        __m128 c0 = _mm_loadu_ps(columns);
+        __m128 c1 = _mm_loadu_ps(columns + 4);
+        __m128 c2 = _mm_loadu_ps(columns + 8);
+        __m128 c3 = _mm_loadu_ps(columns + 12);
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+        // after the transpose c0..c2 hold the first three rows; the last row is dropped
+        _mm_storeu_ps(rows, c0);
+        _mm_storeu_ps(rows + 4, c1);
+        _mm_storeu_ps(rows + 8, c2);
+#else
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                rows[r * 4 + c] = columns[c * 4 + r];
+            }
+        }
+#endif
+    }
+}
+
+InstanceTransform InstanceTransform::encode(glm::mat4 const& model)
+{
+    InstanceTransform transform;
+    encodeOne(glm::value_ptr(model), glm::value_ptr(transform.rows[0]));
+    return transform;
+}
+
+namespace
+{
+    // matrices per iteration of encodeBatch
+    constexpr size_t BATCH = 4;
+
+#if defined(__AVX2__)
+    // two matrices side by side, a in the low lanes and b in the high ones
+    inline __m256 loadPair(float const* a, float const* b)
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(a)), _mm_loadu_ps(b), 1);
+    }
+
+    inline void storePair(__m256 const& row, float* a, float* b)
+    {
+        _mm_storeu_ps(a, _mm256_castps256_ps128(row));
+        _mm_storeu_ps(b, _mm256_extractf128_ps(row, 1));
+    }
+
+    // _MM_TRANSPOSE4_PS on both lanes at once, keeping the first three rows
+    inline void encodePair(float const* a, float const* b, float* outA, float* outB)
+    {
+        __m256 c0 = loadPair(a, b);
+        __m256 c1 = loadPair(a + 4, b + 4);
+        __m256 c2 = loadPair(a + 8, b + 8);
+        __m256 c3 = loadPair(a + 12, b + 12);
+
+        __m256 t0 = _mm256_shuffle_ps(c0, c1, 0x44);
+        __m256 t1 = _mm256_shuffle_ps(c2, c3, 0x44);
+        __m256 t2 = _mm256_shuffle_ps(c0, c1, 0xEE);
+        __m256 t3 = _mm256_shuffle_ps(c2, c3, 0xEE);
+
+        storePair(_mm256_shuffle_ps(t0, t1, 0x88), outA, outB);
+        storePair(_mm256_shuffle_ps(t0, t1, 0xDD), outA + 4, outB + 4);
+        storePair(_mm256_shuffle_ps(t2, t3, 0x88), outA + 8, outB + 8);
+    }
+#endif
+
+    // BATCH matrices with no dependency between them, so their loads, shuffles and
+    // stores interleave instead of running one transpose after another
+    inline void encodeBlock(glm::mat4 const* models, InstanceTransform* out)
+    {
+#if defined(__AVX2__)
+        for (size_t i = 0; i < BATCH; i += 2)
+        {
+            encodePair(glm::value_ptr(models[i]), glm::value_ptr(models[i + 1]),
+                       glm::value_ptr(out[i].rows[0]), glm::value_ptr(out[i + 1].rows[0]));
+        }
+#else
+        for (size_t i = 0; i < BATCH; ++i)
+        {
+            encodeOne(glm::value_ptr(models[i]), glm::value_ptr(out[i].rows[0]));
+        }
+#endif
+    }
+}
+
+void InstanceTransform::encodeBatch(glm::mat4 const* models, size_t const& count, InstanceTransform* out)
+{
+    size_t i = 0;
+    for (; i + BATCH <= count; i += BATCH)
+    {
+        encodeBlock(models + i, out + i);
+    }
+    for (; i < count; ++i)
+    {
+        encodeOne(glm::value_ptr(models[i]), glm::value_ptr(out[i].rows[0]));
+    }
+}
@@ -0,0 +1,528 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "JobSystem.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#endif
+
+namespace
+{
+    // identifies the worker the calling thread belongs to, if any
+    thread_local JobSystem const* currentSystem = nullptr;
+    thread_local uint32_t currentWorker = 0;
+
+    // spins through the deques this many times before a worker goes to sleep
+    constexpr uint32_t IDLE_SPINS = 64;
+
+    void pinToCore(std::thread::native_handle_type const& handle, uint32_t const& core)
+    {
+#if defined(_WIN32)
+        SetThreadAffinityMask(handle, DWORD_PTR(1) << (core % (sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(core % CPU_SETSIZE, &cpuSet);
+        pthread_setaffinity_np(handle, sizeof(cpu_set_t), &cpuSet);
+#else
+        (void) handle;
+        (void) core;
+#endif
+    }
+}
+
+bool Jobs::Counter::done() const
+{
+    return pending.load(std::memory_order_acquire) == 0;
+}
+
+Jobs::WorkStealingDeque::WorkStealingDeque()
+{
+    for (auto& slot : buffer)
+    {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+bool Jobs::WorkStealingDeque::push(Job* job)
+{
+    int64_t b = bottom.load(std::memory_order_relaxed);
+    int64_t t = top.load(std::memory_order_acquire);
+    if (b - t >= CAPACITY)
+    {
+        return false;
+    }
+
+    buffer[b & MASK].store(job, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Jobs::Job* Jobs::WorkStealingDeque::pop()
+{
+    int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        // empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Job* job = buffer[b & MASK].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+        // last job; race the thieves for it
+        if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            job = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Jobs::Job* Jobs::WorkStealingDeque::steal()
+{
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom.load(std::memory_order_acquire);
+    if (t >= b)
+    {
+        return nullptr;
+    }
+
+    Job* job = buffer[t & MASK].load(std::memory_order_relaxed);
+    if (not top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        // lost to the owner or another thief
+        return nullptr;
+    }
+    return job;
+}
+
+JobSystem::JobSystem(uint32_t const& threadCount, bool const& pinThreads) :
+        mainThread(std::this_thread::get_id())
+{
+    uint32_t workerCount = threadCount;
+    if (workerCount == 0)
+    {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    deques.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i)
+    {
+        deques.push_back(std::make_unique<Jobs::WorkStealingDeque>());
+    }
+
+    registerThread();
+    if (pinThreads)
+    {
+#if defined(_WIN32)
+        pinToCore(GetCurrentThread(), 0);
+#elif defined(__linux__)
+        pinToCore(pthread_self(), 0);
+#endif
+    }
+
+    threads.reserve(workerCount - 1);
+    for (uint32_t i = 1; i < workerCount; ++i)
+    {
+        std::thread& thread = threads.emplace_back(&JobSystem::workerLoop, this, i);
+        if (pinThreads)
+        {
+            pinToCore(thread.native_handle(), i);
+        }
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    stopping.store(true);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wakeUp.notify_all();
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    if (currentSystem == this)
+    {
+        currentSystem = nullptr;
+    }
+}
+
+uint32_t JobSystem::threadCount() const
+{
+    return static_cast<uint32_t>(deques.size());
+}
+
+void JobSystem::registerThread()
+{
+    currentSystem = this;
+    currentWorker = 0;
+}
+
+void JobSystem::releaseThread()
+{
+    assert(currentSystem == this && currentWorker == 0);
+    // jobs left in the deque are stolen, or popped by the next thread to register
+    currentSystem = nullptr;
+}
+
+void JobSystem::run(std::function<void()> fn, Jobs::Counter* counter)
+{
+    if (counter != nullptr)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    schedule(new Jobs::Job { std::move(fn), counter });
+}
+
+void JobSystem::runBackground(std::function<void()> fn, Jobs::Counter* counter)
+{
+    if (threads.empty())
+    {
+        run(std::move(fn), counter);
+        return;
+    }
+
+    if (counter != nullptr)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard<std::mutex> lock(backgroundMutex);
+        backgroundQueue.push_back(new Jobs::Job { std::move(fn), counter });
+        backgroundCount.fetch_add(1, std::memory_order_release);
+    }
+
+    if (sleepingWorkers.load() > 0)
+    {
+        wakeUp.notify_one();
+    }
+}
+
+void JobSystem::runAfter(Jobs::Counter& dependency, std::function<void()> fn, Jobs::Counter* counter)
+{
+    if (counter != nullptr)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto* job = new Jobs::Job { std::move(fn), counter };
+
+    {
+        // finish() takes the same lock before releasing continuations, so the job
+        // is either seen there or the dependency is already done here
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (not dependency.done())
+        {
+            dependency.continuations.push_back(job);
+            return;
+        }
+    }
+    schedule(job);
+}
+
+void JobSystem::wait(Jobs::Counter& counter)
+{
+    while (not counter.done())
+    {
+        pumpThread();
+
+        Jobs::Job* job = findJob();
+        if (job != nullptr)
+        {
+            execute(job);
+        }
+        else
+        {
+            // what is left is running on other threads
+            std::this_thread::yield();
+        }
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(counter.mutex);
+        std::swap(error, counter.error);
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+void JobSystem::parallelFor(
+        uint32_t const& count,
+        uint32_t const& grainSize,
+        std::function<void(uint32_t, uint32_t)> const& body)
+{
+    uint32_t grain = std::max(1u, grainSize);
+    if (count <= grain)
+    {
+        body(0, count);
+        return;
+    }
+
+    Jobs::Counter counter;
+    // the calling thread takes the first range itself after queuing the rest
+    for (uint32_t begin = grain; begin < count; begin += grain)
+    {
+        uint32_t end = std::min(begin + grain, count);
+        run([&body, begin, end]() { body(begin, end); }, &counter);
+    }
+    try
+    {
+        body(0, grain);
+    }
+    catch (...)
+    {
+        // the queued ranges still reference body and counter
+        wait(counter);
+        throw;
+    }
+    wait(counter);
+}
+
+void JobSystem::runOnThread(std::thread::id const& thread, std::function<void()> fn, Jobs::Counter* counter)
+{
+    if (counter != nullptr)
+    {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto* job = new Jobs::Job { std::move(fn), counter };
+
+    if (std::this_thread::get_id() == thread)
+    {
+        execute(job);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(affineMutex);
+    affineJobs[thread].push_back(job);
+    affineJobCount.fetch_add(1, std::memory_order_release);
+}
+
+void JobSystem::runOnMainThread(std::function<void()> fn, Jobs::Counter* counter)
+{
+    runOnThread(mainThread, std::move(fn), counter);
+}
+
+void JobSystem::pumpThread()
+{
+    if (affineJobCount.load(std::memory_order_acquire) == 0)
+    {
+        return;
+    }
+
+    std::vector<Jobs::Job*> jobs;
+    {
+        std::lock_guard<std::mutex> lock(affineMutex);
+        auto it = affineJobs.find(std::this_thread::get_id());
+        if (it == affineJobs.end())
+        {
+            return;
+        }
+        jobs.swap(it->second);
+        affineJobs.erase(it);
+        affineJobCount.fetch_sub(static_cast<uint32_t>(jobs.size()), std::memory_order_relaxed);
+    }
+    for (auto* job : jobs)
+    {
+        execute(job);
+    }
+}
+
+void JobSystem::pumpMainThread()
+{
+    assert(std::this_thread::get_id() == mainThread);
+    pumpThread();
+}
+
+void JobSystem::workerLoop(uint32_t workerIdx)
+{
+    currentSystem = this;
+    currentWorker = workerIdx;
+
+    uint32_t idleSpins = 0;
+    while (not stopping.load(std::memory_order_relaxed))
+    {
+        // frame work comes first; background jobs only fill otherwise idle time
+        Jobs::Job* job = findJob();
+        if (job == nullptr)
+        {
+            job = findBackgroundJob();
+        }
+        if (job != nullptr)
+        {
+            execute(job);
+            idleSpins = 0;
+            continue;
+        }
+
+        if (++idleSpins < IDLE_SPINS)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // the timeout covers a job pushed between the last search and going to sleep
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepingWorkers.fetch_add(1);
+        wakeUp.wait_for(lock, std::chrono::milliseconds(1));
+        sleepingWorkers.fetch_sub(1);
+        idleSpins = 0;
+    }
+}
+
+void JobSystem::schedule(Jobs::Job* job)
+{
+    bool queued = false;
+    if (currentSystem == this)
+    {
+        queued = deques[currentWorker]->push(job);
+    }
+
+    if (not queued)
+    {
+        // a thread outside the system, or a full deque
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        injectionQueue.push_back(job);
+        injectionCount.fetch_add(1, std::memory_order_release);
+    }
+
+    if (sleepingWorkers.load() > 0)
+    {
+        wakeUp.notify_one();
+    }
+}
+
+void JobSystem::execute(Jobs::Job* job)
+{
+    try
+    {
+        job->fn();
+    }
+    catch (std::exception const& e)
+    {
+        reportError(job, std::current_exception(), e.what());
+    }
+    catch (...)
+    {
+        reportError(job, std::current_exception(), "unknown exception");
+    }
+
+    if (job->counter != nullptr)
+    {
+        finish(*job->counter);
+    }
+    delete job;
+}
+
+void JobSystem::reportError(Jobs::Job* job, std::exception_ptr const& error, char const* what)
+{
+    if (job->counter == nullptr)
+    {
+        // nobody waits for the job, so the error can only be logged; letting it escape
+        // would terminate the worker thread
+        std::cerr << "Job without a counter threw: " << what << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(job->counter->mutex);
+    if (not job->counter->error)
+    {
+        job->counter->error = error;
+    }
+}
+
+void JobSystem::finish(Jobs::Counter& counter)
+{
+    std::vector<Jobs::Job*> continuations;
+    {
+        // decremented under the lock so runAfter() never sees a done counter
+        // before its continuations have been taken
+        std::lock_guard<std::mutex> lock(counter.mutex);
+        if (counter.pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        {
+            return;
+        }
+        continuations.swap(counter.continuations);
+    }
+
+    for (auto* continuation : continuations)
+    {
+        schedule(continuation);
+    }
+}
+
+Jobs::Job* JobSystem::findJob()
+{
+    bool isWorker = currentSystem == this;
+    uint32_t self = isWorker ? currentWorker : 0;
+    if (isWorker)
+    {
+        Jobs::Job* job = deques[self]->pop();
+        if (job != nullptr)
+        {
+            return job;
+        }
+    }
+
+    if (injectionCount.load(std::memory_order_acquire) > 0)
+    {
+        std::lock_guard<std::mutex> lock(injectionMutex);
+        if (not injectionQueue.empty())
+        {
+            Jobs::Job* job = injectionQueue.front();
+            injectionQueue.pop_front();
+            injectionCount.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+
+    // start at the next worker so thieves spread over the victims; a thread
+    // outside the system has no deque of its own and tries every worker
+    auto workerCount = static_cast<uint32_t>(deques.size());
+    for (uint32_t i = isWorker ? 1 : 0; i < workerCount; ++i)
+    {
+        uint32_t victim = (self + i) % workerCount;
+        Jobs::Job* job = deques[victim]->steal();
+        if (job != nullptr)
+        {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+Jobs::Job* JobSystem::findBackgroundJob()
+{
+    if (backgroundCount.load(std::memory_order_acquire) == 0)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(backgroundMutex);
+    if (backgroundQueue.empty())
+    {
+        return nullptr;
+    }
+
+    Jobs::Job* job = backgroundQueue.front();
+    backgroundQueue.pop_front();
+    backgroundCount.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+}
@@ -0,0 +1,296 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "LightClusters.h"
+
+#if defined(__AVX2__)
+#define LIGHT_BINNER_AVX2
+#include <immintrin.h>
+#endif
+
+namespace
+{
+    // smallest slice of lights worth handing to another thread; a multiple of the SIMD width
+    constexpr uint32_t LIGHTS_PER_JOB = 1024;
+
+    inline int32_t tileOf(float const& ndc, uint32_t const& gridSize)
+    {
+        auto tile = static_cast<int32_t>(std::floor((ndc * 0.5f + 0.5f) * static_cast<float>(gridSize)));
+        return std::clamp(tile, 0, static_cast<int32_t>(gridSize) - 1);
+    }
+
+#if defined(LIGHT_BINNER_AVX2)
+    inline __m256 madd(__m256 const& a, __m256 const& b, __m256 const& c)
+    {
+#if defined(__FMA__)
+        return _mm256_fmadd_ps(a, b, c);
+#else
+        return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+    }
+
+    inline __m256i tilesOf(__m256 const& ndc, uint32_t const& gridSize)
+    {
+        __m256 half = _mm256_set1_ps(0.5f);
+        __m256 tile = _mm256_floor_ps(_mm256_mul_ps(madd(ndc, half, half), _mm256_set1_ps(static_cast<float>(gridSize))));
+        __m256i clamped = _mm256_max_epi32(_mm256_cvttps_epi32(tile), _mm256_setzero_si256());
+        return _mm256_min_epi32(clamped, _mm256_set1_epi32(static_cast<int32_t>(gridSize) - 1));
+    }
+#endif
+}
+
+LightClusters::DepthSlicing LightClusters::DepthSlicing::fromClipPlanes(float const& clipNear, float const& clipFar)
+{
+    DepthSlicing slicing = {};
+    slicing.scale = static_cast<float>(GRID_Z) / std::log(clipFar / clipNear);
+    slicing.bias = -std::log(clipNear) * slicing.scale;
+    return slicing;
+}
+
+float LightClusters::DepthSlicing::sliceDepth(uint32_t const& slice) const
+{
+    return std::exp((static_cast<float>(slice) - bias) / scale);
+}
+
+void LightBinner::bin(
+        std::vector<Light> const& lights,
+        uint32_t const& firstIndex,
+        glm::mat4 const& view,
+        glm::mat4 const& proj,
+        LightClusters::DepthSlicing const& slicing,
+        JobSystem& jobs)
+{
+    using namespace LightClusters;
+
+    // a symmetric perspective projection maps view (x, y) at depth d to (x * proj[0][0], y * proj[1][1]) / d
+    Projection projection = {};
+    projection.view = view;
+    projection.scaleX = proj[0][0];
+    projection.scaleY = proj[1][1];
+    projection.clipNear = slicing.sliceDepth(0);
+    projection.clipFar = slicing.sliceDepth(GRID_Z);
+    for (uint32_t i = 1; i < GRID_Z; ++i)
+    {
+        projection.sliceStarts[i - 1] = slicing.sliceDepth(i);
+    }
+
+    count = lights.size();
+    size_t padded = (count + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+    for (auto* range : { &minX, &maxX, &minY, &maxY, &minZ, &maxZ })
+    {
+        range->resize(padded);
+    }
+    indices.resize(CLUSTER_COUNT * MAX_LIGHTS_PER_CLUSTER);
+
+    jobs.parallelFor(static_cast<uint32_t>(count), LIGHTS_PER_JOB,
+                     [this, &lights, &projection](uint32_t first, uint32_t last)
+                     {
+                         computeRanges(lights, projection, first, last);
+                     });
+
+    // each slice owns its clusters, so the jobs never write to the same one
+    jobs.parallelFor(GRID_Z, 1,
+                     [this, &firstIndex](uint32_t first, uint32_t last)
+                     {
+                         for (uint32_t slice = first; slice < last; ++slice)
+                         {
+                             scatter(firstIndex, slice);
+                         }
+                     });
+}
+
+void LightBinner::computeRanges(
+        std::vector<Light> const& lights, Projection const& projection, uint32_t first, uint32_t last)
+{
+    size_t i = first;
+#if defined(LIGHT_BINNER_AVX2)
+    glm::mat4 const& view = projection.view;
+    __m256 const zero = _mm256_setzero_ps();
+    __m256 const one = _mm256_set1_ps(1.f);
+    __m256 const negOne = _mm256_set1_ps(-1.f);
+    __m256 const scaleX = _mm256_set1_ps(projection.scaleX);
+    __m256 const scaleY = _mm256_set1_ps(projection.scaleY);
+    __m256 const clipNear = _mm256_set1_ps(projection.clipNear);
+    __m256 const clipFar = _mm256_set1_ps(projection.clipFar);
+
+    for (; i + SIMD_WIDTH <= last; i += SIMD_WIDTH)
+    {
+        // lights are stored as structures; gather the eight centers and ranges
+        alignas(32) float px[SIMD_WIDTH], py[SIMD_WIDTH], pz[SIMD_WIDTH], pr[SIMD_WIDTH];
+        for (size_t j = 0; j < SIMD_WIDTH; ++j)
+        {
+            Light const& light = lights[i + j];
+            px[j] = light.position.x;
+            py[j] = light.position.y;
+            pz[j] = light.position.z;
+            pr[j] = light.parameters.x;
+        }
+        __m256 x = _mm256_load_ps(px);
+        __m256 y = _mm256_load_ps(py);
+        __m256 z = _mm256_load_ps(pz);
+        __m256 r = _mm256_load_ps(pr);
+
+        // glm is column-major: view[column][row]
+        __m256 cx = madd(_mm256_set1_ps(view[0][0]), x, madd(_mm256_set1_ps(view[1][0]), y,
+                    madd(_mm256_set1_ps(view[2][0]), z, _mm256_set1_ps(view[3][0]))));
+        __m256 cy = madd(_mm256_set1_ps(view[0][1]), x, madd(_mm256_set1_ps(view[1][1]), y,
+                    madd(_mm256_set1_ps(view[2][1]), z, _mm256_set1_ps(view[3][1]))));
+        __m256 cz = madd(_mm256_set1_ps(view[0][2]), x, madd(_mm256_set1_ps(view[1][2]), y,
+                    madd(_mm256_set1_ps(view[2][2]), z, _mm256_set1_ps(view[3][2]))));
+
+        // view space is left-handed, so the view depth is z itself
+        __m256 nearDepth = _mm256_max_ps(_mm256_sub_ps(cz, r), clipNear);
+        __m256 farDepth = _mm256_min_ps(_mm256_add_ps(cz, r), clipFar);
+        __m256 invNear = _mm256_div_ps(one, nearDepth);
+        __m256 invFar = _mm256_div_ps(one, farDepth);
+
+        auto project = [&invNear, &invFar](__m256 const& lo, __m256 const& hi, __m256& outMin, __m256& outMax)
+        {
+            __m256 a = _mm256_mul_ps(lo, invNear);
+            __m256 b = _mm256_mul_ps(lo, invFar);
+            __m256 c = _mm256_mul_ps(hi, invNear);
+            __m256 d = _mm256_mul_ps(hi, invFar);
+            outMin = _mm256_min_ps(_mm256_min_ps(a, b), _mm256_min_ps(c, d));
+            outMax = _mm256_max_ps(_mm256_max_ps(a, b), _mm256_max_ps(c, d));
+        };
+        __m256 x0, x1, y0, y1;
+        project(_mm256_mul_ps(_mm256_sub_ps(cx, r), scaleX), _mm256_mul_ps(_mm256_add_ps(cx, r), scaleX), x0, x1);
+        project(_mm256_mul_ps(_mm256_sub_ps(cy, r), scaleY), _mm256_mul_ps(_mm256_add_ps(cy, r), scaleY), y0, y1);
+
+        __m256 visible = _mm256_and_ps(_mm256_cmp_ps(r, zero, _CMP_GT_OQ),
+                                       _mm256_cmp_ps(nearDepth, farDepth, _CMP_LT_OQ));
+        visible = _mm256_and_ps(visible, _mm256_and_ps(_mm256_cmp_ps(x1, negOne, _CMP_GE_OQ),
+                                                       _mm256_cmp_ps(x0, one, _CMP_LE_OQ)));
+        visible = _mm256_and_ps(visible, _mm256_and_ps(_mm256_cmp_ps(y1, negOne, _CMP_GE_OQ),
+                                                       _mm256_cmp_ps(y0, one, _CMP_LE_OQ)));
+
+        // slices are counted by the slice starts at or before each depth
+        __m256i slice0 = _mm256_setzero_si256();
+        __m256i slice1 = _mm256_setzero_si256();
+        for (float const& start : projection.sliceStarts)
+        {
+            __m256 start8 = _mm256_set1_ps(start);
+            slice0 = _mm256_sub_epi32(slice0, _mm256_castps_si256(_mm256_cmp_ps(nearDepth, start8, _CMP_GE_OQ)));
+            slice1 = _mm256_sub_epi32(slice1, _mm256_castps_si256(_mm256_cmp_ps(farDepth, start8, _CMP_GE_OQ)));
+        }
+
+        // lights nothing sees get an empty slice range
+        __m256i visibleMask = _mm256_castps_si256(visible);
+        slice0 = _mm256_blendv_epi8(_mm256_set1_epi32(1), slice0, visibleMask);
+        slice1 = _mm256_blendv_epi8(_mm256_setzero_si256(), slice1, visibleMask);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(minX.data() + i), tilesOf(_mm256_max_ps(x0, negOne), LightClusters::GRID_X));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxX.data() + i), tilesOf(_mm256_min_ps(x1, one), LightClusters::GRID_X));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(minY.data() + i), tilesOf(_mm256_max_ps(y0, negOne), LightClusters::GRID_Y));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxY.data() + i), tilesOf(_mm256_min_ps(y1, one), LightClusters::GRID_Y));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(minZ.data() + i), slice0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxZ.data() + i), slice1);
+    }
+#endif
+    for (; i < last; ++i)
+    {
+        computeRange(lights[i], projection, i);
+    }
+}
+
+void LightBinner::computeRange(Light const& light, Projection const& projection, size_t const& idx)
+{
+    glm::vec4 center = projection.view * glm::vec4(glm::vec3(light.position), 1.f);
+    float radius = light.parameters.x;
+    // view space is left-handed (GLM_FORCE_LEFT_HANDED): the camera looks down +z
+    float depth = center.z;
+    float nearDepth = std::max(depth - radius, projection.clipNear);
+    float farDepth = std::min(depth + radius, projection.clipFar);
+
+    // the sphere lies in the box of its x and y extents between those depths; its
+    // projection is bounded by the box's corners
+    auto project = [nearDepth, farDepth](float const& lo, float const& hi)
+    {
+        std::array<float, 4> corners = { lo / nearDepth, lo / farDepth, hi / nearDepth, hi / farDepth };
+        auto [cornerMin, cornerMax] = std::minmax_element(corners.begin(), corners.end());
+        return std::make_pair(*cornerMin, *cornerMax);
+    };
+    auto [x0, x1] = project((center.x - radius) * projection.scaleX, (center.x + radius) * projection.scaleX);
+    auto [y0, y1] = project((center.y - radius) * projection.scaleY, (center.y + radius) * projection.scaleY);
+
+    bool visible = radius > 0 && nearDepth < farDepth &&
+                   x1 >= -1.f && x0 <= 1.f &&
+                   y1 >= -1.f && y0 <= 1.f;
+    if (not visible)
+    {
+        minZ[idx] = 1;
+        maxZ[idx] = 0;
+        return;
+    }
+
+    auto sliceOf = [&projection](float const& viewDepth)
+    {
+        auto const& starts = projection.sliceStarts;
+        return static_cast<int32_t>(std::upper_bound(starts.begin(), starts.end(), viewDepth) - starts.begin());
+    };
+
+    minX[idx] = tileOf(std::max(x0, -1.f), LightClusters::GRID_X);
+    maxX[idx] = tileOf(std::min(x1, 1.f), LightClusters::GRID_X);
+    minY[idx] = tileOf(std::max(y0, -1.f), LightClusters::GRID_Y);
+    maxY[idx] = tileOf(std::min(y1, 1.f), LightClusters::GRID_Y);
+    minZ[idx] = sliceOf(nearDepth);
+    maxZ[idx] = sliceOf(farDepth);
+}
+
+void LightBinner::scatter(uint32_t const& firstIndex, uint32_t const& slice)
+{
+    using namespace LightClusters;
+
+    uint32_t const sliceFirst = slice * GRID_X * GRID_Y;
+    std::fill(counts.begin() + sliceFirst, counts.begin() + sliceFirst + GRID_X * GRID_Y, 0);
+
+    auto const z = static_cast<int32_t>(slice);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (minZ[i] > z || maxZ[i] < z)
+        {
+            continue;
+        }
+
+        for (int32_t y = minY[i]; y <= maxY[i]; ++y)
+        {
+            for (int32_t x = minX[i]; x <= maxX[i]; ++x)
+            {
+                uint32_t cluster = sliceFirst + static_cast<uint32_t>(y) * GRID_X + static_cast<uint32_t>(x);
+                uint32_t& clusterCount = counts[cluster];
+                if (clusterCount < MAX_LIGHTS_PER_CLUSTER)
+                {
+                    indices[cluster * MAX_LIGHTS_PER_CLUSTER + clusterCount] = firstIndex + static_cast<uint32_t>(i);
+                    ++clusterCount;
+                }
+            }
+        }
+    }
+}
+
+std::vector<uint32_t> LightBinner::clusterLights(uint32_t const& cluster) const
+{
+    auto first = indices.begin() + cluster * LightClusters::MAX_LIGHTS_PER_CLUSTER;
+    return std::vector<uint32_t>(first, first + counts[cluster]);
+}
+
+VkResult LightBinner::upload(Buffers::Buffer& clusterBuffer) const
+{
+    using namespace LightClusters;
+
+    std::vector<std::tuple<void const*, size_t, size_t>> regions;
+    regions.reserve(CLUSTER_COUNT + 1);
+    regions.emplace_back(counts.data(), 0, CLUSTER_COUNT * sizeof(uint32_t));
+    for (uint32_t cluster = 0; cluster < CLUSTER_COUNT; ++cluster)
+    {
+        if (counts[cluster] > 0)
+        {
+            regions.emplace_back(
+                    indices.data() + cluster * MAX_LIGHTS_PER_CLUSTER,
+                    (CLUSTER_COUNT + cluster * MAX_LIGHTS_PER_CLUSTER) * sizeof(uint32_t),
+                    counts[cluster] * sizeof(uint32_t));
+        }
+    }
+    return clusterBuffer.loadData(regions);
+}
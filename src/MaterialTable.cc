@@ -0,0 +1,58 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "MaterialTable.h"
+
+MaterialTable::MaterialTable(
+        VkDevice* logicalDev,
+        VmaAllocator* allocator,
+        VkPhysicalDevice const& physDev,
+        DescriptorAllocator& descAllocator,
+        DescriptorLayoutCache& layoutCache)
+{
+    materialBuffer = std::make_unique<StorageBufferArray<MaterialRecord>>(
+            logicalDev, allocator, physDev, MAX_MATERIALS,
+            nullopt, 0,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    descriptorSetLayout = layoutCache.getLayout({
+            StorageBufferArray<MaterialRecord>::DescriptorSetLayout(0)
+    });
+    CHECK_VK_SUCCESS(descAllocator.allocate(descriptorSetLayout, descriptorSet),
+                     "Cannot create material descriptor set!");
+
+    VkDescriptorBufferInfo bufferInfo = {};
+    bufferInfo.buffer = materialBuffer->vertexBuffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = materialBuffer->getSize();
+
+    VkWriteDescriptorSet descriptorWrite = {};
+    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptorWrite.dstSet = descriptorSet;
+    descriptorWrite.dstBinding = 0;
+    descriptorWrite.dstArrayElement = 0;
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrite.descriptorCount = 1;
+    descriptorWrite.pBufferInfo = &bufferInfo;
+
+    vkUpdateDescriptorSets(*logicalDev, 1, &descriptorWrite, 0, nullptr);
+}
+
+uint32_t MaterialTable::registerMaterial(MaterialRecord const& material)
+{
+    if (materials.size() >= MAX_MATERIALS)
+    {
+        throw std::runtime_error("Material table is full!");
+    }
+
+    materials.push_back(material);
+    CHECK_VK_SUCCESS(materialBuffer->loadDataAndSetSize(materials), "Cannot upload materials!");
+    return static_cast<uint32_t>(materials.size() - 1);
+}
+
+void MaterialTable::updateMaterial(uint32_t const& idx, MaterialRecord const& material)
+{
+    materials.at(idx) = material;
+    CHECK_VK_SUCCESS(materialBuffer->loadDataAndSetSize(materials), "Cannot upload materials!");
+}
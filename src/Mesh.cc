@@ -4,10 +4,12 @@
 
 #include "Mesh.h"
 
-Mesh::Mesh(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice* physDev, std::string const& objFile) : AVkGraphicsBase(logicalDev), allocator(allocator), physDev(physDev)
+Mesh::Mesh(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice* physDev, std::string const& objFile,
+           VertexLayout layout) : AVkGraphicsBase(logicalDev), layout(layout), allocator(allocator), physDev(physDev)
 {
     std::vector<glm::vec3> rawVerts;
     std::vector<glm::vec3> rawNormals;
+    std::vector<glm::vec2> rawTexCoords;
 
     std::ifstream objfile(objFile);
     assert(objfile.is_open());
@@ -37,6 +39,13 @@ Mesh::Mesh(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice* phys
             sstr >> x >> y >> z;
             rawNormals.emplace_back(std::stof(x), std::stof(y), std::stof(z));
         }
+        else if (mode == "vt")
+        {
+            std::string u, v;
+            sstr >> u >> v;
+            // obj puts v = 0 at the bottom of the image, Vulkan at the top
+            rawTexCoords.emplace_back(std::stof(u), 1.f - std::stof(v));
+        }
         else if (mode == "f")
         {
             std::string tmpindex;
@@ -54,10 +63,16 @@ Mesh::Mesh(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice* phys
                 {
                     norm = rawNormals[std::stoi(contents[2]) - 1];
                 }
+                glm::vec2 texCoord(0.f);
+                if (contents.size() >= 2 and not contents[1].empty())
+                {
+                    texCoord = rawTexCoords[std::stoi(contents[1]) - 1];
+                    texCoords = true;
+                }
                 auto& it = verts.emplace_back();
                 it.pos = vert;
                 it.normal = norm;
-                it.texCoord = {0.f, 0.f};
+                it.texCoord = texCoord;
                 counter++;
             }
 
@@ -80,6 +95,7 @@ Mesh::Mesh(VkDevice* logicalDev, VmaAllocator* allocator, VkPhysicalDevice* phys
             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
             VMA_MEMORY_USAGE_GPU_ONLY,
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    bounds = computeBoundingSphere();
 }
 
 size_t Mesh::idxOffset() const
@@ -87,11 +103,89 @@ size_t Mesh::idxOffset() const
     return verts.size() * sizeof(NVertex);
 }
 
+VertexLayout Mesh::vertexLayout() const
+{
+    return layout;
+}
+
+VertexStreams Mesh::vertexStreams() const
+{
+    return VertexStreams::of(layout, verts.size());
+}
+
 size_t Mesh::idxCount() const
 {
     return indices.size();
 }
 
+std::vector<NVertex> const& Mesh::vertices() const
+{
+    return verts;
+}
+
+std::vector<uint32_t> const& Mesh::vertexIndices() const
+{
+    return indices;
+}
+
+std::vector<glm::vec3> Mesh::positionStream() const
+{
+    std::vector<glm::vec3> positions;
+    positions.reserve(verts.size());
+    for (auto const& vert : verts)
+    {
+        positions.push_back(vert.pos);
+    }
+    return positions;
+}
+
+std::vector<VertexAttributes> Mesh::attributeStream() const
+{
+    std::vector<VertexAttributes> attributes;
+    attributes.reserve(verts.size());
+    for (auto const& vert : verts)
+    {
+        attributes.push_back({vert.normal, vert.texCoord});
+    }
+    return attributes;
+}
+
+bool Mesh::hasTexCoords() const
+{
+    return texCoords;
+}
+
+glm::vec4 Mesh::boundingSphere() const
+{
+    return bounds;
+}
+
+glm::vec4 Mesh::computeBoundingSphere() const
+{
+    if (verts.empty())
+    {
+        return glm::vec4(0.f);
+    }
+
+    // centered on the bounding box; not minimal, but cheap and conservative
+    glm::vec3 minPos = verts[0].pos;
+    glm::vec3 maxPos = verts[0].pos;
+    for (auto const& vert : verts)
+    {
+        minPos = glm::min(minPos, vert.pos);
+        maxPos = glm::max(maxPos, vert.pos);
+    }
+
+    glm::vec3 center = 0.5f * (minPos + maxPos);
+    float radius2 = 0.f;
+    for (auto const& vert : verts)
+    {
+        glm::vec3 dist = vert.pos - center;
+        radius2 = std::max(radius2, glm::dot(dist, dist));
+    }
+    return glm::vec4(center, std::sqrt(radius2));
+}
+
 std::shared_ptr<Buffers::StagingBuffer> Mesh::stagingBuffer(std::set<uint32_t> const& transferQueues)
 {
     auto vertSize = idxOffset();
@@ -101,7 +195,20 @@ std::shared_ptr<Buffers::StagingBuffer> Mesh::stagingBuffer(std::set<uint32_t> c
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
             transferQueues);
 
-    stg_ptr->loadData({{verts.data(), 0, vertSize}, {indices.data(), vertSize, idxSize}});
+    if (layout == VERTEX_LAYOUT_SPLIT_POSITIONS)
+    {
+        VertexStreams streams = vertexStreams();
+        std::vector<glm::vec3> positions = positionStream();
+        std::vector<VertexAttributes> attributes = attributeStream();
+        stg_ptr->loadData({
+                {positions.data(), streams.offsets[0], positions.size() * sizeof(glm::vec3)},
+                {attributes.data(), streams.offsets[1], attributes.size() * sizeof(VertexAttributes)},
+                {indices.data(), vertSize, idxSize}});
+    }
+    else
+    {
+        stg_ptr->loadData({{verts.data(), 0, vertSize}, {indices.data(), vertSize, idxSize}});
+    }
     return stg_ptr;
 }
 
@@ -110,6 +217,9 @@ Mesh::Mesh(Mesh&& mesh) noexcept:
         buf(std::move(mesh.buf)),
         verts(std::move(mesh.verts)),
         indices(std::move(mesh.indices)),
+        layout(mesh.layout),
+        texCoords(mesh.texCoords),
+        bounds(mesh.bounds),
         allocator(std::move(mesh.allocator)),
         physDev(std::move(mesh.physDev))
 {
@@ -121,6 +231,9 @@ Mesh& Mesh::operator=(Mesh&& mesh) noexcept
     buf = std::move(mesh.buf);
     verts = std::move(mesh.verts);
     indices = std::move(mesh.indices);
+    layout = mesh.layout;
+    texCoords = mesh.texCoords;
+    bounds = mesh.bounds;
 
     allocator = std::move(mesh.allocator);
     physDev = std::move(mesh.physDev);
@@ -0,0 +1,147 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "PipelineCache.h"
+#include <filesystem>
+#include <fstream>
+
+PipelineCache::PipelineCache(VkDevice* logicalDev, VkPhysicalDevice const& physDev, std::string path) :
+        AVkGraphicsBase(logicalDev), path(std::move(path))
+{
+    std::vector<char> initialData = loadFile(physDev);
+
+    VkPipelineCacheCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = initialData.size();
+    createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+    CHECK_VK_SUCCESS(
+            vkCreatePipelineCache(*logicalDev, &createInfo, nullptr, &cache),
+            "Cannot create pipeline cache!");
+    savedSize = initialData.size();
+}
+
+PipelineCache::PipelineCache(PipelineCache&& pipelineCache) noexcept :
+        AVkGraphicsBase(std::move(pipelineCache)), cache(pipelineCache.cache),
+        path(std::move(pipelineCache.path)), savedSize(pipelineCache.savedSize)
+{
+    pipelineCache.cache = VK_NULL_HANDLE;
+}
+
+PipelineCache& PipelineCache::operator=(PipelineCache&& pipelineCache) noexcept
+{
+    dispose();
+    cache = pipelineCache.cache;
+    path = std::move(pipelineCache.path);
+    savedSize = pipelineCache.savedSize;
+    pipelineCache.cache = VK_NULL_HANDLE;
+
+    AVkGraphicsBase::operator=(std::move(pipelineCache));
+    return *this;
+}
+
+PipelineCache::~PipelineCache()
+{
+    dispose();
+}
+
+void PipelineCache::dispose()
+{
+    if (initialized() && cache != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineCache(getLogicalDev(), cache, nullptr);
+        cache = VK_NULL_HANDLE;
+    }
+}
+
+std::vector<char> PipelineCache::loadFile(VkPhysicalDevice const& physDev) const
+{
+    if (path.empty())
+    {
+        return {};
+    }
+
+    std::ifstream file(path, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+    if (not file.is_open())
+    {
+        return {};
+    }
+
+    auto fileSize = static_cast<size_t>(file.tellg());
+    if (fileSize < sizeof(VkPipelineCacheHeaderVersionOne))
+    {
+        return {};
+    }
+
+    std::vector<char> data(fileSize);
+    file.seekg(0);
+    file.read(data.data(), static_cast<std::streamsize>(fileSize));
+    if (not file)
+    {
+        return {};
+    }
+
+    // drivers are meant to reject mismatched data themselves, but not all of them do
+    VkPipelineCacheHeaderVersionOne header = {};
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    VkPhysicalDeviceProperties properties = {};
+    vkGetPhysicalDeviceProperties(physDev, &properties);
+
+    if (header.headerSize < sizeof(header) ||
+        header.headerSize > fileSize ||
+        header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+        header.vendorID != properties.vendorID ||
+        header.deviceID != properties.deviceID ||
+        std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+    {
+        return {};
+    }
+    return data;
+}
+
+bool PipelineCache::save()
+{
+    if (path.empty() or not initialized())
+    {
+        return true;
+    }
+
+    // pipelines are only ever added, so an unchanged size means nothing new
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(getLogicalDev(), cache, &dataSize, nullptr) != VK_SUCCESS)
+    {
+        return false;
+    }
+    if (dataSize == savedSize)
+    {
+        return true;
+    }
+
+    std::vector<char> data(dataSize);
+    if (vkGetPipelineCacheData(getLogicalDev(), cache, &dataSize, data.data()) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+        file.write(data.data(), static_cast<std::streamsize>(dataSize));
+        if (not file)
+        {
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error)
+    {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    savedSize = dataSize;
+    return true;
+}
@@ -0,0 +1,303 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "PipelineManager.h"
+#include "SwapchainComponent.h"
+#include "GBuffer.h"
+
+PipelineManager::PipelineManager(
+        VkDevice* logicalDev,
+        VkPhysicalDevice const& physDev,
+        JobSystem& jobs,
+        VkPipelineCache const& pipelineCache,
+        VkPipelineLayout const& layout,
+        VkPipeline const& genericPipeline,
+        VkFormat const& colorFormat,
+        bool enableDepthTest,
+        DepthPrePass depthPrePass,
+        VertexLayout vertexLayout,
+        bool deferred,
+        bool useLibraries) :
+        AVkGraphicsBase(logicalDev), jobs(&jobs), pipelineCache(pipelineCache), layout(layout),
+        genericPipeline(genericPipeline),
+        fixedState(enableDepthTest, depthPrePass, vertexLayout, deferred ? GBuffer::COLOR_ATTACHMENT_COUNT : 1),
+        useLibraries(useLibraries)
+{
+    CHECK_VK_SUCCESS(
+            SwapchainComponents::createRenderPass(*logicalDev, physDev, colorFormat, renderPass, deferred),
+            ErrorMessages::FAILED_CREATE_RENDER_PASS);
+
+    variants[0].pipeline.store(genericPipeline);
+    variants[0].compiled.set_value(genericPipeline);
+    variants[0].future = variants[0].compiled.get_future().share();
+
+#if defined(VK_EXT_graphics_pipeline_library)
+    if (useLibraries)
+    {
+        // shared by every variant; both are cheap to build
+        vertexInputLibrary = createLibrary(VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT, nullptr);
+        fragmentOutputLibrary = createLibrary(VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT, nullptr);
+    }
+#else
+    this->useLibraries = false;
+#endif
+}
+
+PipelineManager::~PipelineManager()
+{
+    dispose();
+}
+
+void PipelineManager::dispose()
+{
+    if (not initialized())
+    {
+        return;
+    }
+
+    // compile jobs report failures through the futures, so waiting never throws
+    jobs->wait(compiles);
+
+    for (uint32_t i = 1; i < variantCount; ++i)
+    {
+        VkPipeline pipeline = variants[i].pipeline.load();
+        if (pipeline != VK_NULL_HANDLE)
+        {
+            vkDestroyPipeline(getLogicalDev(), pipeline, nullptr);
+        }
+    }
+    for (auto const& [key, library] : shaderLibraries)
+    {
+        vkDestroyPipeline(getLogicalDev(), library, nullptr);
+    }
+    shaderLibraries.clear();
+
+    if (vertexInputLibrary != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(getLogicalDev(), vertexInputLibrary, nullptr);
+    }
+    if (fragmentOutputLibrary != VK_NULL_HANDLE)
+    {
+        vkDestroyPipeline(getLogicalDev(), fragmentOutputLibrary, nullptr);
+    }
+    vkDestroyRenderPass(getLogicalDev(), renderPass, nullptr);
+}
+
+uint32_t PipelineManager::request(PipelineVariant const& variant)
+{
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lock(variantMutex);
+        auto it = variantIds.find(variant);
+        if (it != variantIds.end())
+        {
+            return it->second;
+        }
+        if (variantCount == MAX_VARIANTS)
+        {
+            return 0;
+        }
+
+        id = variantCount++;
+        variantIds.emplace(variant, id);
+        variants[id].future = variants[id].compiled.get_future().share();
+    }
+
+    pendingCompiles.fetch_add(1, std::memory_order_relaxed);
+    // on the background workers, so a compile never runs on a thread waiting for frame work
+    jobs->runBackground([this, id, variant]()
+    {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        try
+        {
+            pipeline = compile(variant);
+        }
+        catch (...)
+        {
+            // draws keep using the generic pipeline
+            pipeline = VK_NULL_HANDLE;
+        }
+
+        variants[id].pipeline.store(pipeline, std::memory_order_release);
+        variants[id].compiled.set_value(pipeline);
+        pendingCompiles.fetch_sub(1, std::memory_order_relaxed);
+    }, &compiles);
+    return id;
+}
+
+std::shared_future<VkPipeline> PipelineManager::future(uint32_t const& id) const
+{
+    // copied under the lock, since request may be assigning it on another thread
+    std::lock_guard<std::mutex> lock(variantMutex);
+    return variants[id].future;
+}
+
+VkPipeline PipelineManager::get(uint32_t const& id) const
+{
+    VkPipeline pipeline = variants[id].pipeline.load(std::memory_order_acquire);
+    return pipeline != VK_NULL_HANDLE ? pipeline : genericPipeline;
+}
+
+uint32_t PipelineManager::pending() const
+{
+    return pendingCompiles.load(std::memory_order_relaxed);
+}
+
+bool PipelineManager::usesLibraries() const
+{
+    return useLibraries;
+}
+
+VkPipeline PipelineManager::compile(PipelineVariant const& variant)
+{
+    return useLibraries ? linkLibraries(variant) : compileComplete(variant);
+}
+
+VkPipeline PipelineManager::compileComplete(PipelineVariant const& variant)
+{
+    PipelineShaderStage vertStage(getLogicalDev(), VK_SHADER_STAGE_VERTEX_BIT, variant.vertShader, variant.constants);
+    PipelineShaderStage fragStage(getLogicalDev(), VK_SHADER_STAGE_FRAGMENT_BIT, variant.fragShader, variant.constants);
+    VkPipelineShaderStageCreateInfo stages[] = {vertStage.info, fragStage.info};
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.stageCount = 2;
+    createInfo.pStages = stages;
+    fixedState.fill(createInfo);
+    createInfo.layout = layout;
+    createInfo.renderPass = renderPass;
+    createInfo.subpass = 0;
+    createInfo.basePipelineIndex = -1;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    CHECK_VK_SUCCESS(
+            vkCreateGraphicsPipelines(getLogicalDev(), pipelineCache, 1, &createInfo, nullptr, &pipeline),
+            ErrorMessages::CREATE_GRAPHICS_PIPELINE_FAILED);
+    return pipeline;
+}
+
+VkPipeline PipelineManager::linkLibraries(PipelineVariant const& variant)
+{
+#if defined(VK_EXT_graphics_pipeline_library)
+    std::array<VkPipeline, 4> libraries = {
+            vertexInputLibrary,
+            shaderLibrary(VK_SHADER_STAGE_VERTEX_BIT, variant.vertShader, variant.constants),
+            shaderLibrary(VK_SHADER_STAGE_FRAGMENT_BIT, variant.fragShader, variant.constants),
+            fragmentOutputLibrary
+    };
+
+    VkPipelineLibraryCreateInfoKHR libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR;
+    libraryInfo.libraryCount = static_cast<uint32_t>(libraries.size());
+    libraryInfo.pLibraries = libraries.data();
+
+    // no link-time optimization: that is the full compile the libraries are there to avoid
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.layout = layout;
+    createInfo.basePipelineIndex = -1;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    CHECK_VK_SUCCESS(
+            vkCreateGraphicsPipelines(getLogicalDev(), pipelineCache, 1, &createInfo, nullptr, &pipeline),
+            "Cannot link graphics pipeline!");
+    return pipeline;
+#else
+    return compileComplete(variant);
+#endif
+}
+
+VkPipeline PipelineManager::shaderLibrary(
+        VkShaderStageFlagBits const& stage, std::string const& fileName, std::vector<uint32_t> const& constants)
+{
+#if defined(VK_EXT_graphics_pipeline_library)
+    LibraryKey key = { stage, fileName, constants };
+    {
+        std::lock_guard<std::mutex> lock(libraryMutex);
+        auto it = shaderLibraries.find(key);
+        if (it != shaderLibraries.end())
+        {
+            return it->second;
+        }
+    }
+
+    // built outside the lock; when two compiles race for the same library, the first one in wins
+    PipelineShaderStage shaderStage(getLogicalDev(), stage, fileName, constants);
+    VkPipeline library = createLibrary(
+            stage == VK_SHADER_STAGE_VERTEX_BIT ?
+            VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT :
+            VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+            &shaderStage);
+
+    std::lock_guard<std::mutex> lock(libraryMutex);
+    auto [it, inserted] = shaderLibraries.emplace(std::move(key), library);
+    if (not inserted)
+    {
+        vkDestroyPipeline(getLogicalDev(), library, nullptr);
+    }
+    return it->second;
+#else
+    (void) stage;
+    (void) fileName;
+    (void) constants;
+    return VK_NULL_HANDLE;
+#endif
+}
+
+VkPipeline PipelineManager::createLibrary(uint32_t const& flags, PipelineShaderStage const* stage)
+{
+#if defined(VK_EXT_graphics_pipeline_library)
+    VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {};
+    libraryInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT;
+    libraryInfo.flags = flags;
+
+    VkGraphicsPipelineCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    createInfo.pNext = &libraryInfo;
+    createInfo.flags = VK_PIPELINE_CREATE_LIBRARY_BIT_KHR;
+    createInfo.basePipelineIndex = -1;
+
+    // each part only reads the state that belongs to it
+    if (flags & VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT)
+    {
+        createInfo.pVertexInputState = &fixedState.vertexInput;
+        createInfo.pInputAssemblyState = &fixedState.inputAssembly;
+    }
+    if (flags & VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT)
+    {
+        createInfo.pViewportState = &fixedState.viewportState;
+        createInfo.pRasterizationState = &fixedState.rasterizer;
+        createInfo.pDynamicState = &fixedState.dynamicState;
+    }
+    if (flags & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT)
+    {
+        createInfo.pDepthStencilState = &fixedState.depthStencil;
+        createInfo.pMultisampleState = &fixedState.multisample;
+    }
+    if (flags & VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT)
+    {
+        createInfo.pColorBlendState = &fixedState.colorBlend;
+        createInfo.pMultisampleState = &fixedState.multisample;
+    }
+    if (stage != nullptr)
+    {
+        createInfo.stageCount = 1;
+        createInfo.pStages = &stage->info;
+        createInfo.layout = layout;
+    }
+    createInfo.renderPass = renderPass;
+    createInfo.subpass = 0;
+
+    VkPipeline library = VK_NULL_HANDLE;
+    CHECK_VK_SUCCESS(
+            vkCreateGraphicsPipelines(getLogicalDev(), pipelineCache, 1, &createInfo, nullptr, &library),
+            "Cannot create pipeline library!");
+    return library;
+#else
+    (void) flags;
+    (void) stage;
+    return VK_NULL_HANDLE;
+#endif
+}
@@ -0,0 +1,112 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "PresentThread.h"
+
+PresentThread::PresentThread(VkQueue presentQueue) :
+        queue(presentQueue), thread(&PresentThread::presentLoop, this)
+{
+}
+
+PresentThread::~PresentThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        stopping = true;
+    }
+    requestQueued.notify_one();
+    thread.join();
+}
+
+void PresentThread::present(VkSwapchainKHR swapchain, uint32_t const& imageIdx, VkSemaphore waitSemaphore)
+{
+    {
+        std::lock_guard<std::mutex> lock(requestMutex);
+        requests.push_back({ swapchain, imageIdx, waitSemaphore });
+        ++queuedCount;
+    }
+    requestQueued.notify_one();
+}
+
+void PresentThread::waitForIssued(uint64_t const& count)
+{
+    std::unique_lock<std::mutex> lock(requestMutex);
+    requestIssued.wait(lock, [this, count]() { return issuedCount >= count or failed; });
+    if (failed)
+    {
+        throw std::runtime_error("Cannot present image!");
+    }
+}
+
+void PresentThread::drain()
+{
+    waitForIssued(queued());
+}
+
+uint64_t PresentThread::queued() const
+{
+    std::lock_guard<std::mutex> lock(requestMutex);
+    return queuedCount;
+}
+
+bool PresentThread::takeOutOfDate()
+{
+    std::lock_guard<std::mutex> lock(requestMutex);
+    bool result = outOfDate;
+    outOfDate = false;
+    return result;
+}
+
+std::mutex& PresentThread::swapchainMutex()
+{
+    return swapchainLock;
+}
+
+void PresentThread::presentLoop()
+{
+    while (true)
+    {
+        PresentRequest request = {};
+        {
+            std::unique_lock<std::mutex> lock(requestMutex);
+            requestQueued.wait(lock, [this]() { return stopping or not requests.empty(); });
+            if (requests.empty())
+            {
+                // stopping, with nothing left to present
+                return;
+            }
+            request = requests.front();
+            requests.pop_front();
+        }
+
+        VkPresentInfoKHR presentInfo = {};
+        presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = 1;
+        presentInfo.pWaitSemaphores = &request.waitSemaphore;
+        presentInfo.swapchainCount = 1;
+        presentInfo.pSwapchains = &request.swapchain;
+        presentInfo.pImageIndices = &request.imageIdx;
+        presentInfo.pResults = nullptr;
+
+        VkResult presentResult;
+        {
+            std::lock_guard<std::mutex> lock(swapchainLock);
+            presentResult = vkQueuePresentKHR(queue, &presentInfo);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(requestMutex);
+            ++issuedCount;
+            if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR)
+            {
+                outOfDate = true;
+            }
+            else if (presentResult != VK_SUCCESS)
+            {
+                failed = true;
+            }
+        }
+        requestIssued.notify_all();
+    }
+}
@@ -5,7 +5,7 @@
 #include "QueueFamilies.h"
 
 QueueFamilies::QueueFamilies(VkPhysicalDevice const& dev, VkSurfaceKHR const& surf) :
-    graphicsFamily(nullopt), presentationFamily(nullopt), transferFamily(nullopt)
+    graphicsFamily(nullopt), presentationFamily(nullopt), transferFamily(nullopt), computeFamily(nullopt)
 {
     uint32_t queueFamilyCount = 0;
     vkGetPhysicalDeviceQueueFamilyProperties(dev, &queueFamilyCount, nullptr);
@@ -45,6 +45,14 @@ QueueFamilies::QueueFamilies(VkPhysicalDevice const& dev, VkSurfaceKHR const& su
                 possibleTransferQueues.emplace_back(i);
             }
         }
+
+        if (queueFlags & VK_QUEUE_COMPUTE_BIT
+            && not (queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            && not computeFamily.has_value())
+        {
+            // async compute; otherwise compute work goes to the graphics family
+            computeFamily = i;
+        }
     }
 
     if (!transferFamily.has_value() && !possibleTransferQueues.empty())
@@ -64,7 +72,17 @@ uint32_t QueueFamilies::transferQueueFamily()
     return transferFamily.value_or(graphicsFamily.value());
 }
 
+uint32_t QueueFamilies::computeQueueFamily()
+{
+    return computeFamily.value_or(graphicsFamily.value());
+}
+
 std::set<uint32_t> QueueFamilies::queuesForTransfer()
 {
     return std::set<uint32_t> { graphicsFamily.value(), transferQueueFamily() };
 }
+
+std::set<uint32_t> QueueFamilies::queuesForCompute()
+{
+    return std::set<uint32_t> { graphicsFamily.value(), computeQueueFamily() };
+}
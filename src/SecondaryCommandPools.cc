@@ -0,0 +1,142 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "SecondaryCommandPools.h"
+
+SecondaryCommandPools::SecondaryCommandPools(
+        VkDevice* logicalDev, uint32_t const& graphicsFamily, uint32_t const& workerCount, uint32_t const& passCount) :
+        AVkGraphicsBase(logicalDev), workers(workerCount), passes(passCount)
+{
+    CHECK_VK_SUCCESS(createPools(graphicsFamily), ErrorMessages::CREATE_COMMAND_POOL_FAILED);
+}
+
+SecondaryCommandPools::SecondaryCommandPools(SecondaryCommandPools&& pools) noexcept :
+        AVkGraphicsBase(std::move(pools)),
+        workers(pools.workers),
+        passes(pools.passes),
+        cmdPools(std::move(pools.cmdPools)),
+        cmdBuffers(std::move(pools.cmdBuffers))
+{
+    pools.workers = 0;
+    pools.cmdPools.clear();
+    pools.cmdBuffers.clear();
+}
+
+SecondaryCommandPools& SecondaryCommandPools::operator=(SecondaryCommandPools&& pools) noexcept
+{
+    dispose();
+
+    workers = pools.workers;
+    passes = pools.passes;
+    cmdPools = std::move(pools.cmdPools);
+    cmdBuffers = std::move(pools.cmdBuffers);
+
+    pools.workers = 0;
+    pools.cmdPools.clear();
+    pools.cmdBuffers.clear();
+
+    AVkGraphicsBase::operator=(std::move(pools));
+    return *this;
+}
+
+SecondaryCommandPools::~SecondaryCommandPools()
+{
+    dispose();
+}
+
+void SecondaryCommandPools::dispose()
+{
+    if (initialized())
+    {
+        // command buffers are freed along with their pools
+        for (auto& pool : cmdPools)
+        {
+            vkDestroyCommandPool(getLogicalDev(), pool, nullptr);
+        }
+        cmdPools.clear();
+        cmdBuffers.clear();
+    }
+}
+
+VkResult SecondaryCommandPools::createPools(uint32_t const& graphicsFamily)
+{
+    cmdPools.resize(MAX_FRAMES_IN_FLIGHT * workers, VK_NULL_HANDLE);
+    cmdBuffers.resize(cmdPools.size() * passes, VK_NULL_HANDLE);
+
+    for (size_t i = 0; i < cmdPools.size(); ++i)
+    {
+        VkCommandPoolCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        createInfo.queueFamilyIndex = graphicsFamily;
+        // buffers are re-recorded every frame and only ever reset with the whole pool
+        createInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+        VkResult ret = vkCreateCommandPool(getLogicalDev(), &createInfo, nullptr, &cmdPools[i]);
+        if (ret != VK_SUCCESS)
+        {
+            return ret;
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo = {};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool = cmdPools[i];
+        allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocateInfo.commandBufferCount = passes;
+
+        ret = vkAllocateCommandBuffers(getLogicalDev(), &allocateInfo, &cmdBuffers[i * passes]);
+        if (ret != VK_SUCCESS)
+        {
+            return ret;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+uint32_t SecondaryCommandPools::workerCount() const
+{
+    return workers;
+}
+
+VkResult SecondaryCommandPools::resetFrame(uint32_t const& frameIdx)
+{
+    for (uint32_t i = 0; i < workers; ++i)
+    {
+        VkResult ret = vkResetCommandPool(getLogicalDev(), cmdPools[frameIdx * workers + i], 0);
+        if (ret != VK_SUCCESS)
+        {
+            return ret;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+VkResult SecondaryCommandPools::begin(
+        uint32_t const& frameIdx,
+        uint32_t const& workerIdx,
+        uint32_t const& passIdx,
+        VkRenderPass const& renderPass,
+        VkFramebuffer const& framebuffer,
+        VkCommandBuffer& cmdBuf)
+{
+    cmdBuf = cmdBuffer(frameIdx, workerIdx, passIdx);
+
+    VkCommandBufferInheritanceInfo inheritanceInfo = {};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.renderPass = renderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = framebuffer;
+
+    VkCommandBufferBeginInfo beginInfo = {};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    return vkBeginCommandBuffer(cmdBuf, &beginInfo);
+}
+
+VkCommandBuffer const& SecondaryCommandPools::cmdBuffer(
+        uint32_t const& frameIdx, uint32_t const& workerIdx, uint32_t const& passIdx) const
+{
+    return cmdBuffers[(frameIdx * workers + workerIdx) * passes + passIdx];
+}
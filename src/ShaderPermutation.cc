@@ -0,0 +1,68 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "ShaderPermutation.h"
+#include <boost/functional/hash.hpp>
+
+ShaderPermutation ShaderPermutation::forLights(std::vector<Light> const& lights)
+{
+    ShaderPermutation permutation;
+    permutation.lightTypes = 0;
+    for (auto const& light : lights)
+    {
+        permutation.lightTypes |= 1u << light.lightType;
+    }
+
+    auto lightCount = static_cast<uint32_t>(std::min<size_t>(lights.size(), MAX_LIGHTS));
+    permutation.maxLights = 0;
+    if (lightCount > 0)
+    {
+        permutation.maxLights = 1;
+        while (permutation.maxLights < lightCount)
+        {
+            permutation.maxLights <<= 1;
+        }
+    }
+    return permutation;
+}
+
+ShaderPermutation ShaderPermutation::withMaterial(glm::vec4 const& params) const
+{
+    ShaderPermutation permutation = *this;
+    // the diffuse variant only matches the generic one for materials that turn the lobe off
+    bool specular = params.w != 0;
+    permutation.materialFeatures = specular ? MATERIAL_SPECULAR : 0;
+    return permutation;
+}
+
+std::vector<uint32_t> ShaderPermutation::constants() const
+{
+    return { lightTypes, maxLights };
+}
+
+PipelineVariant ShaderPermutation::pipelineVariant(std::string const& baseName) const
+{
+    std::string fragVariant = (materialFeatures & MATERIAL_SPECULAR) ? "" : ".diffuse";
+    return {
+            baseName + ".vert.spv",
+            baseName + fragVariant + ".frag.spv",
+            constants()
+    };
+}
+
+bool ShaderPermutation::operator==(ShaderPermutation const& other) const
+{
+    return lightTypes == other.lightTypes &&
+           maxLights == other.maxLights &&
+           materialFeatures == other.materialFeatures;
+}
+
+size_t ShaderPermutation::hash() const
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, lightTypes);
+    boost::hash_combine(seed, maxLights);
+    boost::hash_combine(seed, materialFeatures);
+    return seed;
+}
@@ -3,42 +3,58 @@
 //
 #include "common.h"
 #include <fstream>
-#include <sstream>
 #include "Shaders.h"
+#include "helpers.h"
 
 namespace Shaders
 {
-    std::vector<uint8_t> readBytecode(std::string const& fileName)
+    namespace
     {
-        std::ifstream file;
-        file.open(fileName, std::ifstream::in | std::ifstream::binary);
-        std::stringstream byteSrc;
+        std::string overrideDirectory;
+    }
 
-        if (file)
+    void setOverrideDirectory(std::string const& dir)
+    {
+        overrideDirectory = dir;
+    }
+
+    EmbeddedShader const* findEmbedded(std::string const& fileName)
+    {
+        for (size_t i = 0; i < embeddedShaderCount; ++i)
         {
-            byteSrc << file.rdbuf();
-            file.close();
+            if (fileName == embeddedShaders[i].name)
+            {
+                return &embeddedShaders[i];
+            }
         }
-        else
+        return nullptr;
+    }
+
+    std::vector<uint8_t> readBytecode(std::string const& fileName)
+    {
+        std::ifstream file(fileName, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+        if (not file)
         {
             throw std::runtime_error("Cannot load shader file!");
         }
 
-        std::vector<uint8_t> outchr;
-        std::string const& outchrTmp = byteSrc.str();
-        outchr.reserve(outchrTmp.size());
-        outchr.assign(outchrTmp.begin(), outchrTmp.end());
-
+        std::vector<uint8_t> outchr(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(outchr.data()), static_cast<std::streamsize>(outchr.size()));
+        if (not file)
+        {
+            throw std::runtime_error("Cannot load shader file!");
+        }
         return outchr;
     }
 
     std::pair<VkShaderModule, VkResult>
-    createShaderModule(VkDevice const& logicalDev, std::vector<uint8_t> const& spvSource)
+    createShaderModule(VkDevice const& logicalDev, uint32_t const* code, size_t const& codeSize)
     {
         VkShaderModuleCreateInfo createInfo = {};
         createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-        createInfo.codeSize = spvSource.size();
-        createInfo.pCode = reinterpret_cast<uint32_t const*>(spvSource.data());
+        createInfo.codeSize = codeSize;
+        createInfo.pCode = code;
 
         VkShaderModule shaderModule;
         VkResult ret = vkCreateShaderModule(
@@ -46,9 +62,26 @@ namespace Shaders
         return std::make_pair(shaderModule, ret);
     }
 
+    std::pair<VkShaderModule, VkResult>
+    createShaderModule(VkDevice const& logicalDev, std::vector<uint8_t> const& spvSource)
+    {
+        return createShaderModule(
+                logicalDev, reinterpret_cast<uint32_t const*>(spvSource.data()), spvSource.size());
+    }
+
     std::tuple<VkShaderModule, VkResult>
     createShaderModule(VkDevice const& logicalDev, std::string const& fileName)
     {
-        return createShaderModule(logicalDev, readBytecode(fileName));
+        if (not overrideDirectory.empty())
+        {
+            return createShaderModule(logicalDev, readBytecode(overrideDirectory + "/" + fileName));
+        }
+
+        EmbeddedShader const* embedded = findEmbedded(fileName);
+        if (embedded != nullptr)
+        {
+            return createShaderModule(logicalDev, embedded->code, embedded->codeSize);
+        }
+        return createShaderModule(logicalDev, readBytecode(helpers::searchPath(fileName)));
     }
-};
\ No newline at end of file
+};
@@ -4,12 +4,14 @@
 
 #include "SwapchainComponent.h"
 #include "Image.h"
+#include "GBuffer.h"
 
 VkResult
 SwapchainComponents::initSwapChain(
         VkPhysicalDevice const& physDevice,
         std::pair <size_t, size_t> const& windowHeight,
-        VkSurfaceKHR const& surface)
+        VkSurfaceKHR const& surface,
+        VkSwapchainKHR oldSwapchain)
 {
 
     if (!detail.adequate())
@@ -69,15 +71,28 @@ SwapchainComponents::initSwapChain(
     createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
     createInfo.presentMode = detail.chooseSwapPresentMode();
     createInfo.clipped = VK_TRUE;
-    createInfo.oldSwapchain = VK_NULL_HANDLE;
+    // lets the presentation engine hand resources over, and keeps images already
+    // acquired from the old swapchain presentable
+    createInfo.oldSwapchain = oldSwapchain;
 
     return vkCreateSwapchainKHR(getLogicalDev(), &createInfo, nullptr, &swapChain);
 }
 
-VkResult SwapchainComponents::createRenderPasses(VkPhysicalDevice const& physDevice)
+VkResult SwapchainComponents::createRenderPasses(VkPhysicalDevice const& physDevice, bool const& deferred)
+{
+    return createRenderPass(getLogicalDev(), physDevice, swapchainFormat.format, renderPass, deferred);
+}
+
+// static
+VkResult SwapchainComponents::createRenderPass(
+        VkDevice const& logicalDev,
+        VkPhysicalDevice const& physDevice,
+        VkFormat const& colorFormat,
+        VkRenderPass& renderPass,
+        bool const& deferred)
 {
     VkAttachmentDescription colorAttachment = {};
-    colorAttachment.format = swapchainFormat.format;
+    colorAttachment.format = colorFormat;
     colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
     colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
@@ -121,27 +136,80 @@ VkResult SwapchainComponents::createRenderPasses(VkPhysicalDevice const& physDev
             colorAttachment,
             depthAttachment
             };
+    std::vector<VkSubpassDescription> subpasses = { subpass };
+    std::vector<VkSubpassDependency> dependencies = { dep };
+
+    // deferred: subpass 0 fills the G-buffer (attachments 2 onwards) and depth, then
+    // subpass 1 reads them back as input attachments and shades into the swapchain image.
+    // Nothing of the G-buffer is loaded or stored, so tiled GPUs never write it out
+    std::vector<VkAttachmentReference> gbufferRefs;
+    std::vector<VkAttachmentReference> inputRefs;
+    if (deferred)
+    {
+        for (uint32_t i = 0; i < GBuffer::COLOR_ATTACHMENT_COUNT; ++i)
+        {
+            VkAttachmentDescription& gbufferAttachment = attachments.emplace_back();
+            gbufferAttachment.format = GBuffer::FORMATS[i];
+            gbufferAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+            gbufferAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            gbufferAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            gbufferAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            gbufferAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            gbufferAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+            gbufferAttachment.finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            auto attachment = static_cast<uint32_t>(attachments.size() - 1);
+            gbufferRefs.push_back({ attachment, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL });
+            inputRefs.push_back({ attachment, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL });
+        }
+        // input attachment bindings follow GBuffer: the color attachments, then depth
+        inputRefs.push_back({ depthAttachmentRef.attachment, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL });
+
+        subpasses[0].colorAttachmentCount = static_cast<uint32_t>(gbufferRefs.size());
+        subpasses[0].pColorAttachments = gbufferRefs.data();
+
+        VkSubpassDescription& lightingSubpass = subpasses.emplace_back();
+        lightingSubpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        lightingSubpass.inputAttachmentCount = static_cast<uint32_t>(inputRefs.size());
+        lightingSubpass.pInputAttachments = inputRefs.data();
+        lightingSubpass.colorAttachmentCount = 1;
+        lightingSubpass.pColorAttachments = &colorAttachmentRef;
+
+        // by region: each pixel only reads what the geometry subpass wrote to that pixel
+        VkSubpassDependency& gbufferDep = dependencies.emplace_back();
+        gbufferDep.srcSubpass = 0;
+        gbufferDep.dstSubpass = 1;
+        gbufferDep.srcStageMask =
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        gbufferDep.srcAccessMask =
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        gbufferDep.dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+        gbufferDep.dstAccessMask = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT;
+        gbufferDep.dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+    }
 
     VkRenderPassCreateInfo renderPassCreateInfo = {};
     renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
     renderPassCreateInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
     renderPassCreateInfo.pAttachments = attachments.data();
-    renderPassCreateInfo.subpassCount = 1;
-    renderPassCreateInfo.pSubpasses = &subpass;
-    renderPassCreateInfo.dependencyCount = 1;
-    renderPassCreateInfo.pDependencies = &dep;
+    renderPassCreateInfo.subpassCount = static_cast<uint32_t>(subpasses.size());
+    renderPassCreateInfo.pSubpasses = subpasses.data();
+    renderPassCreateInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    renderPassCreateInfo.pDependencies = dependencies.data();
 
-    return vkCreateRenderPass(getLogicalDev(), &renderPassCreateInfo, nullptr, &renderPass);
+    return vkCreateRenderPass(logicalDev, &renderPassCreateInfo, nullptr, &renderPass);
 }
 
 SwapchainComponents::SwapchainComponents(
         VkDevice* logicalDev, VkPhysicalDevice const& physDevice,
         VkSurfaceKHR const& surface, std::pair<size_t, size_t> const& windowSize,
-        std::optional<VkImageView> const& depthBufferImgView) :
+        std::optional<VkImageView> const& depthBufferImgView,
+        VkSwapchainKHR oldSwapchain,
+        std::vector<VkImageView> const& gbufferViews) :
             AVkGraphicsBase(logicalDev), detail(physDevice, surface)
 {
     CHECK_VK_SUCCESS(
-            initSwapChain(physDevice, windowSize, surface),
+            initSwapChain(physDevice, windowSize, surface, oldSwapchain),
             ErrorMessages::FAILED_CREATE_SWAP_CHAIN);
 
     // get swap chain image
@@ -150,18 +218,18 @@ SwapchainComponents::SwapchainComponents(
     swapChainImages.resize(imageCount);
     vkGetSwapchainImagesKHR(*logicalDev, swapChain, &imageCount, swapChainImages.data());
 
-    CHECK_VK_SUCCESS(createRenderPasses(physDevice), ErrorMessages::FAILED_CREATE_RENDER_PASS);
+    CHECK_VK_SUCCESS(
+            createRenderPasses(physDevice, not gbufferViews.empty()),
+            ErrorMessages::FAILED_CREATE_RENDER_PASS);
 
     std::transform(swapChainImages.begin(), swapChainImages.end(),
                    std::back_inserter(swapchainSupport),
-                   [this, &fmt=swapchainFormat.format, &depthBufferImgView](VkImage& swapChainImg)
+                   [this, &fmt=swapchainFormat.format, &depthBufferImgView, &gbufferViews](VkImage& swapChainImg)
                    {
                        return SwapchainImageSupport(
                                this->getLogicalDevPtr(), this->renderPass, this->swapchainExtent,
-                               swapChainImg, fmt, depthBufferImgView);
+                               swapChainImg, fmt, depthBufferImgView, gbufferViews);
                    });
-
-    CHECK_VK_SUCCESS(createDescriptorPool(), ErrorMessages::FAILED_CANNOT_CREATE_DESC_POOL);
 }
 
 SwapchainComponents::SwapchainComponents(SwapchainComponents&& swpchainComp) noexcept:
@@ -172,8 +240,7 @@ SwapchainComponents::SwapchainComponents(SwapchainComponents&& swpchainComp) noe
         swapchainFormat(std::move(swpchainComp.swapchainFormat)),
         swapchainExtent(std::move(swpchainComp.swapchainExtent)),
         swapchainSupport(std::move(swpchainComp.swapchainSupport)),
-        renderPass(std::move(swpchainComp.renderPass)),
-        descriptorPool(std::move(swpchainComp.descriptorPool))
+        renderPass(std::move(swpchainComp.renderPass))
 {
 }
 
@@ -181,7 +248,6 @@ SwapchainComponents& SwapchainComponents::operator=(SwapchainComponents&& swpcha
 {
     if (initialized())
     {
-        vkDestroyDescriptorPool(getLogicalDev(), descriptorPool, nullptr);
         vkDestroyRenderPass(getLogicalDev(), renderPass, nullptr);
         vkDestroySwapchainKHR(getLogicalDev(), swapChain, nullptr);
     }
@@ -193,7 +259,6 @@ SwapchainComponents& SwapchainComponents::operator=(SwapchainComponents&& swpcha
     swapchainExtent = std::move(swpchainComp.swapchainExtent);
     swapchainSupport = std::move(swpchainComp.swapchainSupport);
     renderPass = std::move(swpchainComp.renderPass);
-    descriptorPool = std::move(swpchainComp.descriptorPool);
 
     AVkGraphicsBase::operator=(std::move(swpchainComp));
     return *this;
@@ -203,7 +268,6 @@ SwapchainComponents::~SwapchainComponents()
 {
     if (initialized())
     {
-        vkDestroyDescriptorPool(getLogicalDev(), descriptorPool, nullptr);
         vkDestroyRenderPass(getLogicalDev(), renderPass, nullptr);
         vkDestroySwapchainKHR(getLogicalDev(), swapChain, nullptr);
     }
@@ -213,31 +277,3 @@ uint32_t SwapchainComponents::imageCount() const
 {
     return static_cast<uint32_t>(swapChainImages.size());
 }
-
-VkResult SwapchainComponents::createDescriptorPool()
-{
-
-
-    VkDescriptorPoolSize poolSize[4] = {{}, {}, {}, {}};
-    poolSize[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    poolSize[0].descriptorCount = imageCount();
-
-    poolSize[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSize[1].descriptorCount = imageCount();
-
-    poolSize[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    poolSize[2].descriptorCount = imageCount();
-
-    poolSize[3].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-    poolSize[3].descriptorCount = imageCount();
-
-
-    VkDescriptorPoolCreateInfo createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    createInfo.poolSizeCount = 4;
-    createInfo.pPoolSizes = poolSize;
-    createInfo.maxSets = 3 * imageCount();
-
-    return vkCreateDescriptorPool(getLogicalDev(), &createInfo, nullptr, &descriptorPool);
-
-}
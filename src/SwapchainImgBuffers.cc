@@ -6,71 +6,64 @@
 
 void SwapchainImageBuffers::configureBuffers(uint32_t const& binding, Image::Image& img)
 {
+    FrameDescriptorData descData = {};
+    descData.image.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    descData.image.imageView = img.imgView;
+    descData.image.sampler = img.baseSampler;
+
     for (uint32_t i = 0; i < imgSize; ++i)
     {
-        VkDescriptorImageInfo imageInfo = {};
-        imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-        imageInfo.imageView = img.imgView;
-        imageInfo.sampler = img.baseSampler;
-
-        VkWriteDescriptorSet descriptorWriteImg = {};
-        descriptorWriteImg.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWriteImg.dstSet = descriptorSets[i];
-        descriptorWriteImg.dstBinding = 1;
-        descriptorWriteImg.dstArrayElement = 0;
-        descriptorWriteImg.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        descriptorWriteImg.descriptorCount = 1;
-        descriptorWriteImg.pImageInfo = &imageInfo;
-
-        VkDescriptorBufferInfo sboBufferInfo = {};
-        sboBufferInfo.buffer = lightSBOs[i].vertexBuffer;
-        sboBufferInfo.offset = 0;
-        sboBufferInfo.range = lightSBOs[i].getSize();
-
-        VkWriteDescriptorSet descriptorWriteSBO = {};
-        descriptorWriteSBO.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWriteSBO.dstSet = descriptorSets[i];
-        descriptorWriteSBO.dstBinding = 2;
-        descriptorWriteSBO.dstArrayElement = 0;
-        descriptorWriteSBO.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        descriptorWriteSBO.descriptorCount = 1;
-        descriptorWriteSBO.pBufferInfo = &sboBufferInfo;
-
-        std::vector<VkWriteDescriptorSet> descriptorWriteInfo = {
-                UniformObjects::descriptorWrite(0, unifBuffers[i].bufferInfo(), descriptorSets[i]),
-                descriptorWriteImg, descriptorWriteSBO};
-
-        vkUpdateDescriptorSets(
-                getLogicalDev(), static_cast<uint32_t>(descriptorWriteInfo.size()),
-                descriptorWriteInfo.data(), 0, nullptr);
+        descData.uniforms = unifBuffers[i].bufferInfo();
+
+        descData.lights.buffer = lightBuffers[i].vertexBuffer;
+        descData.lights.offset = 0;
+        descData.lights.range = lightBuffers[i].getSize();
+
+        descData.clusters.buffer = clusterBuffers[i].vertexBuffer;
+        descData.clusters.offset = 0;
+        descData.clusters.range = clusterBuffers[i].getSize();
+
+        frameUpdateTemplate.update(descriptorSets[i], descData);
     }
 }
 
 void SwapchainImageBuffers::configureMeshBuffers(uint32_t const& binding, DynUniformObjBuffer<MeshUniform> const& unif)
 {
+    MeshDescriptorData descData = {};
+    descData.meshUniform.buffer = unif.vertexBuffer;
+    descData.meshUniform.offset = 0;
+    descData.meshUniform.range = sizeof(MeshUniform);
+
     for (uint32_t i = 0; i < imgSize; ++i)
     {
-        VkDescriptorBufferInfo sboBufferInfo = {};
-        sboBufferInfo.buffer = unif.vertexBuffer;
-        sboBufferInfo.offset = 0;
-        sboBufferInfo.range = sizeof(MeshUniform);
-
-        VkWriteDescriptorSet descriptorWriteSBO = {};
-        descriptorWriteSBO.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptorWriteSBO.dstSet = meshDescriptorSets[i];
-        descriptorWriteSBO.dstBinding = 0;
-        descriptorWriteSBO.dstArrayElement = 0;
-        descriptorWriteSBO.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-        descriptorWriteSBO.descriptorCount = 1;
-        descriptorWriteSBO.pBufferInfo = &sboBufferInfo;
-
-        vkUpdateDescriptorSets(
-                getLogicalDev(), 1,
-                &descriptorWriteSBO, 0, nullptr);
+        meshUpdateTemplate.update(meshDescriptorSets[i], descData);
     }
 }
 
-VkResult SwapchainImageBuffers::createDescriptorSetLayout()
+void SwapchainImageBuffers::createUpdateTemplates()
+{
+    frameUpdateTemplate = DescriptorUpdateTemplate(
+            getLogicalDevPtr(), descriptorSetLayout,
+            {
+                DescriptorUpdateTemplate::entry(
+                        0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, offsetof(FrameDescriptorData, uniforms)),
+                DescriptorUpdateTemplate::entry(
+                        1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, offsetof(FrameDescriptorData, image)),
+                DescriptorUpdateTemplate::entry(
+                        2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, offsetof(FrameDescriptorData, lights)),
+                DescriptorUpdateTemplate::entry(
+                        3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, offsetof(FrameDescriptorData, clusters))
+            });
+
+    meshUpdateTemplate = DescriptorUpdateTemplate(
+            getLogicalDevPtr(), meshDescriptorSetLayout,
+            {
+                DescriptorUpdateTemplate::entry(
+                        0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, offsetof(MeshDescriptorData, meshUniform))
+            });
+}
+
+void SwapchainImageBuffers::createDescriptorSetLayout(DescriptorLayoutCache& layoutCache)
 {
 
     VkDescriptorSetLayoutBinding imgBindingData = {};
@@ -80,60 +73,43 @@ VkResult SwapchainImageBuffers::createDescriptorSetLayout()
     imgBindingData.pImmutableSamplers = nullptr;
     imgBindingData.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
 
-    std::vector<VkDescriptorSetLayoutBinding> bindings = {
-            UniformObjects::descriptorSetLayout(0),
-            imgBindingData,
-            StorageBufferArray<Light>::DescriptorSetLayout(2)
-    };
+    VkDescriptorSetLayoutBinding lightBindingData = {};
+    lightBindingData.binding = 2;
+    lightBindingData.descriptorCount = 1;
+    lightBindingData.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    lightBindingData.pImmutableSamplers = nullptr;
+    lightBindingData.stageFlags = Light::stageFlags();
 
-    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
-    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
-    layoutInfo.pBindings = bindings.data();
+    // written by the clustering pass, read by the fragment shaders
+    VkDescriptorSetLayoutBinding clusterBindingData = lightBindingData;
+    clusterBindingData.binding = 3;
+    clusterBindingData.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
 
-    return vkCreateDescriptorSetLayout(getLogicalDev(), &layoutInfo, nullptr, &descriptorSetLayout);
+    descriptorSetLayout = layoutCache.getLayout({
+            UniformObjects::descriptorSetLayout(0),
+            imgBindingData,
+            lightBindingData,
+            clusterBindingData
+    });
 }
 
-VkResult SwapchainImageBuffers::createDescriptorSets(SwapchainComponents const& swapchainComponent)
+VkResult SwapchainImageBuffers::createDescriptorSets(DescriptorAllocator& descAllocator)
 {
     std::vector<VkDescriptorSetLayout> layouts(imgSize, descriptorSetLayout);
-
-    VkDescriptorSetAllocateInfo createInfo = {};
-
-    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    createInfo.descriptorPool = swapchainComponent.descriptorPool;
-    createInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
-    createInfo.pSetLayouts = layouts.data();
-    descriptorSets.resize(imgSize);
-    return vkAllocateDescriptorSets(getLogicalDev(), &createInfo, descriptorSets.data());
+    return descAllocator.allocate(layouts, descriptorSets);
 }
 
-VkResult SwapchainImageBuffers::createMeshDescriptorSetLayout()
+void SwapchainImageBuffers::createMeshDescriptorSetLayout(DescriptorLayoutCache& layoutCache)
 {
-    std::vector<VkDescriptorSetLayoutBinding> bindings = {
+    meshDescriptorSetLayout = layoutCache.getLayout({
             MeshUniform::descriptorSetLayout(0)
-    };
-
-    VkDescriptorSetLayoutCreateInfo layoutInfo = {};
-    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
-    layoutInfo.pBindings = bindings.data();
-
-    return vkCreateDescriptorSetLayout(getLogicalDev(), &layoutInfo, nullptr, &meshDescriptorSetLayout);
+    });
 }
 
-VkResult SwapchainImageBuffers::createMeshDescriptorSets(VkDescriptorPool const& descPool)
+VkResult SwapchainImageBuffers::createMeshDescriptorSets(DescriptorAllocator& descAllocator)
 {
     std::vector<VkDescriptorSetLayout> layouts(imgSize, meshDescriptorSetLayout);
-
-    VkDescriptorSetAllocateInfo createInfo = {};
-
-    createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    createInfo.descriptorPool = descPool;
-    createInfo.descriptorSetCount = static_cast<uint32_t>(layouts.size());
-    createInfo.pSetLayouts = layouts.data();
-    meshDescriptorSets.resize(imgSize);
-    return vkAllocateDescriptorSets(getLogicalDev(), &createInfo, meshDescriptorSets.data());
+    return descAllocator.allocate(layouts, meshDescriptorSets);
 }
 
 std::pair<UniformObjBuffer<UniformObjects>&, VkDescriptorSet&> SwapchainImageBuffers::operator[](uint32_t const& i)
@@ -153,13 +129,17 @@ SwapchainImageBuffers& SwapchainImageBuffers::operator=(SwapchainImageBuffers&&
     unifBuffers = std::move(sib.unifBuffers);
     descriptorSets = std::move(sib.descriptorSets);
     meshDescriptorSets = std::move(sib.meshDescriptorSets);
-    lightSBOs = std::move(sib.lightSBOs);
+    lightBuffers = std::move(sib.lightBuffers);
+    clusterBuffers = std::move(sib.clusterBuffers);
+    frameUpdateTemplate = std::move(sib.frameUpdateTemplate);
+    meshUpdateTemplate = std::move(sib.meshUpdateTemplate);
     allocator = sib.allocator;
     imgSize = sib.imgSize;
 
     sib.unifBuffers.clear();
     sib.descriptorSets.clear();
-    sib.lightSBOs.clear();
+    sib.lightBuffers.clear();
+    sib.clusterBuffers.clear();
 
     return *this;
 }
@@ -169,19 +149,24 @@ SwapchainImageBuffers::SwapchainImageBuffers(SwapchainImageBuffers&& sib) noexce
         descriptorSetLayout(std::move(sib.descriptorSetLayout)),
         meshDescriptorSetLayout(std::move(sib.meshDescriptorSetLayout)),
         unifBuffers(std::move(sib.unifBuffers)),
-        lightSBOs(std::move(sib.lightSBOs)),
+        lightBuffers(std::move(sib.lightBuffers)),
+        clusterBuffers(std::move(sib.clusterBuffers)),
         descriptorSets(std::move(sib.descriptorSets)),
         meshDescriptorSets(std::move(sib.meshDescriptorSets)),
+        frameUpdateTemplate(std::move(sib.frameUpdateTemplate)),
+        meshUpdateTemplate(std::move(sib.meshUpdateTemplate)),
         allocator(sib.allocator),
         imgSize(sib.imgSize)
 {
     sib.unifBuffers.clear();
     sib.descriptorSets.clear();
-    sib.lightSBOs.clear();
+    sib.lightBuffers.clear();
+    sib.clusterBuffers.clear();
 }
 
 void SwapchainImageBuffers::createUniformBuffers(VkPhysicalDevice const& physDev,
-                                                 SwapchainComponents const& swapchainComponent)
+                                                 SwapchainComponents const& swapchainComponent,
+                                                 bool hostClusters)
 {
     for (uint32_t i=0; i < imgSize; ++i)
     {
@@ -190,37 +175,51 @@ void SwapchainImageBuffers::createUniformBuffers(VkPhysicalDevice const& physDev
                 nullopt, 0,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-        lightSBOs.emplace_back(
-                getLogicalDevPtr(), allocator, physDev, 64,
-                nullopt, 0,
+        lightBuffers.emplace_back(
+                getLogicalDevPtr(), allocator, physDev,
+                LightClusters::MAX_LIGHTS * sizeof(Light),
+                VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                VMA_MEMORY_USAGE_CPU_TO_GPU,
                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+        if (hostClusters)
+        {
+            clusterBuffers.emplace_back(
+                    getLogicalDevPtr(), allocator, physDev, LightClusters::bufferSize(),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                    VMA_MEMORY_USAGE_CPU_TO_GPU,
+                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        }
+        else
+        {
+            clusterBuffers.emplace_back(
+                    getLogicalDevPtr(), allocator, physDev, LightClusters::bufferSize(),
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                    VMA_MEMORY_USAGE_GPU_ONLY,
+                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+        }
     }
 }
 
 SwapchainImageBuffers::SwapchainImageBuffers(VkDevice* logicalDev, VmaAllocator* allocator,
                                              VkPhysicalDevice const& physDev,
                                              SwapchainComponents const& swapchainComponent,
+                                             DescriptorAllocator& descAllocator,
+                                             DescriptorLayoutCache& layoutCache,
                                              Image::Image& img,
-                                             uint32_t const& binding) :
+                                             uint32_t const& binding,
+                                             bool hostClusters) :
         AVkGraphicsBase(logicalDev), allocator(allocator), imgSize(swapchainComponent.imageCount())
 {
-    CHECK_VK_SUCCESS(createDescriptorSetLayout(), "Cannot create descriptor set layout!");
-    createUniformBuffers(physDev, swapchainComponent);
-    CHECK_VK_SUCCESS(createDescriptorSets(swapchainComponent), "Cannot create descriptor sets!");
+    createDescriptorSetLayout(layoutCache);
+    createUniformBuffers(physDev, swapchainComponent, hostClusters);
+    CHECK_VK_SUCCESS(createDescriptorSets(descAllocator), "Cannot create descriptor sets!");
 
 
-    CHECK_VK_SUCCESS(createMeshDescriptorSetLayout(), "Cannot create descriptor set layout!");
-    CHECK_VK_SUCCESS(createMeshDescriptorSets(swapchainComponent.descriptorPool),
+    createMeshDescriptorSetLayout(layoutCache);
+    CHECK_VK_SUCCESS(createMeshDescriptorSets(descAllocator),
                      "Cannot create descriptor sets!");
 
+    createUpdateTemplates();
     configureBuffers(binding, img);
 }
-
-SwapchainImageBuffers::~SwapchainImageBuffers()
-{
-    if (initialized())
-    {
-        vkDestroyDescriptorSetLayout(getLogicalDev(), meshDescriptorSetLayout, nullptr);
-        vkDestroyDescriptorSetLayout(getLogicalDev(), descriptorSetLayout, nullptr);
-    }
-}
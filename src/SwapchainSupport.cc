@@ -29,7 +29,8 @@ VkResult SwapchainImageSupport::createImageView(VkImage const& swapChainImage,
 
 VkResult SwapchainImageSupport::createFramebuffer(
         VkRenderPass const& renderPass, VkExtent2D const& extent,
-        std::optional<VkImageView> const& depthBufferImgView)
+        std::optional<VkImageView> const& depthBufferImgView,
+        std::vector<VkImageView> const& gbufferViews)
 {
     // creating frame buffer
     std::vector<VkImageView> attachments = {
@@ -39,6 +40,7 @@ VkResult SwapchainImageSupport::createFramebuffer(
     {
         attachments.push_back(depthBufferImgView.value());
     }
+    attachments.insert(attachments.end(), gbufferViews.begin(), gbufferViews.end());
 
     VkFramebufferCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -61,11 +63,10 @@ SwapchainImageSupport& SwapchainImageSupport::operator=(SwapchainImageSupport&&
     }
     imageView = swpImgSupport.imageView;
     frameBuffer = swpImgSupport.frameBuffer;
-    imagesInFlight = swpImgSupport.imagesInFlight;
+    timelineValue = swpImgSupport.timelineValue;
 
     swpImgSupport.imageView = VK_NULL_HANDLE;
     swpImgSupport.frameBuffer = VK_NULL_HANDLE;
-    swpImgSupport.imagesInFlight = VK_NULL_HANDLE;
 
     AVkGraphicsBase::operator=(std::move(swpImgSupport));
     return *this;
@@ -74,23 +75,23 @@ SwapchainImageSupport& SwapchainImageSupport::operator=(SwapchainImageSupport&&
 SwapchainImageSupport::SwapchainImageSupport(SwapchainImageSupport&& swpImgSupport) noexcept:
     AVkGraphicsBase(std::move(swpImgSupport)),
     imageView(std::move(swpImgSupport.imageView)), frameBuffer(std::move(swpImgSupport.frameBuffer)),
-    imagesInFlight(std::move(swpImgSupport.imagesInFlight))
+    timelineValue(swpImgSupport.timelineValue)
 {
     swpImgSupport.imageView = VK_NULL_HANDLE;
     swpImgSupport.frameBuffer = VK_NULL_HANDLE;
-    swpImgSupport.imagesInFlight = VK_NULL_HANDLE;
 }
 
 SwapchainImageSupport::SwapchainImageSupport(VkDevice* logicalDev, VkRenderPass const& renderPass,
                                              VkExtent2D const& extent, VkImage const& swapChainImage,
                                              VkFormat const& swapchainFormat,
-                                             std::optional<VkImageView> const& depthBufferImgView): AVkGraphicsBase(logicalDev)
+                                             std::optional<VkImageView> const& depthBufferImgView,
+                                             std::vector<VkImageView> const& gbufferViews): AVkGraphicsBase(logicalDev)
 {
     CHECK_VK_SUCCESS(
             createImageView(swapChainImage, swapchainFormat),
             "Cannot create image view!");
     CHECK_VK_SUCCESS(
-            createFramebuffer(renderPass, extent, depthBufferImgView),
+            createFramebuffer(renderPass, extent, depthBufferImgView, gbufferViews),
             "Cannot create framebuffer!");
 }
 
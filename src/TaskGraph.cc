@@ -0,0 +1,84 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "TaskGraph.h"
+
+TaskGraph::TaskId TaskGraph::addTask(
+        std::string name,
+        std::function<void()> fn,
+        std::vector<TaskId> const& dependencies,
+        bool const& callerThread)
+{
+    auto id = static_cast<TaskId>(tasks.size());
+    for (TaskId dependency : dependencies)
+    {
+        // ids only ever point backwards, so the graph cannot have cycles
+        assert(dependency < id);
+        tasks[dependency].dependents.push_back(id);
+    }
+
+    Task& task = tasks.emplace_back();
+    task.name = std::move(name);
+    task.fn = std::move(fn);
+    task.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    task.callerThread = callerThread;
+
+    remaining = std::make_unique<std::atomic<uint32_t>[]>(tasks.size());
+    return id;
+}
+
+void TaskGraph::run(JobSystem& jobs)
+{
+    caller = std::this_thread::get_id();
+    for (size_t i = 0; i < tasks.size(); ++i)
+    {
+        remaining[i].store(tasks[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    Jobs::Counter done;
+    for (TaskId id = 0; id < static_cast<TaskId>(tasks.size()); ++id)
+    {
+        if (tasks[id].dependencyCount == 0)
+        {
+            schedule(jobs, done, id);
+        }
+    }
+    jobs.wait(done);
+}
+
+void TaskGraph::schedule(JobSystem& jobs, Jobs::Counter& done, TaskId const& id)
+{
+    // dependents are queued before this task counts as done, so done cannot
+    // reach zero while any of them is still pending
+    auto body = [this, &jobs, &done, id]()
+    {
+        tasks[id].fn();
+        for (TaskId dependent : tasks[id].dependents)
+        {
+            if (remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                schedule(jobs, done, dependent);
+            }
+        }
+    };
+
+    if (tasks[id].callerThread)
+    {
+        jobs.runOnThread(caller, body, &done);
+    }
+    else
+    {
+        jobs.run(body, &done);
+    }
+}
+
+size_t TaskGraph::size() const
+{
+    return tasks.size();
+}
+
+std::string const& TaskGraph::taskName(TaskId const& id) const
+{
+    return tasks[id].name;
+}
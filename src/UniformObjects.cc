@@ -10,7 +10,7 @@ VkDescriptorSetLayoutBinding UniformObjects::descriptorSetLayout(uint32_t bindin
     uboLayout.binding = binding;
     uboLayout.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
     uboLayout.descriptorCount = 1;
-    uboLayout.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    uboLayout.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT;
     uboLayout.pImmutableSamplers = nullptr;
 
     return uboLayout;
@@ -43,13 +43,7 @@ VkDescriptorSetLayoutBinding MeshUniform::descriptorSetLayout(uint32_t binding)
     return uboLayout;
 }
 
-void MeshUniform::computeInvDual()
-{
-    modelInvDual = glm::inverseTranspose(model);
-}
-
 void MeshUniform::setModelMatrix(glm::mat4 const& newModel)
 {
     model = newModel;
-    computeInvDual();
 }
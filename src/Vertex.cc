@@ -71,3 +71,41 @@ std::array<VkVertexInputAttributeDescription, 3> NVertex::attributeDescription()
 
     return {atrPos, atrNormal, atrTexCoord};
 }
+
+VertexStreams VertexStreams::of(VertexLayout const& layout, size_t const& vertexCount)
+{
+    VertexStreams streams;
+    if (layout == VERTEX_LAYOUT_SPLIT_POSITIONS)
+    {
+        streams.count = 2;
+        streams.offsets[1] = vertexCount * sizeof(glm::vec3);
+    }
+    return streams;
+}
+
+VertexInputDescription VertexInputDescription::of(VertexLayout const& layout, bool const& positionsOnly)
+{
+    VertexInputDescription desc;
+    std::array<VkVertexInputAttributeDescription, 3> attributes = NVertex::attributeDescription();
+
+    if (layout == VERTEX_LAYOUT_SPLIT_POSITIONS)
+    {
+        desc.bindings.push_back({ 0, sizeof(glm::vec3), VK_VERTEX_INPUT_RATE_VERTEX });
+        attributes[0].offset = 0;
+        if (not positionsOnly)
+        {
+            desc.bindings.push_back({ 1, sizeof(VertexAttributes), VK_VERTEX_INPUT_RATE_VERTEX });
+            attributes[1].binding = 1;
+            attributes[1].offset = offsetof(VertexAttributes, normal);
+            attributes[2].binding = 1;
+            attributes[2].offset = offsetof(VertexAttributes, texCoord);
+        }
+    }
+    else
+    {
+        desc.bindings.push_back(NVertex::bindingDescription());
+    }
+
+    desc.attributes.assign(attributes.begin(), positionsOnly ? attributes.begin() + 1 : attributes.end());
+    return desc;
+}
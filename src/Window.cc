@@ -9,46 +9,84 @@
 
 #include <utility>
 #include <chrono>
+#include <numeric>
+
+namespace
+{
+    // smallest slice of per-draw CPU work worth handing to another thread
+    constexpr uint32_t DRAWS_PER_JOB = 1024;
+
+    // how long an acquire holds the swapchain lock before letting a present through
+    constexpr uint64_t ACQUIRE_TIMEOUT_NS = 1000000;
+
+    // how often the main thread writes out pipelines compiled since the last save
+    constexpr std::chrono::seconds PIPELINE_CACHE_SAVE_INTERVAL(30);
+}
 
 Window::Window(size_t const& width,
                size_t const& height,
                std::string windowTitle,
-               float const& fov, float const& clipnear, float const& clipfar) :
+               float const& fov, float const& clipnear, float const& clipfar,
+               RenderOptions const& renderOptions) :
         WindowBase(width, height, std::move(windowTitle)),
+        options(renderOptions),
+        benchmark(renderOptions.benchmarkFrames),
+        jobs(renderOptions.jobThreads, renderOptions.pinThreads),
+        pipelineCache(&logicalDev, dev, renderOptions.pipelineCachePath),
+        layoutCache(&logicalDev),
+        descriptorAllocator(&logicalDev),
+        persistentDescriptors(&logicalDev),
+        // only the G-buffer lighting set is allocated per frame
+        frameDescriptors(&logicalDev, GBuffer::poolRatios()),
+        frameTimeline(&logicalDev),
         fovDegrees(fov), clipNear(clipnear), clipFar(clipfar),
         projectMat(glm::perspective(
                 glm::radians(fovDegrees),
                 static_cast<float>(width) / static_cast<float>(height),
                 clipNear, clipFar)),
+        clusterSlicing(LightClusters::DepthSlicing::fromClipPlanes(clipnear, clipfar)),
         cameraPos(1.f, -1.f, 1.f)
 {
     initCallbacks();
+    // before any pipeline loads its shaders
+    Shaders::setOverrideDirectory(options.shaderDirectory);
+    windowExtent.store((static_cast<uint64_t>(this->width) << 32) | static_cast<uint32_t>(this->height));
 
 
     depthBuffer = Image::Image(
             &logicalDev, &allocator, size(),
             Image::findDepthFormat(dev),
-            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            depthUsage(),
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
             nullopt,
             nullopt,
             VK_IMAGE_TILING_OPTIMAL, 1, VK_IMAGE_LAYOUT_UNDEFINED,
             VK_IMAGE_ASPECT_DEPTH_BIT);
+    createGBuffer();
 
     swapchainComponent = std::make_unique<SwapchainComponents>(
             &logicalDev, dev,
-            surface, size(), depthBuffer.imgView);
+            surface, size(), depthBuffer.imgView, VK_NULL_HANDLE, gbuffer.attachmentViews());
 
     CHECK_VK_SUCCESS(createCommandPool(), ErrorMessages::CREATE_COMMAND_POOL_FAILED);
     CHECK_VK_SUCCESS(createTransferCmdPool(), "Cannot create transfer command pool!");
 
-    meshStorage.emplace("teapot", std::make_unique<Mesh>(
-            &logicalDev, &allocator, &dev, helpers::searchPath("assets/teapot.obj")
-            ));
-
-    meshStorage.emplace("plane", std::make_unique<Mesh>(
-            &logicalDev, &allocator, &dev, helpers::searchPath("assets/plane.obj")
-            ));
+    // assets are parsed in parallel; VMA allocations are thread-safe and nothing is submitted yet
+    VertexLayout vertexLayout = options.splitPositions ? VERTEX_LAYOUT_SPLIT_POSITIONS : VERTEX_LAYOUT_INTERLEAVED;
+    std::unique_ptr<Mesh> teapot, plane;
+    helpers::img_r8g8b8a8 image;
+    Jobs::Counter assetsLoaded;
+    jobs.run([&]() {
+        teapot = std::make_unique<Mesh>(&logicalDev, &allocator, &dev, helpers::searchPath("assets/teapot.obj"), vertexLayout);
+    }, &assetsLoaded);
+    jobs.run([&]() {
+        plane = std::make_unique<Mesh>(&logicalDev, &allocator, &dev, helpers::searchPath("assets/plane.obj"), vertexLayout);
+    }, &assetsLoaded);
+    jobs.run([&]() { image = helpers::fromPng(helpers::searchPath("assets/smile.png")); }, &assetsLoaded);
+    jobs.wait(assetsLoaded);
+
+    meshStorage.emplace("teapot", std::move(teapot));
+    meshStorage.emplace("plane", std::move(plane));
 
     glm::mat4 baseMat = glm::scale(glm::transpose(glm::mat4(
             0, 0, 1, 0,
@@ -62,24 +100,42 @@ Window::Window(size_t const& width,
 
     drawables[0].uniform.baseColor = glm::vec4(1,1,1,1);
     drawables[1].uniform.baseColor = glm::vec4(0.6,0.2,0.45,1);
-    drawables[0].uniform.params = glm::vec4(0.15,0,0.04,0);
-    drawables[1].uniform.params = glm::vec4(0.35,0,0.04,0);
+    drawables[0].uniform.params = glm::vec4(0.15,0,0.04,1);
+    drawables[1].uniform.params = glm::vec4(0.35,0,0.04,1);
+    addBenchmarkDrawables();
 
     // for vertex buffer
-    initBuffers();
+    initBuffers(image);
+    initBindless();
+    initBufferAddress();
+    initPushConstants();
+    initGpuDriven();
+    initInstancing();
+    initParallelRecording();
 
     uniformData = std::make_unique<SwapchainImageBuffers>(
-            &logicalDev, &allocator, dev, *swapchainComponent, img, 0
+            &logicalDev, &allocator, dev, *swapchainComponent,
+            descriptorAllocator, layoutCache, img, 0, options.cpuLightBinning
     );
 
-    graphicsPipeline = std::make_unique<GraphicsPipeline>(
-            &logicalDev, dev, &cmdPool,
-            helpers::searchPath("main.vert.spv"), helpers::searchPath("main.frag.spv"),
-            swapchainComponent->swapchainExtent, swapchainComponent->imageCount(),
-            swapchainComponent->renderPass,
-            std::vector<VkDescriptorSetLayout> {
-                uniformData->descriptorSetLayout,
-                uniformData->meshDescriptorSetLayout}, true);
+    if (not options.cpuLightBinning)
+    {
+        clusterPipeline = std::make_unique<ComputePipeline>(
+                &logicalDev, pipelineCache.cache, "clusters.comp.spv",
+                std::vector<VkDescriptorSetLayout>{uniformData->descriptorSetLayout});
+    }
+
+    createPipelines();
+
+    if (benchmark.enabled())
+    {
+        gpuTimer = std::make_unique<GpuTimer>(&logicalDev, dev, queueFamilyIndex.graphicsFamily.value());
+        if (not gpuTimer->supported())
+        {
+            std::cerr << "The graphics queue has no timestamps; GPU times will not be reported." << std::endl;
+            gpuTimer.reset();
+        }
+    }
 
     for (size_t i=0; i < MAX_FRAMES_IN_FLIGHT; ++i)
     {
@@ -87,37 +143,173 @@ Window::Window(size_t const& width,
     }
 
     uniformData->configureMeshBuffers(0, *meshUniformGroup);
+    buildFrameGraph();
+    initPresentThread();
+    savePipelineCache();
 
-
+    // the renderer starts from the scene as built here
+    simModels.reserve(drawables.size());
+    for (auto const& drawable : drawables)
+    {
+        simModels.push_back(drawable.uniform.model);
+    }
+    publishSnapshot();
 }
 
 int Window::mainLoop()
 {
+    if (options.renderThread)
+    {
+        // the render thread schedules nearly every job, so it takes over worker 0 and its deque
+        jobs.releaseThread();
+        renderThread = std::thread(&Window::renderLoop, this);
+    }
+
+    // the main thread owns the window and the simulation; with a render thread it
+    // polls and steps at the simulation rate, otherwise it also renders each step
+    auto simulationStep = std::chrono::duration<double>(1.0 / std::max(1u, options.simulationRate));
     auto lastTime = std::chrono::high_resolution_clock::now();
-    while (not glfwWindowShouldClose(window))
+    auto lastCacheSave = lastTime;
+    while (not glfwWindowShouldClose(window) && not renderingDone.load(std::memory_order_acquire))
     {
         float timepassed = 0;
         auto newTime = std::chrono::high_resolution_clock::now();
-        if (running)
+        if (running.exchange(true))
         {
             timepassed = std::chrono::duration<float, std::milli>(newTime - lastTime).count();
         }
-        running = true;
+        jobs.pumpMainThread();
         updateFrame(timepassed);
-        glfwPollEvents();
-        drawFrame();
+        publishSnapshot();
+
+        if (newTime - lastCacheSave >= PIPELINE_CACHE_SAVE_INTERVAL)
+        {
+            // resizes may have compiled new pipelines on the render thread
+            savePipelineCache();
+            lastCacheSave = newTime;
+        }
 
+        if (renderThread.joinable())
+        {
+            auto nextStep = newTime +
+                    std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(simulationStep);
+            for (auto now = newTime; now < nextStep && not renderingDone.load(std::memory_order_acquire);
+                 now = std::chrono::high_resolution_clock::now())
+            {
+                glfwWaitEventsTimeout(std::chrono::duration<double>(nextStep - now).count());
+            }
+        }
+        else
+        {
+            glfwPollEvents();
+            renderFrame();
+        }
         lastTime = newTime;
     }
 
+    if (renderThread.joinable())
+    {
+        stopRendering.store(true, std::memory_order_release);
+        renderThread.join();
+        jobs.registerThread();
+    }
+    // the present thread issues whatever is still queued before it stops, and
+    // has to be gone before waiting on every queue
+    presentThread.reset();
     vkDeviceWaitIdle(logicalDev);
+    deletionQueue.flush();
+    savePipelineCache();
+    if (renderError)
+    {
+        std::rethrow_exception(renderError);
+    }
+
+    if (benchmark.enabled())
+    {
+        std::string label = drawPathName(options.drawPath);
+        if (options.depthPrePass)
+        {
+            label += ", depth pre-pass";
+        }
+        if (options.splitPositions)
+        {
+            label += ", split positions";
+        }
+        if (options.deferredShading)
+        {
+            label += ", deferred";
+        }
+        benchmark.report(std::cout, label);
+    }
     return 0;
 }
 
+void Window::renderLoop()
+{
+    jobs.registerThread();
+    try
+    {
+        while (not stopRendering.load(std::memory_order_acquire)
+               && not renderingDone.load(std::memory_order_relaxed))
+        {
+            renderFrame();
+        }
+    }
+    catch (...)
+    {
+        // mainLoop rethrows it once this thread is joined
+        renderError = std::current_exception();
+        renderingDone.store(true, std::memory_order_release);
+        glfwPostEmptyEvent();
+    }
+    jobs.releaseThread();
+}
+
+void Window::renderFrame()
+{
+    auto frameStart = std::chrono::high_resolution_clock::now();
+    drawFrame();
+    benchmark.addSample("frame (cpu)", std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - frameStart).count());
+    benchmark.endFrame();
+
+    if (benchmark.finished())
+    {
+        renderingDone.store(true, std::memory_order_release);
+        // wakes the main thread if it is waiting for events
+        glfwPostEmptyEvent();
+    }
+}
+
 Window::~Window()
 {
+    // only still running if mainLoop threw before it could stop it
+    if (renderThread.joinable())
+    {
+        stopRendering.store(true, std::memory_order_release);
+        renderThread.join();
+        jobs.registerThread();
+    }
+    presentThread.reset();
+    vkDeviceWaitIdle(logicalDev);
+    // retired objects may hold command buffers and descriptor sets from the pools below
+    deletionQueue.flush();
+
     meshUniformGroup.reset();
+    bindlessTable.reset();
+    drawAddressTable.reset();
+    materialTable.reset();
+    cullingPass.reset();
+    clusterPipeline.reset();
+    deferredLighting.reset();
+    instanceBuffer.reset();
+    geometryBuffer.reset();
+    secondaryPools.reset();
+    // compiles still running use the generic pipeline's layout
+    pipelineManager.reset();
+    depthPipeline.reset();
     graphicsPipeline.reset();
+    gpuTimer.reset();
     swapchainComponent.reset();
 
     vkDestroyCommandPool(logicalDev, cmdTransferPool, nullptr);
@@ -130,7 +322,7 @@ void Window::initCallbacks()
     glfwSetWindowSizeCallback(window, Window::onWindowSizeChange);
 }
 
-void Window::recordCmd(uint32_t imageIdx, VkFence& submissionFence)
+void Window::recordCmd(uint32_t imageIdx, uint64_t const& frameValue)
 {
     auto& cmdBuf = graphicsPipeline->cmdBuffers[imageIdx];
 
@@ -143,6 +335,17 @@ void Window::recordCmd(uint32_t imageIdx, VkFence& submissionFence)
             vkBeginCommandBuffer(cmdBuf, &beginInfo),
             "Failed to begin buffer recording!");
 
+    if (gpuTimer)
+    {
+        // the slot's last frame completed before it was acquired again
+        auto frameIdx = static_cast<uint32_t>(currentFrame);
+        if (auto gpuTime = gpuTimer->read(frameIdx))
+        {
+            benchmark.addSample("frame (gpu)", *gpuTime);
+        }
+        gpuTimer->cmdBegin(cmdBuf, frameIdx);
+    }
+
     VkRenderPassBeginInfo renderPassBeginInfo = {};
     renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassBeginInfo.renderPass = swapchainComponent->renderPass;
@@ -158,44 +361,46 @@ void Window::recordCmd(uint32_t imageIdx, VkFence& submissionFence)
     renderPassBeginInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassBeginInfo.pClearValues = clearValues.data();
 
-    vkCmdBeginRenderPass(cmdBuf, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-    vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline->pipeline);
-
-    VkDescriptorSet descSets[1] = {uniformData->descriptorSets[imageIdx]};
-    vkCmdBindDescriptorSets(
-            cmdBuf,
-            VK_PIPELINE_BIND_POINT_GRAPHICS,
-            graphicsPipeline->pipelineLayout,
-            0,
-            1, descSets,
-            0, nullptr);
-
-    meshUniformGroup->beginFenceGroup(imageIdx, submissionFence);
+    // culling, sorting and transform encoding already ran as earlier frame graph tasks
+    prepareDraws(cmdBuf, frameValue);
+    recordLightClusters(cmdBuf, imageIdx);
 
-    for (auto& drawable : drawables)
+    uint32_t chunkCount = recordChunkCount();
+    BindStats bindStats;
+    if (chunkCount > 1)
     {
-        Mesh& mesh = drawable.getMesh();
-        uint32_t offset_val = meshUniformGroup->placeNextData(drawable.uniform);
-        uint32_t offsetvals[1] = { offset_val };
-
-        vkCmdBindDescriptorSets(
-                cmdBuf,
-                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                graphicsPipeline->pipelineLayout,
-                1,
-                1, &uniformData->meshDescriptorSets[imageIdx],
-                1, offsetvals);
+        vkCmdBeginRenderPass(cmdBuf, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        bindStats = recordParallelDraws(cmdBuf, imageIdx, chunkCount);
+    }
+    else
+    {
+        vkCmdBeginRenderPass(cmdBuf, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        primaryEncoder.begin(cmdBuf);
+        auto drawCount = static_cast<uint32_t>(visibleDrawables.size());
+        if (depthPipeline)
+        {
+            recordDraws(primaryEncoder, imageIdx, 0, drawCount, true);
+        }
+        recordDraws(primaryEncoder, imageIdx, 0, drawCount);
+        bindStats = primaryEncoder.stats();
+    }
 
-        VkBuffer vertBuffers[] = { mesh.buf.vertexBuffer };
-        VkDeviceSize offsets[] = {0};
-        vkCmdBindVertexBuffers(cmdBuf, 0, 1, vertBuffers, offsets);
-        vkCmdBindIndexBuffer(cmdBuf, mesh.buf.vertexBuffer, mesh.idxOffset(), VK_INDEX_TYPE_UINT32);
-        // actual drawing command :)
-        // vkCmdDraw(cmdBuf, vertexBuffer->getSize(), 1, 0, 0);
-        vkCmdDrawIndexed(cmdBuf, static_cast<uint32_t>(mesh.idxCount()), 1, 0, 0, 0);
+    if (deferredLighting)
+    {
+        VkDescriptorSet lightingSet = VK_NULL_HANDLE;
+        CHECK_VK_SUCCESS(
+                gbuffer.allocateLightingSet(frameDescriptors, lightingSet),
+                "Cannot allocate G-buffer descriptor set!");
+
+        vkCmdNextSubpass(cmdBuf, VK_SUBPASS_CONTENTS_INLINE);
+        deferredLighting->cmdDraw(
+                cmdBuf, uniformData->descriptorSets[imageIdx], lightingSet,
+                swapchainComponent->swapchainExtent);
     }
 
     vkCmdEndRenderPass(cmdBuf);
+    benchmark.addCount("binds issued", bindStats.issued);
+    benchmark.addCount("binds skipped", bindStats.skipped);
 
     depthBuffer.cmdTransitionLayout(
             VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
@@ -208,199 +413,929 @@ void Window::recordCmd(uint32_t imageIdx, VkFence& submissionFence)
             Image::hasStencilComponent(Image::findDepthFormat(dev)) ?
             VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT :
             VK_IMAGE_ASPECT_DEPTH_BIT);
+
+    if (gpuTimer)
+    {
+        gpuTimer->cmdEnd(cmdBuf, static_cast<uint32_t>(currentFrame));
+    }
     CHECK_VK_SUCCESS(
             vkEndCommandBuffer(cmdBuf),
             "Cannot end command buffer!");
 
 }
 
-void Window::drawFrame()
+void Window::recordLightClusters(VkCommandBuffer& cmdBuf, uint32_t const& imageIdx)
 {
-    // code goes here
-    uint32_t imgIndex;
-    VkSemaphore& imgAvailable = frameSemaphores[currentFrame].imgAvailable;
-    VkSemaphore& renderFinished = frameSemaphores[currentFrame].imgAvailable;
-    VkFence& inFlightFence = frameSemaphores[currentFrame].inFlight;
-
-    vkWaitForFences(logicalDev, 1, &inFlightFence, VK_TRUE, UINT64_MAX);
+    // with CPU binning the clusters were uploaded along with the lights
+    if (clusterPipeline == nullptr)
+    {
+        return;
+    }
 
-    VkResult nextImgResult = vkAcquireNextImageKHR(
-            logicalDev, swapchainComponent->swapChain, UINT64_MAX,
-            imgAvailable, VK_NULL_HANDLE, &imgIndex);
+    vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, clusterPipeline->pipeline);
+    vkCmdBindDescriptorSets(
+            cmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, clusterPipeline->pipelineLayout,
+            0, 1, &uniformData->descriptorSets[imageIdx], 0, nullptr);
+    vkCmdDispatch(cmdBuf, LightClusters::CLUSTER_COUNT / LightClusters::WORKGROUP_SIZE, 1, 1);
+
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = uniformData->clusterBuffers[imageIdx].vertexBuffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(
+            cmdBuf,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+            0, nullptr, 1, &barrier, 0, nullptr);
+}
 
-    if (nextImgResult == VK_ERROR_OUT_OF_DATE_KHR)
+void Window::prepareDraws(VkCommandBuffer& cmdBuf, uint64_t const& frameValue)
+{
+    // the frame fence has already been waited on in acquireFrame, so this frame's
+    // per-draw records are free to overwrite. Everything uploaded here is uploaded
+    // once, however many passes draw it.
+    if (options.drawPath == DRAW_PATH_BUFFER_ADDRESS)
     {
-        resetSwapChain();
-        return;
+        std::vector<MeshUniform> records;
+        records.reserve(visibleDrawables.size());
+        for (uint32_t drawableIdx : visibleDrawables)
+        {
+            records.push_back(drawables[drawableIdx].uniform);
+        }
+        CHECK_VK_SUCCESS(
+                drawAddressTable->setRecords(static_cast<uint32_t>(currentFrame), records),
+                "Cannot upload draw records!");
     }
-    else if (nextImgResult != VK_SUCCESS && nextImgResult != VK_SUBOPTIMAL_KHR)
+    else if (options.drawPath == DRAW_PATH_BINDLESS)
     {
-        throw std::runtime_error("Cannot acquire swap chain image!");
+        std::vector<DrawRecord> records(visibleDrawables.size());
+        for (size_t i = 0; i < visibleDrawables.size(); ++i)
+        {
+            records[i].transform = frameTransforms[i];
+            records[i].materialIdx = drawables[visibleDrawables[i]].materialIdx;
+        }
+        CHECK_VK_SUCCESS(bindlessTable->setDrawRecords(currentFrame, records), "Cannot upload draw records!");
+        CHECK_VK_SUCCESS(bindlessTable->syncMaterials(currentFrame), "Cannot upload materials!");
     }
+    else if (options.drawPath == DRAW_PATH_INSTANCED)
+    {
+        buildInstanceBatches();
+        CHECK_VK_SUCCESS(instanceBuffer->setInstances(currentFrame, frameInstances), "Cannot upload instances!");
+    }
+    else if (options.drawPath == DRAW_PATH_GPU_DRIVEN)
+    {
+        // records stay in drawable order; cull.comp emits one command per visible instance
+        frameInstances.resize(drawables.size());
+        for (size_t i = 0; i < drawables.size(); ++i)
+        {
+            frameInstances[i].transform = frameTransforms[i];
+            frameInstances[i].materialIdx = drawables[i].materialIdx;
+            frameInstances[i].meshIdx = geometryBuffer->meshIndex(&drawables[i].getMesh());
+        }
+        CHECK_VK_SUCCESS(instanceBuffer->setInstances(currentFrame, frameInstances), "Cannot upload instances!");
+    }
+    else if (options.drawPath == DRAW_PATH_DYNAMIC_UBO)
+    {
+        meshUniformGroup->beginFrame(frameTimeline, frameValue);
+        frameUniformOffsets.resize(visibleDrawables.size());
+        for (size_t i = 0; i < visibleDrawables.size(); ++i)
+        {
+            frameUniformOffsets[i] = meshUniformGroup->placeNextData(drawables[visibleDrawables[i]].uniform);
+        }
+    }
+}
 
-    // if this specific image has been rendered in the previous frame,
-    // wait for it.
-
-    // If there is multiple in-flight frames per a single image,
-    // this will also check for /that/ frame as well, and
-    // switch to the current fence.
-    VkFence& imgIdxFence = swapchainComponent->swapchainSupport[imgIndex].imagesInFlight;
-    if (imgIdxFence != VK_NULL_HANDLE)
+uint32_t Window::recordChunkCount() const
+{
+    // pools only exist for paths that can be split; see initParallelRecording
+    if (not secondaryPools)
     {
-        vkWaitForFences(logicalDev, 1, &imgIdxFence, VK_TRUE, UINT64_MAX);
+        return 1;
     }
-    imgIdxFence = inFlightFence;
-    // at this point, image is fully ours.
 
-    vkResetCommandBuffer(graphicsPipeline->cmdBuffers[imgIndex], 0);
-    recordCmd(imgIndex, inFlightFence);
+    auto drawCount = static_cast<uint32_t>(visibleDrawables.size());
+    uint32_t chunkCount = drawCount / SecondaryCommandPools::MIN_DRAWS_PER_WORKER;
+    return std::clamp(chunkCount, 1u, secondaryPools->workerCount());
+}
 
-    // wait then for img to become available
-    VkSubmitInfo submitInfo = {};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    VkSemaphore waitSems[] = { imgAvailable };
-    VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+void Window::recordDraws(CommandEncoder& encoder, uint32_t imageIdx, uint32_t first, uint32_t last, bool depthOnly)
+{
+    // the depth pipeline shares the layout, so sets and push constants below apply to both
+    encoder.bindPipeline(depthOnly ? depthPipeline->pipeline : graphicsPipeline->pipeline);
+
+    // dynamic state; secondary command buffers do not inherit it, so every buffer sets its own
+    VkExtent2D const& extent = swapchainComponent->swapchainExtent;
+    VkViewport viewport = {};
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    VkRect2D scissor = {{0, 0}, extent};
+    vkCmdSetViewport(encoder.commandBuffer(), 0, 1, &viewport);
+    vkCmdSetScissor(encoder.commandBuffer(), 0, 1, &scissor);
 
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSems;
-    submitInfo.pWaitDstStageMask = waitStages;
+    VkDescriptorSet descSets[1] = {uniformData->descriptorSets[imageIdx]};
+    encoder.bindDescriptorSets(graphicsPipeline->pipelineLayout, 0, 1, descSets);
 
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = graphicsPipeline->cmdBuffers.data() + imgIndex;
+    if (options.drawPath == DRAW_PATH_BINDLESS)
+    {
+        recordBindlessDraws(encoder, first, last);
+    }
+    else if (options.drawPath == DRAW_PATH_BUFFER_ADDRESS)
+    {
+        recordBufferAddressDraws(encoder, first, last);
+    }
+    else if (options.drawPath == DRAW_PATH_PUSH_CONSTANT)
+    {
+        recordPushConstantDraws(encoder, first, last, depthOnly);
+    }
+    else if (options.drawPath == DRAW_PATH_INSTANCED)
+    {
+        recordInstancedDraws(encoder);
+    }
+    else if (options.drawPath == DRAW_PATH_GPU_DRIVEN)
+    {
+        recordGpuDrivenDraws(encoder);
+    }
+    else
+    {
+        recordDynamicUniformDraws(encoder, imageIdx);
+    }
+}
 
-    VkSemaphore signals[] = { renderFinished };
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signals;
+BindStats Window::recordParallelDraws(VkCommandBuffer& cmdBuf, uint32_t imageIdx, uint32_t chunkCount)
+{
+    CHECK_VK_SUCCESS(secondaryPools->resetFrame(currentFrame), "Cannot reset secondary command pools!");
+
+    auto drawCount = static_cast<uint32_t>(visibleDrawables.size());
+    uint32_t chunkSize = (drawCount + chunkCount - 1) / chunkCount;
+    auto frameIdx = static_cast<uint32_t>(currentFrame);
+    VkFramebuffer framebuffer = swapchainComponent->swapchainSupport[imageIdx].frameBuffer;
+    // with a depth pre-pass, every chunk records it into a buffer of its own first
+    uint32_t passCount = depthPipeline ? 2 : 1;
+    std::vector<BindStats> chunkStats(chunkCount);
+
+    // secondary buffers inherit no bound state, so every chunk binds its own
+    auto recordChunk = [&](uint32_t chunk)
+    {
+        CommandEncoder& encoder = workerEncoders[chunk];
+        uint32_t first = std::min(chunk * chunkSize, drawCount);
+        for (uint32_t pass = 0; pass < passCount; ++pass)
+        {
+            VkCommandBuffer secondary = VK_NULL_HANDLE;
+            CHECK_VK_SUCCESS(
+                    secondaryPools->begin(frameIdx, chunk, pass, swapchainComponent->renderPass, framebuffer, secondary),
+                    "Failed to begin buffer recording!");
 
-    // reset here, as inFlightFence could be the same as imgIdxFence, in which case
-    // we would have resetted /before/ waiting for fence again, which causes
-    // an infinite wait (as there's nothing to render and /signal/ the fence).
+            encoder.begin(secondary);
+            recordDraws(encoder, imageIdx, first, std::min(first + chunkSize, drawCount), pass + 1 < passCount);
+            chunkStats[chunk].issued += encoder.stats().issued;
+            chunkStats[chunk].skipped += encoder.stats().skipped;
 
-    setUniforms((*uniformData)[imgIndex].first);
-    setLights(uniformData->lightSBOs[imgIndex]);
+            CHECK_VK_SUCCESS(vkEndCommandBuffer(secondary), "Cannot end command buffer!");
+        }
+    };
 
+    jobs.parallelFor(chunkCount, 1, [&recordChunk](uint32_t first, uint32_t last)
+    {
+        for (uint32_t chunk = first; chunk < last; ++chunk)
+        {
+            recordChunk(chunk);
+        }
+    });
 
-    vkResetFences(logicalDev, 1, &inFlightFence);
-    CHECK_VK_SUCCESS(
-            vkQueueSubmit(graphicsQueue, 1, &submitInfo, inFlightFence),
-            "Cannot submit draw queue!");
+    // every chunk's depth goes down before any of them shades
+    std::vector<VkCommandBuffer> secondaries;
+    secondaries.reserve(passCount * chunkCount);
+    for (uint32_t pass = 0; pass < passCount; ++pass)
+    {
+        for (uint32_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            secondaries.push_back(secondaryPools->cmdBuffer(frameIdx, chunk, pass));
+        }
+    }
 
-    // presentation
-    VkPresentInfoKHR presentInfo = {};
-    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-    presentInfo.waitSemaphoreCount = 1;
-    presentInfo.pWaitSemaphores = signals;
+    BindStats bindStats;
+    for (auto const& stats : chunkStats)
+    {
+        bindStats.issued += stats.issued;
+        bindStats.skipped += stats.skipped;
+    }
+    vkCmdExecuteCommands(cmdBuf, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+    return bindStats;
+}
 
-    VkSwapchainKHR chains[] = { swapchainComponent->swapChain };
-    presentInfo.swapchainCount = 1;
-    presentInfo.pSwapchains = chains;
-    presentInfo.pImageIndices = &imgIndex;
-    presentInfo.pResults = nullptr;
+void Window::recordDynamicUniformDraws(CommandEncoder& encoder, uint32_t imageIdx)
+{
+    // uniforms were placed in the ring in prepareDraws
+    VkCommandBuffer cmdBuf = encoder.commandBuffer();
 
-    auto presentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
-    if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR)
+    for (size_t i = 0; i < visibleDrawables.size(); ++i)
     {
-        resetSwapChain();
+        Mesh& mesh = drawables[visibleDrawables[i]].getMesh();
+        uint32_t offsetvals[1] = { frameUniformOffsets[i] };
+
+        encoder.bindDescriptorSets(
+                graphicsPipeline->pipelineLayout,
+                1,
+                1, &uniformData->meshDescriptorSets[imageIdx],
+                1, offsetvals);
+
+        encoder.bindVertexStreams(mesh.buf.vertexBuffer, mesh.vertexStreams());
+        encoder.bindIndexBuffer(mesh.buf.vertexBuffer, mesh.idxOffset(), VK_INDEX_TYPE_UINT32);
+        // actual drawing command :)
+        // vkCmdDraw(cmdBuf, vertexBuffer->getSize(), 1, 0, 0);
+        vkCmdDrawIndexed(cmdBuf, static_cast<uint32_t>(mesh.idxCount()), 1, 0, 0, 0);
     }
-    else if (presentResult != VK_SUCCESS)
+}
+
+void Window::cullDrawables()
+{
+    visibleDrawables.resize(drawables.size());
+    if (not options.cpuCulling or options.drawPath == DRAW_PATH_GPU_DRIVEN)
     {
-        throw std::runtime_error("Cannot present image!");
+        // the gpu-driven path culls in cull.comp instead
+        std::iota(visibleDrawables.begin(), visibleDrawables.end(), 0);
+        return;
     }
 
-    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    // world-space spheres; a non-uniform scale grows the radius by the largest axis scale
+    frustumCuller.resize(drawables.size());
+    jobs.parallelFor(static_cast<uint32_t>(drawables.size()), DRAWS_PER_JOB, [this](uint32_t first, uint32_t last)
+    {
+        for (uint32_t i = first; i < last; ++i)
+        {
+            glm::mat4 const& model = drawables[i].uniform.model;
+            glm::vec4 sphere = drawables[i].getMesh().boundingSphere();
+            float maxScale2 = std::max({
+                glm::dot(glm::vec3(model[0]), glm::vec3(model[0])),
+                glm::dot(glm::vec3(model[1]), glm::vec3(model[1])),
+                glm::dot(glm::vec3(model[2]), glm::vec3(model[2]))});
+            glm::vec3 center = model * glm::vec4(glm::vec3(sphere), 1);
+            frustumCuller.setBounds(i, glm::vec4(center, sphere.w * std::sqrt(maxScale2)));
+        }
+    });
+
+    float pixelsPerUnit = projectMat[1][1] * 0.5f * static_cast<float>(swapchainComponent->swapchainExtent.height);
+    CullStats stats = frustumCuller.cull(
+            Frustum::fromViewProj(projectMat * viewMatrix()), cameraPos,
+            pixelsPerUnit, options.minScreenPixels, visibleDrawables);
+
+    benchmark.addCount("visible", stats.visible);
+    benchmark.addCount("frustum culled", stats.frustumCulled);
+    benchmark.addCount("small culled", stats.smallCulled);
 }
 
-void Window::resetSwapChain()
+void Window::sortDrawables()
 {
-    running = false;
-    while (this->width == 0 && this->height == 0)
+    if (not options.sortDraws or options.drawPath == DRAW_PATH_GPU_DRIVEN)
     {
-        glfwWaitEvents();
+        return;
     }
 
-    vkDeviceWaitIdle(logicalDev);
-
-    depthBuffer = Image::Image(
-            &logicalDev, &allocator, size(),
-            Image::findDepthFormat(dev),
-            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-            nullopt,
-            nullopt,
-            VK_IMAGE_TILING_OPTIMAL, 1, VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_ASPECT_DEPTH_BIT);
+    // there are only a handful of meshes, so their key ids come from a linear search
+    frameSortEntries.resize(visibleDrawables.size());
+    frameSortMeshes.clear();
+    for (size_t i = 0; i < visibleDrawables.size(); ++i)
+    {
+        Drawable& drawable = drawables[visibleDrawables[i]];
+        Mesh const* mesh = &drawable.getMesh();
+        auto it = std::find(frameSortMeshes.begin(), frameSortMeshes.end(), mesh);
+        if (it == frameSortMeshes.end())
+        {
+            it = frameSortMeshes.insert(frameSortMeshes.end(), mesh);
+        }
 
-    graphicsPipeline.reset();
-    uniformData.reset();
-    swapchainComponent.reset();
+        glm::vec3 center = drawable.uniform.model * glm::vec4(glm::vec3(mesh->boundingSphere()), 1);
+        float depth = glm::distance(center, cameraPos) / clipFar;
 
-    swapchainComponent = std::make_unique<SwapchainComponents>(
-            &logicalDev, dev,
-            surface, std::make_pair(this->width, this->height),
-            depthBuffer.imgView);
+        frameSortEntries[i] = {
+            DrawKey::make(
+                    drawable.pipelineVariant, static_cast<uint32_t>(it - frameSortMeshes.begin()),
+                    drawable.materialIdx, depth),
+            visibleDrawables[i] };
+    }
 
-    uniformData = std::make_unique<SwapchainImageBuffers>(
-            &logicalDev, &allocator, dev, *swapchainComponent, img, 0
-    );
+    drawSorter.sort(frameSortEntries);
+    std::transform(frameSortEntries.begin(), frameSortEntries.end(), visibleDrawables.begin(),
+                   [](DrawSortEntry const& entry) { return entry.drawIdx; });
+}
 
-    graphicsPipeline = std::make_unique<GraphicsPipeline>(
-            &logicalDev, dev, &cmdPool,
-            helpers::searchPath("main.vert.spv"), helpers::searchPath("main.frag.spv"),
-            swapchainComponent->swapchainExtent, swapchainComponent->imageCount(),
-            swapchainComponent->renderPass,
-            std::vector<VkDescriptorSetLayout> {uniformData->descriptorSetLayout, uniformData->meshDescriptorSetLayout},
-            true);
+void Window::encodeDrawTransforms()
+{
+    // the dynamic uniform and buffer address paths upload whole MeshUniforms instead
+    if (options.drawPath == DRAW_PATH_DYNAMIC_UBO or options.drawPath == DRAW_PATH_BUFFER_ADDRESS)
+    {
+        return;
+    }
 
-    uniformData->configureMeshBuffers(0, *meshUniformGroup);
+    // gather first so the encoder runs over one contiguous array
+    frameModels.resize(visibleDrawables.size());
+    frameTransforms.resize(visibleDrawables.size());
+    jobs.parallelFor(static_cast<uint32_t>(visibleDrawables.size()), DRAWS_PER_JOB, [this](uint32_t first, uint32_t last)
+    {
+        std::transform(visibleDrawables.begin() + first, visibleDrawables.begin() + last, frameModels.begin() + first,
+                       [this](uint32_t drawableIdx) { return drawables[drawableIdx].uniform.model; });
+        InstanceTransform::encodeBatch(frameModels.data() + first, last - first, frameTransforms.data() + first);
+    });
 }
 
-// static
-void Window::onWindowSizeChange(GLFWwindow* ptr, int width, int height)
+void Window::recordBindlessDraws(CommandEncoder& encoder, uint32_t first, uint32_t last)
 {
-    auto* self = reinterpret_cast<Window*>(glfwGetWindowUserPointer(ptr));
-    self->width = width;
-    self->height = height;
+    // per-draw records were written to this frame's storage buffer in prepareDraws
+    VkCommandBuffer cmdBuf = encoder.commandBuffer();
+    encoder.bindDescriptorSets(graphicsPipeline->pipelineLayout, 1, 1, &bindlessTable->descriptorSets[currentFrame]);
 
-    if (height != 0)
+    for (uint32_t i = first; i < last; ++i)
     {
-        self->projectMat = glm::perspective(
-                glm::radians(self->fovDegrees),
-                static_cast<float>(width) / static_cast<float>(height),
-                self->clipNear, self->clipFar);
+        Mesh& mesh = drawables[visibleDrawables[i]].getMesh();
+        encoder.bindVertexStreams(mesh.buf.vertexBuffer, mesh.vertexStreams());
+        encoder.bindIndexBuffer(mesh.buf.vertexBuffer, mesh.idxOffset(), VK_INDEX_TYPE_UINT32);
+
+        DrawPushConstant pushConstant = { i };
+        vkCmdPushConstants(
+                cmdBuf, graphicsPipeline->pipelineLayout,
+                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                0, sizeof(DrawPushConstant), &pushConstant);
+        vkCmdDrawIndexed(cmdBuf, static_cast<uint32_t>(mesh.idxCount()), 1, 0, 0, 0);
     }
 }
 
+void Window::recordBufferAddressDraws(CommandEncoder& encoder, uint32_t first, uint32_t last)
+{
+    VkCommandBuffer cmdBuf = encoder.commandBuffer();
+    for (uint32_t i = first; i < last; ++i)
+    {
+        Mesh& mesh = drawables[visibleDrawables[i]].getMesh();
+        encoder.bindVertexStreams(mesh.buf.vertexBuffer, mesh.vertexStreams());
+        encoder.bindIndexBuffer(mesh.buf.vertexBuffer, mesh.idxOffset(), VK_INDEX_TYPE_UINT32);
+
+        DrawAddressPushConstant pushConstant = { drawAddressTable->recordAddress(currentFrame, i) };
+        vkCmdPushConstants(
+                cmdBuf, graphicsPipeline->pipelineLayout,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                0, sizeof(DrawAddressPushConstant), &pushConstant);
+        vkCmdDrawIndexed(cmdBuf, static_cast<uint32_t>(mesh.idxCount()), 1, 0, 0, 0);
+    }
+}
 
-VkResult Window::createCommandPool()
+void Window::recordPushConstantDraws(CommandEncoder& encoder, uint32_t first, uint32_t last, bool depthOnly)
 {
-    VkCommandPoolCreateInfo createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-    createInfo.queueFamilyIndex = queueFamilyIndex.graphicsFamily.value();
-    createInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    // transforms were encoded in prepareDraws
+    VkCommandBuffer cmdBuf = encoder.commandBuffer();
+    encoder.bindDescriptorSets(graphicsPipeline->pipelineLayout, 1, 1, &materialTable->descriptorSet);
 
-    return vkCreateCommandPool(logicalDev, &createInfo, nullptr, &cmdPool);
+    VkShaderStageFlags pushStages = graphicsPipeline->pushConstantStages();
+    for (uint32_t i = first; i < last; ++i)
+    {
+        Drawable& drawable = drawables[visibleDrawables[i]];
+        Mesh& mesh = drawable.getMesh();
+        // the generic pipeline until the drawable's variant has compiled. Permutations
+        // only change shading, so the pre-pass draws everything with one pipeline
+        if (not depthOnly)
+        {
+            encoder.bindPipeline(pipelineManager->get(drawable.pipelineVariant));
+        }
+        encoder.bindVertexStreams(mesh.buf.vertexBuffer, mesh.vertexStreams());
+        encoder.bindIndexBuffer(mesh.buf.vertexBuffer, mesh.idxOffset(), VK_INDEX_TYPE_UINT32);
+
+        DrawTransformPushConstant pushConstant = { frameTransforms[i], drawable.materialIdx };
+        vkCmdPushConstants(
+                cmdBuf, graphicsPipeline->pipelineLayout, pushStages,
+                0, sizeof(DrawTransformPushConstant), &pushConstant);
+        vkCmdDrawIndexed(cmdBuf, static_cast<uint32_t>(mesh.idxCount()), 1, 0, 0, 0);
+    }
 }
 
-VkResult Window::createTransferCmdPool()
+void Window::buildInstanceBatches()
 {
-    VkCommandPoolCreateInfo createInfo = {};
-    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    // bucket by mesh in two passes: count each mesh's drawables, then scatter
+    // their records so every bucket is contiguous. There are only a handful of
+    // meshes, so a linear search beats hashing here.
+    frameBatches.clear();
+    frameBatchIndices.resize(visibleDrawables.size());
+    for (size_t i = 0; i < visibleDrawables.size(); ++i)
+    {
+        Mesh* mesh = &drawables[visibleDrawables[i]].getMesh();
+        auto it = std::find_if(frameBatches.begin(), frameBatches.end(),
+                               [mesh](InstanceBatch const& batch) { return batch.mesh == mesh; });
+        if (it == frameBatches.end())
+        {
+            it = frameBatches.insert(frameBatches.end(), { mesh, 0, 0 });
+        }
+        ++it->instanceCount;
+        frameBatchIndices[i] = static_cast<uint32_t>(it - frameBatches.begin());
+    }
+
+    uint32_t firstInstance = 0;
+    for (auto& batch : frameBatches)
+    {
+        batch.firstInstance = firstInstance;
+        firstInstance += batch.instanceCount;
+        batch.instanceCount = 0;
+    }
+
+    frameInstances.resize(visibleDrawables.size());
+    for (size_t i = 0; i < visibleDrawables.size(); ++i)
+    {
+        InstanceBatch& batch = frameBatches[frameBatchIndices[i]];
+        DrawRecord& record = frameInstances[batch.firstInstance + batch.instanceCount++];
+        record.transform = frameTransforms[i];
+        record.materialIdx = drawables[visibleDrawables[i]].materialIdx;
+    }
+}
+
+void Window::recordInstancedDraws(CommandEncoder& encoder)
+{
+    // batches were built and uploaded in prepareDraws
+    VkCommandBuffer cmdBuf = encoder.commandBuffer();
+
+    VkDescriptorSet descSets[2] = { materialTable->descriptorSet, instanceBuffer->descriptorSets[currentFrame] };
+    encoder.bindDescriptorSets(graphicsPipeline->pipelineLayout, 1, 2, descSets);
+
+    for (auto const& batch : frameBatches)
+    {
+        Mesh& mesh = *batch.mesh;
+        encoder.bindVertexStreams(mesh.buf.vertexBuffer, mesh.vertexStreams());
+        encoder.bindIndexBuffer(mesh.buf.vertexBuffer, mesh.idxOffset(), VK_INDEX_TYPE_UINT32);
+
+        // firstInstance stays 0 and the offset goes through a push constant, as
+        // SV_InstanceID does not include the base instance
+        InstanceBatchPushConstant pushConstant = { batch.firstInstance };
+        vkCmdPushConstants(
+                cmdBuf, graphicsPipeline->pipelineLayout,
+                VK_SHADER_STAGE_VERTEX_BIT,
+                0, sizeof(InstanceBatchPushConstant), &pushConstant);
+        vkCmdDrawIndexed(cmdBuf, static_cast<uint32_t>(mesh.idxCount()), batch.instanceCount, 0, 0, 0);
+    }
+}
+
+void Window::recordGpuDrivenDraws(CommandEncoder& encoder)
+{
+    // instance records were uploaded in prepareDraws
+    VkCommandBuffer cmdBuf = encoder.commandBuffer();
+
+    VkDescriptorSet descSets[2] = { materialTable->descriptorSet, instanceBuffer->descriptorSets[currentFrame] };
+    encoder.bindDescriptorSets(graphicsPipeline->pipelineLayout, 1, 2, descSets);
+
+    encoder.bindVertexStreams(geometryBuffer->buf.vertexBuffer, geometryBuffer->vertexStreams());
+    encoder.bindIndexBuffer(geometryBuffer->buf.vertexBuffer, geometryBuffer->idxOffset(), VK_INDEX_TYPE_UINT32);
+
+    // draw count and commands are written by the culling submission in submitFrame
+    cullingPass->cmdDraw(cmdBuf, currentFrame, static_cast<uint32_t>(drawables.size()));
+}
+
+void Window::buildFrameGraph()
+{
+    // CPU work that only touches host data overlaps the fence wait for the GPU to
+    // release this frame's resources; uniform upload runs alongside recording.
+    // Acquire, submit and present stay on the thread running the graph. Only cull
+    // and record add to the benchmark, and they are ordered, so it needs no locking.
+    auto update = frameGraph.addTask("apply snapshot", [this]() { applySnapshot(); });
+    auto cull = frameGraph.addTask("cull", [this]() { cullDrawables(); }, { update });
+    auto sort = frameGraph.addTask("sort", [this]() { sortDrawables(); }, { cull });
+    auto encode = frameGraph.addTask("encode transforms", [this]() { encodeDrawTransforms(); }, { sort });
+    auto acquire = frameGraph.addTask("acquire", [this]() { acquireFrame(); }, {}, true);
+    auto upload = frameGraph.addTask("upload uniforms", [this]() { uploadFrameUniforms(); }, { update, acquire });
+    auto record = frameGraph.addTask("record", [this]() { recordFrame(); }, { encode, acquire });
+    frameGraph.addTask("submit and present", [this]() { submitFrame(); }, { upload, record }, true);
+}
+
+void Window::drawFrame()
+{
+    syncWindowSize();
+    frameAcquired = false;
+    frameSubmitted = false;
+    frameOutOfDate = false;
+    try
+    {
+        frameGraph.run(jobs);
+    }
+    catch (...)
+    {
+        signalUnsubmittedFrame();
+        throw;
+    }
+    signalUnsubmittedFrame();
+
+    if (frameOutOfDate)
+    {
+        resetSwapChain();
+    }
+    if (frameAcquired)
+    {
+        currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    }
+}
+
+void Window::publishSnapshot()
+{
+    SceneSnapshot& snapshot = snapshots.back();
+    snapshot.totalTime = simTime;
+    // reuses the slot's storage once it has been through a publish
+    snapshot.models = simModels;
+    snapshots.publish();
+}
+
+void Window::applySnapshot()
+{
+    if (not snapshots.acquire())
+    {
+        // the simulation has not stepped since; the drawables already hold its latest state
+        return;
+    }
+
+    SceneSnapshot const& snapshot = snapshots.front();
+    totalTime = snapshot.totalTime;
+    jobs.parallelFor(static_cast<uint32_t>(drawables.size()), DRAWS_PER_JOB,
+                     [this, &snapshot](uint32_t first, uint32_t last)
+                     {
+                         for (uint32_t i = first; i < last; ++i)
+                         {
+                             drawables[i].uniform.setModelMatrix(snapshot.models[i]);
+                         }
+                     });
+    updateLights();
+}
+
+void Window::syncWindowSize()
+{
+    uint64_t extent = windowExtent.load(std::memory_order_acquire);
+    auto newWidth = static_cast<size_t>(extent >> 32);
+    auto newHeight = static_cast<size_t>(extent & 0xFFFFFFFF);
+    if (newWidth == width && newHeight == height)
+    {
+        return;
+    }
+
+    width = newWidth;
+    height = newHeight;
+    if (height != 0)
+    {
+        projectMat = glm::perspective(
+                glm::radians(fovDegrees),
+                static_cast<float>(width) / static_cast<float>(height),
+                clipNear, clipFar);
+    }
+}
+
+void Window::acquireFrame()
+{
+    VkSemaphore& imgAvailable = frameSemaphores[currentFrame].imgAvailable;
+
+    // throttles to MAX_FRAMES_IN_FLIGHT; everything indexed by the frame slot is free after this
+    CHECK_VK_SUCCESS(
+            frameTimeline.wait(frameSemaphores[currentFrame].timelineValue),
+            "Cannot wait for frame timeline!");
+    deletionQueue.collect(frameTimeline);
+    frameDescriptors.beginFrame(static_cast<uint32_t>(currentFrame));
+
+    VkResult nextImgResult;
+    if (presentThread)
+    {
+        // the present from MAX_FRAMES_IN_FLIGHT frames back waits on this slot's renderFinished,
+        // which this frame signals again
+        uint64_t presents = presentThread->queued();
+        if (presents >= MAX_FRAMES_IN_FLIGHT - 1)
+        {
+            presentThread->waitForIssued(presents - (MAX_FRAMES_IN_FLIGHT - 1));
+        }
+
+        // the image may only free up once a queued present goes through, which needs
+        // the swapchain lock; give it up between short waits
+        do
+        {
+            std::lock_guard<std::mutex> lock(presentThread->swapchainMutex());
+            nextImgResult = vkAcquireNextImageKHR(
+                    logicalDev, swapchainComponent->swapChain, ACQUIRE_TIMEOUT_NS,
+                    imgAvailable, VK_NULL_HANDLE, &frameImageIdx);
+        } while (nextImgResult == VK_TIMEOUT);
+    }
+    else
+    {
+        nextImgResult = vkAcquireNextImageKHR(
+                logicalDev, swapchainComponent->swapChain, UINT64_MAX,
+                imgAvailable, VK_NULL_HANDLE, &frameImageIdx);
+    }
+
+    if (nextImgResult == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        // the remaining tasks see frameAcquired unset and do nothing
+        frameOutOfDate = true;
+        return;
+    }
+    else if (nextImgResult != VK_SUCCESS && nextImgResult != VK_SUBOPTIMAL_KHR)
+    {
+        throw std::runtime_error("Cannot acquire swap chain image!");
+    }
+
+    // if this specific image has been rendered by a frame still in flight
+    // (from another frame slot), wait for it too. Usually a value comparison.
+    uint64_t& imageValue = swapchainComponent->swapchainSupport[frameImageIdx].timelineValue;
+    CHECK_VK_SUCCESS(frameTimeline.wait(imageValue), "Cannot wait for frame timeline!");
+
+    // this frame signals the next value once submitted, or from an empty submission if it
+    // never gets there (see signalUnsubmittedFrame), so waits on the value always return
+    frameTimelineValue = frameTimeline.advance();
+    imageValue = frameTimelineValue;
+    frameSemaphores[currentFrame].timelineValue = frameTimelineValue;
+    // at this point, image is fully ours.
+    frameAcquired = true;
+}
+
+void Window::uploadFrameUniforms()
+{
+    if (not frameAcquired)
+    {
+        return;
+    }
+
+    setUniforms((*uniformData)[frameImageIdx].first);
+    setLights(uniformData->lightBuffers[frameImageIdx]);
+
+    if (options.cpuLightBinning)
+    {
+        lightBinner.bin(
+                clusteredLights, static_cast<uint32_t>(frameLights.size()),
+                viewMatrix(), projectMat, clusterSlicing, jobs);
+        CHECK_VK_SUCCESS(
+                lightBinner.upload(uniformData->clusterBuffers[frameImageIdx]),
+                "Cannot upload light clusters!");
+    }
+}
+
+void Window::recordFrame()
+{
+    if (not frameAcquired)
+    {
+        return;
+    }
+
+    vkResetCommandBuffer(graphicsPipeline->cmdBuffers[frameImageIdx], 0);
+    auto recordStart = std::chrono::high_resolution_clock::now();
+    recordCmd(frameImageIdx, frameTimelineValue);
+    benchmark.addSample("record (cpu)", std::chrono::duration<double, std::milli>(
+            std::chrono::high_resolution_clock::now() - recordStart).count());
+}
+
+void Window::submitFrame()
+{
+    if (not frameAcquired)
+    {
+        return;
+    }
+
+    VkSemaphore& imgAvailable = frameSemaphores[currentFrame].imgAvailable;
+    VkSemaphore& renderFinished = frameSemaphores[currentFrame].renderFinished;
+
+    // wait then for img to become available
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    std::vector<VkSemaphore> waitSems = { imgAvailable };
+    std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+
+    if (options.drawPath == DRAW_PATH_GPU_DRIVEN)
+    {
+        // cull against the same camera as the uniforms
+        waitSems.push_back(cullingPass->submit(
+                static_cast<uint32_t>(currentFrame), computeQueue,
+                static_cast<uint32_t>(drawables.size()),
+                CullPushConstant::fromViewProj(projectMat * viewMatrix())));
+        waitStages.push_back(VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT);
+    }
+
+    submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSems.size());
+    submitInfo.pWaitSemaphores = waitSems.data();
+    submitInfo.pWaitDstStageMask = waitStages.data();
+
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = graphicsPipeline->cmdBuffers.data() + frameImageIdx;
+
+    // the binary semaphore is for presentation, the timeline marks the frame done
+    VkSemaphore signals[] = { renderFinished, frameTimeline.semaphore };
+    submitInfo.signalSemaphoreCount = 2;
+    submitInfo.pSignalSemaphores = signals;
+
+    // values are ignored for binary semaphores, but there has to be one per signal
+    uint64_t signalValues[] = { 0, frameTimelineValue };
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 2;
+    timelineInfo.pSignalSemaphoreValues = signalValues;
+    submitInfo.pNext = &timelineInfo;
+
+    CHECK_VK_SUCCESS(
+            vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE),
+            "Cannot submit draw queue!");
+    frameSubmitted = true;
+
+    // presentation
+    if (presentThread)
+    {
+        presentThread->present(swapchainComponent->swapChain, frameImageIdx, renderFinished);
+        // reports on earlier presents; this one may still be in flight
+        if (presentThread->takeOutOfDate())
+        {
+            frameOutOfDate = true;
+        }
+        return;
+    }
+
+    VkPresentInfoKHR presentInfo = {};
+    presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    presentInfo.waitSemaphoreCount = 1;
+    presentInfo.pWaitSemaphores = &renderFinished;
+
+    VkSwapchainKHR chains[] = { swapchainComponent->swapChain };
+    presentInfo.swapchainCount = 1;
+    presentInfo.pSwapchains = chains;
+    presentInfo.pImageIndices = &frameImageIdx;
+    presentInfo.pResults = nullptr;
+
+    auto presentResult = vkQueuePresentKHR(presentQueue, &presentInfo);
+    if (presentResult == VK_ERROR_OUT_OF_DATE_KHR || presentResult == VK_SUBOPTIMAL_KHR)
+    {
+        frameOutOfDate = true;
+    }
+    else if (presentResult != VK_SUCCESS)
+    {
+        throw std::runtime_error("Cannot present image!");
+    }
+}
+
+void Window::signalUnsubmittedFrame()
+{
+    if (not frameAcquired or frameSubmitted)
+    {
+        return;
+    }
+
+    // waits on the acquire semaphore too, so it is unsignaled again for the slot's next frame
+    VkSemaphore& imgAvailable = frameSemaphores[currentFrame].imgAvailable;
+    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &frameTimelineValue;
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.pNext = &timelineInfo;
+    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.pWaitSemaphores = &imgAvailable;
+    submitInfo.pWaitDstStageMask = &waitStage;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.pSignalSemaphores = &frameTimeline.semaphore;
+
+    CHECK_VK_SUCCESS(
+            vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE),
+            ErrorMessages::FAILED_CANNOT_SUBMIT_QUEUE);
+    frameSubmitted = true;
+}
+
+void Window::resetSwapChain()
+{
+    running = false;
+    while (this->width == 0 && this->height == 0)
+    {
+        if (not renderThread.joinable())
+        {
+            glfwWaitEvents();
+        }
+        else if (stopRendering.load(std::memory_order_acquire))
+        {
+            // closed while minimized; there is nothing left to draw to
+            return;
+        }
+        else
+        {
+            // events are the main thread's; wait for it to see the window restored
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        syncWindowSize();
+    }
+
+    if (presentThread)
+    {
+        presentThread->drain();
+        // anything it saw went out of date along with the old swapchain
+        presentThread->takeOutOfDate();
+    }
+
+    // only the attachments depend on the window size. They go once the frames still
+    // using them are done; nothing here waits for the GPU
+    uint64_t lastUse = frameTimeline.lastValue();
+    deletionQueue.retire(lastUse, std::move(depthBuffer));
+    deletionQueue.retire(lastUse, std::move(gbuffer));
+
+    depthBuffer = Image::Image(
+            &logicalDev, &allocator, size(),
+            Image::findDepthFormat(dev),
+            depthUsage(),
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            nullopt,
+            nullopt,
+            VK_IMAGE_TILING_OPTIMAL, 1, VK_IMAGE_LAYOUT_UNDEFINED,
+            VK_IMAGE_ASPECT_DEPTH_BIT);
+    createGBuffer();
+
+    // the old swapchain is handed over on creation, and destroyed with its image
+    // views, framebuffers and render pass once its last frame completes. Every
+    // present from it has been issued by now (the present thread is drained).
+    std::unique_ptr<SwapchainComponents> oldSwapchain = std::move(swapchainComponent);
+    swapchainComponent = std::make_unique<SwapchainComponents>(
+            &logicalDev, dev,
+            surface, std::make_pair(this->width, this->height),
+            depthBuffer.imgView, oldSwapchain->swapChain, gbuffer.attachmentViews());
+
+    // pipelines stay valid with any render pass of the same formats, and the per-image
+    // buffers, descriptor sets and command buffers with the same image count
+    if (swapchainComponent->imageCount() == oldSwapchain->imageCount() &&
+        swapchainComponent->swapchainFormat.format == oldSwapchain->swapchainFormat.format)
+    {
+        // those are still indexed by image; the new images inherit the frames that last used them
+        for (uint32_t i = 0; i < swapchainComponent->imageCount(); ++i)
+        {
+            swapchainComponent->swapchainSupport[i].timelineValue =
+                    oldSwapchain->swapchainSupport[i].timelineValue;
+        }
+    }
+    else
+    {
+        // retired first, as it waits for compiles using the generic pipeline's layout
+        deletionQueue.retire(lastUse, std::move(pipelineManager));
+        deletionQueue.retire(lastUse, std::move(deferredLighting));
+        deletionQueue.retire(lastUse, std::move(depthPipeline));
+        deletionQueue.retire(lastUse, std::move(graphicsPipeline));
+        deletionQueue.retire(lastUse, std::move(uniformData));
+        // every set allocated from here belonged to the old buffers; retire the pools with them
+        deletionQueue.retire(lastUse, std::move(descriptorAllocator));
+        descriptorAllocator = DescriptorAllocator(&logicalDev);
+
+        uniformData = std::make_unique<SwapchainImageBuffers>(
+                &logicalDev, &allocator, dev, *swapchainComponent,
+                descriptorAllocator, layoutCache, img, 0, options.cpuLightBinning
+        );
+
+        createPipelines();
+        // the new manager starts out with only the generic pipeline
+        requestPermutations();
+
+        uniformData->configureMeshBuffers(0, *meshUniformGroup);
+    }
+    deletionQueue.retire(lastUse, std::move(oldSwapchain));
+}
+
+// static
+void Window::onWindowSizeChange(GLFWwindow* ptr, int width, int height)
+{
+    // runs on the main thread; the renderer picks the new size up in syncWindowSize()
+    auto* self = reinterpret_cast<Window*>(glfwGetWindowUserPointer(ptr));
+    self->windowExtent.store(
+            (static_cast<uint64_t>(width) << 32) | static_cast<uint32_t>(height),
+            std::memory_order_release);
+}
+
+
+VkResult Window::createCommandPool()
+{
+    VkCommandPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    createInfo.queueFamilyIndex = queueFamilyIndex.graphicsFamily.value();
+    createInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    return vkCreateCommandPool(logicalDev, &createInfo, nullptr, &cmdPool);
+}
+
+VkResult Window::createTransferCmdPool()
+{
+    VkCommandPoolCreateInfo createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     createInfo.queueFamilyIndex = queueFamilyIndex.transferQueueFamily();
     createInfo.flags = 0;
 
     return vkCreateCommandPool(logicalDev, &createInfo, nullptr, &cmdTransferPool);
 }
 
-void Window::initBuffers()
+void Window::initBuffers(helpers::img_r8g8b8a8 const& image)
 {
+    // the ring must not wrap around within the frames in flight. Only the instanced
+    // path goes beyond MAX_DRAWS, and it never falls back to dynamic uniforms.
+    auto meshUniformCount = static_cast<uint32_t>(
+            std::min<size_t>(drawables.size(), DrawAddressTable::MAX_DRAWS) * (MAX_FRAMES_IN_FLIGHT + 1));
     meshUniformGroup = std::make_unique<DynUniformObjBuffer<MeshUniform>>(
             &logicalDev, &allocator, dev,
-            256,
+            std::max(256u, meshUniformCount),
             nullopt,
             0,
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-    helpers::img_r8g8b8a8 image = helpers::fromPng(helpers::searchPath("assets/smile.png"));
     Buffers::StagingBuffer imageStgBuffer(
             &logicalDev, &allocator, dev, image.totalSize(),
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -449,8 +1384,344 @@ void Window::initBuffers()
     img.cmdTransitionEndCopy(dcb.commandBuffer());
 
     dcb.finish();
-    CHECK_VK_SUCCESS(dcb.submit(transferQueue), ErrorMessages::FAILED_CANNOT_SUBMIT_QUEUE);
-    CHECK_VK_SUCCESS(vkQueueWaitIdle(transferQueue), ErrorMessages::FAILED_WAIT_IDLE);
+    uint64_t uploadValue = frameTimeline.advance();
+    CHECK_VK_SUCCESS(
+            dcb.submit(transferQueue, frameTimeline.semaphore, uploadValue),
+            ErrorMessages::FAILED_CANNOT_SUBMIT_QUEUE);
+    // the staging buffers go out of scope right after
+    CHECK_VK_SUCCESS(frameTimeline.wait(uploadValue), ErrorMessages::FAILED_WAIT_IDLE);
+}
+
+void Window::initBindless()
+{
+    if (options.drawPath != DRAW_PATH_BINDLESS)
+    {
+        return;
+    }
+
+    if (not bindlessEnabled())
+    {
+#ifdef DEBUG
+        std::cerr << "Descriptor indexing not supported; using push-constant path." << std::endl;
+#endif
+        options.drawPath = DRAW_PATH_PUSH_CONSTANT;
+        return;
+    }
+
+    bindlessTable = std::make_unique<BindlessTable>(&logicalDev, &allocator, dev);
+    uint32_t textureIdx = bindlessTable->registerTexture(img);
+
+    assignMaterials([this](MaterialRecord const& material)
+                    {
+                        return bindlessTable->registerMaterial(material);
+                    }, textureIdx);
+}
+
+void Window::assignMaterials(
+        std::function<uint32_t(MaterialRecord const&)> const& registerMaterial,
+        uint32_t const& textureIdx)
+{
+    // drawables whose mesh has texture coordinates are textured with textureIdx; the
+    // others would only sample one texel. Drawables with identical parameters share a material.
+    std::vector<std::pair<MaterialRecord, uint32_t>> registered;
+    for (auto& drawable : drawables)
+    {
+        MaterialRecord material = {};
+        material.baseColor = drawable.uniform.baseColor;
+        material.params = drawable.uniform.params;
+        material.textureIdx = drawable.drawMesh->hasTexCoords() ? textureIdx : BINDLESS_NO_TEXTURE;
+
+        auto it = std::find_if(registered.begin(), registered.end(),
+                               [&material](auto const& entry)
+                               {
+                                   return entry.first.baseColor == material.baseColor &&
+                                          entry.first.params == material.params &&
+                                          entry.first.textureIdx == material.textureIdx;
+                               });
+        if (it != registered.end())
+        {
+            drawable.materialIdx = it->second;
+        }
+        else
+        {
+            drawable.materialIdx = registerMaterial(material);
+            registered.emplace_back(material, drawable.materialIdx);
+        }
+    }
+}
+
+void Window::initPushConstants()
+{
+    if (options.drawPath != DRAW_PATH_PUSH_CONSTANT)
+    {
+        return;
+    }
+
+    initMaterialTable();
+}
+
+void Window::initInstancing()
+{
+    if (options.drawPath != DRAW_PATH_INSTANCED)
+    {
+        return;
+    }
+
+    initMaterialTable();
+    instanceBuffer = std::make_unique<InstanceBuffer>(
+            &logicalDev, &allocator, dev, persistentDescriptors, layoutCache);
+}
+
+void Window::initGpuDriven()
+{
+    if (options.drawPath != DRAW_PATH_GPU_DRIVEN)
+    {
+        return;
+    }
+
+    if (not indirectCountEnabled())
+    {
+#ifdef DEBUG
+        std::cerr << "Indirect count draws not supported; using instanced path." << std::endl;
+#endif
+        options.drawPath = DRAW_PATH_INSTANCED;
+        return;
+    }
+
+    std::vector<Mesh const*> meshes;
+    for (auto const& [name, meshPtr] : meshStorage)
+    {
+        meshes.push_back(meshPtr.get());
+    }
+    geometryBuffer = std::make_unique<GeometryBuffer>(&logicalDev, &allocator, dev, meshes);
+
+    DisposableCmdBuffer dcb(&logicalDev, &cmdTransferPool);
+    auto stagingPtr = geometryBuffer->stagingBuffer(queueFamilyIndex.queuesForTransfer());
+    geometryBuffer->buf.cmdCopyDataFrom(stagingPtr->vertexBuffer, dcb.commandBuffer());
+    dcb.finish();
+    uint64_t uploadValue = frameTimeline.advance();
+    CHECK_VK_SUCCESS(
+            dcb.submit(transferQueue, frameTimeline.semaphore, uploadValue),
+            ErrorMessages::FAILED_CANNOT_SUBMIT_QUEUE);
+    // the staging buffers go out of scope right after
+    CHECK_VK_SUCCESS(frameTimeline.wait(uploadValue), ErrorMessages::FAILED_WAIT_IDLE);
+
+    initMaterialTable();
+    // read by both the culling (compute) and vertex stages
+    instanceBuffer = std::make_unique<InstanceBuffer>(
+            &logicalDev, &allocator, dev, persistentDescriptors, layoutCache,
+            queueFamilyIndex.queuesForCompute());
+    cullingPass = std::make_unique<CullingPass>(
+            &logicalDev, &allocator, dev, queueFamilyIndex,
+            persistentDescriptors, layoutCache,
+            *geometryBuffer, *instanceBuffer, pipelineCache.cache,
+            "cull.comp.spv");
+}
+
+void Window::initParallelRecording()
+{
+    // runs after the other init* calls, once the draw path is settled. Only paths
+    // whose draws read nothing but data prepared before recording can be split.
+    uint32_t workerCount = jobs.threadCount();
+
+    bool splittable = options.drawPath == DRAW_PATH_BINDLESS
+            || options.drawPath == DRAW_PATH_BUFFER_ADDRESS
+            || options.drawPath == DRAW_PATH_PUSH_CONSTANT;
+    if (workerCount <= 1 or not splittable)
+    {
+        return;
+    }
+
+    secondaryPools = std::make_unique<SecondaryCommandPools>(
+            &logicalDev, queueFamilyIndex.graphicsFamily.value(), workerCount, options.depthPrePass ? 2 : 1);
+    workerEncoders.resize(workerCount);
+}
+
+void Window::initPresentThread()
+{
+    // the present thread needs a queue nobody else submits to while frames are
+    // running; the culling pass submits to the compute queue from the render thread
+    if (not options.presentThread or presentQueue == graphicsQueue or presentQueue == computeQueue)
+    {
+        return;
+    }
+    presentThread = std::make_unique<PresentThread>(presentQueue);
+}
+
+void Window::initMaterialTable()
+{
+    materialTable = std::make_unique<MaterialTable>(
+            &logicalDev, &allocator, dev, persistentDescriptors, layoutCache);
+    assignMaterials([this](MaterialRecord const& material)
+                    {
+                        return materialTable->registerMaterial(material);
+                    });
+}
+
+void Window::initBufferAddress()
+{
+    if (options.drawPath != DRAW_PATH_BUFFER_ADDRESS)
+    {
+        return;
+    }
+
+    if (not bufferDeviceAddressEnabled())
+    {
+#ifdef DEBUG
+        std::cerr << "Buffer device address not supported; using push-constant path." << std::endl;
+#endif
+        options.drawPath = DRAW_PATH_PUSH_CONSTANT;
+        return;
+    }
+
+    drawAddressTable = std::make_unique<DrawAddressTable>(&logicalDev, &allocator, dev);
+}
+
+void Window::addBenchmarkDrawables()
+{
+    uint32_t targetCount = std::min(options.drawCount, maxDrawCount());
+    if (targetCount <= drawables.size())
+    {
+        return;
+    }
+
+    glm::mat4 baseMat = drawables[0].uniform.model;
+    auto extraCount = static_cast<uint32_t>(targetCount - drawables.size());
+    auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(extraCount))));
+    float const spacing = 0.6f;
+
+    for (uint32_t i = 0; i < extraCount; ++i)
+    {
+        glm::vec3 offset(
+                (static_cast<float>(i % side) - 0.5f * static_cast<float>(side)) * spacing,
+                (static_cast<float>(i / side) - 0.5f * static_cast<float>(side)) * spacing,
+                0.f);
+
+        Drawable& drawable = drawables.emplace_back(
+                meshStorage["teapot"].get(), glm::translate(glm::mat4(1.f), offset) * baseMat);
+        drawable.uniform.baseColor = drawables[0].uniform.baseColor;
+        drawable.uniform.params = drawables[0].uniform.params;
+    }
+}
+
+uint32_t Window::maxDrawCount() const
+{
+    if (options.drawPath == DRAW_PATH_INSTANCED || options.drawPath == DRAW_PATH_GPU_DRIVEN)
+    {
+        return InstanceBuffer::MAX_INSTANCES;
+    }
+    return DrawAddressTable::MAX_DRAWS;
+}
+
+void Window::createPipelines()
+{
+    // base names of the path's shaders, e.g. "main" for main.vert.spv and main.frag.spv
+    std::string vertShader = "dynubo";
+    std::string fragShader = "dynubo";
+    std::vector<VkDescriptorSetLayout> setLayouts = { uniformData->descriptorSetLayout };
+    std::vector<VkPushConstantRange> pushConstantRanges;
+
+    if (options.drawPath == DRAW_PATH_BINDLESS)
+    {
+        vertShader = fragShader = "bindless";
+        setLayouts.push_back(bindlessTable->descriptorSetLayout);
+        pushConstantRanges.push_back(DrawPushConstant::pushConstantRange());
+    }
+    else if (options.drawPath == DRAW_PATH_BUFFER_ADDRESS)
+    {
+        vertShader = fragShader = "bda";
+        pushConstantRanges.push_back(DrawAddressPushConstant::pushConstantRange());
+    }
+    else if (options.drawPath == DRAW_PATH_PUSH_CONSTANT)
+    {
+        vertShader = fragShader = "main";
+        setLayouts.push_back(materialTable->descriptorSetLayout);
+        pushConstantRanges.push_back(DrawTransformPushConstant::pushConstantRange());
+    }
+    else if (options.drawPath == DRAW_PATH_INSTANCED)
+    {
+        vertShader = fragShader = "instanced";
+        setLayouts.push_back(materialTable->descriptorSetLayout);
+        setLayouts.push_back(instanceBuffer->descriptorSetLayout);
+        pushConstantRanges.push_back(InstanceBatchPushConstant::pushConstantRange());
+    }
+    else if (options.drawPath == DRAW_PATH_GPU_DRIVEN)
+    {
+        vertShader = "gpudriven";
+        fragShader = "instanced";
+        setLayouts.push_back(materialTable->descriptorSetLayout);
+        setLayouts.push_back(instanceBuffer->descriptorSetLayout);
+    }
+    else
+    {
+        setLayouts.push_back(uniformData->meshDescriptorSetLayout);
+    }
+
+    DepthPrePass depthPrePass = options.depthPrePass ? DEPTH_PRE_PASS_TEST : DEPTH_PRE_PASS_NONE;
+    VertexLayout vertexLayout = options.splitPositions ? VERTEX_LAYOUT_SPLIT_POSITIONS : VERTEX_LAYOUT_INTERLEAVED;
+    // deferred draws only write their surface to the G-buffer, through the gbuffer variant of the lit shader
+    bool deferred = options.deferredShading;
+    uint32_t colorAttachmentCount = deferred ? GBuffer::COLOR_ATTACHMENT_COUNT : 1;
+    graphicsPipeline = std::make_unique<GraphicsPipeline>(
+            &logicalDev, dev, &cmdPool, pipelineCache.cache,
+            vertShader + ".vert.spv", fragShader + (deferred ? ".gbuffer.frag.spv" : ".frag.spv"),
+            swapchainComponent->imageCount(),
+            swapchainComponent->renderPass,
+            setLayouts, true, pushConstantRanges, depthPrePass, vertexLayout, colorAttachmentCount);
+
+    if (options.depthPrePass)
+    {
+        // an identical layout keeps bound sets and push constants valid across both pipelines
+        depthPipeline = std::make_unique<GraphicsPipeline>(
+                &logicalDev, dev, &cmdPool, pipelineCache.cache,
+                vertShader + ".depth.vert.spv", "",
+                0,
+                swapchainComponent->renderPass,
+                setLayouts, true, pushConstantRanges, DEPTH_PRE_PASS_WRITE, vertexLayout, colorAttachmentCount);
+    }
+
+    if (deferred)
+    {
+        deferredLighting = std::make_unique<DeferredLightingPass>(
+                &logicalDev, pipelineCache.cache, swapchainComponent->renderPass,
+                std::vector<VkDescriptorSetLayout>{uniformData->descriptorSetLayout, gbuffer.descriptorSetLayout});
+    }
+
+    // variants of the generic pipeline compile in the background through this
+    pipelineManager = std::make_unique<PipelineManager>(
+            &logicalDev, dev, jobs, pipelineCache.cache,
+            graphicsPipeline->pipelineLayout, graphicsPipeline->pipeline,
+            swapchainComponent->swapchainFormat.format, true, depthPrePass, vertexLayout, deferred,
+            pipelineLibraryEnabled());
+}
+
+VkImageUsageFlags Window::depthUsage() const
+{
+    // the deferred lighting subpass reads depth back to rebuild positions
+    return options.deferredShading ?
+           VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT :
+           VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+}
+
+void Window::createGBuffer()
+{
+    if (options.deferredShading)
+    {
+        gbuffer = GBuffer(&logicalDev, &allocator, dev, size(), depthBuffer.imgView, layoutCache);
+    }
+}
+
+void Window::savePipelineCache()
+{
+    if (not pipelineCache.save())
+    {
+        std::cerr << "Cannot save pipeline cache to " << options.pipelineCachePath << "." << std::endl;
+    }
+}
+
+glm::mat4 Window::viewMatrix() const
+{
+    return glm::lookAt(cameraPos, glm::vec3(0.f), glm::vec3(1.f, -1.f, -1.f));
 }
 
 void Window::setUniforms(UniformObjBuffer<UniformObjects>& bufObject)
@@ -462,42 +1733,117 @@ void Window::setUniforms(UniformObjBuffer<UniformObjects>& bufObject)
 
     UniformObjects ubo = {};
     ubo.time = totalTime / 1000.f;
-    ubo.view = glm::lookAt(
-            cameraPos,
-            O,
-            glm::vec3(1.f, -1.f, -1.f));
+    ubo.view = viewMatrix();
     ubo.proj = projectMat;
     ubo.cameraPos = glm::vec4(cameraPos, 1);
+    ubo.globalLightCount = static_cast<uint32_t>(frameLights.size());
+    ubo.lightCount = static_cast<uint32_t>(frameLights.size() + clusteredLights.size());
+    ubo.clusterDepthScale = clusterSlicing.scale;
+    ubo.clusterDepthBias = clusterSlicing.bias;
+    ubo.invViewProj = glm::inverse(projectMat * ubo.view);
 
     CHECK_VK_SUCCESS(bufObject.loadData(ubo), "Cannot set uniforms!");
 }
 
-void Window::setLights(StorageBufferArray<Light>& storageObj)
+void Window::updateLights()
 {
     float t = sin(totalTime / 500);
 
-    std::vector<Light> li(3);
-    li[0].lightType = LightType::POINT_LIGHT;
-    li[0].position = glm::vec4(t,2,2,1);
-    li[0].color = glm::vec4(1,1,1,1) * (t + 1);
-    li[0].intensity = 5.f;
+    frameLights.resize(3);
+    frameLights[0].lightType = LightType::POINT_LIGHT;
+    frameLights[0].position = glm::vec4(t,2,2,1);
+    frameLights[0].color = glm::vec4(1,1,1,1) * (t + 1);
+    frameLights[0].intensity = 5.f;
+
+    frameLights[1].lightType = LightType::POINT_LIGHT;
+    frameLights[1].position = glm::vec4(2,t,3,1);
+    frameLights[1].color = glm::vec4(0,1,0,1);
+    frameLights[1].intensity = 2.f;
+
+    frameLights[2].lightType = LightType::DIRECTIONAL_LIGHT;
+    frameLights[2].position = glm::vec4(1,1,1,0);
+    frameLights[2].color = glm::vec4(1,1,0,1);
+    frameLights[2].intensity = 1.f;
+
+    // small lights over the scene, each circling its own spot
+    auto clusteredCount = std::min<size_t>(options.lightCount, LightClusters::MAX_LIGHTS - frameLights.size());
+    clusteredLights.resize(clusteredCount);
+    auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(clusteredCount))));
+    float const spacing = 0.4f;
+    float const seconds = totalTime / 1000.f;
+
+    jobs.parallelFor(static_cast<uint32_t>(clusteredCount), 1024, [&](uint32_t first, uint32_t last)
+    {
+        for (uint32_t i = first; i < last; ++i)
+        {
+            // cheap integer hash, so every light keeps its own phase and color
+            uint32_t h = i * 0x9E3779B1u;
+            h ^= h >> 15;
+            h *= 0x85EBCA77u;
+            h ^= h >> 13;
+            float phase = static_cast<float>(h & 0xFFFFu) / 65535.f * glm::two_pi<float>();
+
+            glm::vec2 center(
+                    (static_cast<float>(i % side) - 0.5f * static_cast<float>(side)) * spacing,
+                    (static_cast<float>(i / side) - 0.5f * static_cast<float>(side)) * spacing);
+            glm::vec2 orbit = 0.15f * glm::vec2(std::cos(seconds + phase), std::sin(seconds + phase));
+
+            Light& light = clusteredLights[i];
+            light.lightType = LightType::POINT_LIGHT;
+            light.intensity = 0.5f;
+            light.color = glm::vec4(
+                    0.25f + 0.75f * static_cast<float>((h >> 16) & 0xFFu) / 255.f,
+                    0.25f + 0.75f * static_cast<float>((h >> 24) & 0xFFu) / 255.f,
+                    0.25f + 0.75f * static_cast<float>((h >> 8) & 0xFFu) / 255.f,
+                    1.f);
+            light.position = glm::vec4(center + orbit, 0.3f, 1.f);
+            light.parameters = glm::vec4(0.5f, 0.f, 0.f, 0.f);
+        }
+    });
+
+    ShaderPermutation permutation = ShaderPermutation::forLights(frameLights);
+    if (not (permutation == lightPermutation))
+    {
+        lightPermutation = permutation;
+        requestPermutations();
+    }
+}
 
-    li[1].lightType = LightType::POINT_LIGHT;
-    li[1].position = glm::vec4(2,t,3,1);
-    li[1].color = glm::vec4(0,1,0,1);
-    li[1].intensity = 2.f;
+void Window::requestPermutations()
+{
+    // only the push-constant path draws through pipeline variants, and only when the draws shade.
+    // G-buffer writers never touch the lights, so the generic one is all deferred shading needs
+    if (options.drawPath != DRAW_PATH_PUSH_CONSTANT or options.deferredShading)
+    {
+        return;
+    }
 
-    li[2].lightType = LightType::DIRECTIONAL_LIGHT;
-    li[2].position = glm::vec4(1,1,1,0);
-    li[2].color = glm::vec4(1,1,0,1);
-    li[2].intensity = 1.f;
+    // draws of the same permutation share a variant; until it compiles they use the generic one
+    std::unordered_map<ShaderPermutation, uint32_t, ShaderPermutation::Hash> variantIds;
+    for (auto& drawable : drawables)
+    {
+        ShaderPermutation permutation = lightPermutation.withMaterial(drawable.uniform.params);
+        auto [it, inserted] = variantIds.try_emplace(permutation, 0);
+        if (inserted)
+        {
+            it->second = pipelineManager->request(permutation.pipelineVariant("main"));
+        }
+        drawable.pipelineVariant = it->second;
+    }
+}
 
-    storageObj.loadDataAndSetSize(li);
+void Window::setLights(Buffers::Buffer& lightBuffer)
+{
+    // the counts go with the uniforms
+    CHECK_VK_SUCCESS(lightBuffer.loadData({
+            { frameLights.data(), 0, frameLights.size() * sizeof(Light) },
+            { clusteredLights.data(), frameLights.size() * sizeof(Light), clusteredLights.size() * sizeof(Light) }
+    }), "Cannot set lights!");
 }
 
 void Window::updateFrame(float const& deltaTime)
 {
-    totalTime += deltaTime;
+    simTime += deltaTime;
     // setting new uniform
 
     glm::mat4 baseMat = glm::scale(glm::transpose(glm::mat4(
@@ -507,5 +1853,5 @@ void Window::updateFrame(float const& deltaTime)
             0, 0, 0, 1
     )), glm::vec3(0.15f));
 
-    drawables[0].uniform.setModelMatrix(glm::rotate(baseMat, -totalTime / 1000.0f, glm::vec3(0,1,0)));
+    simModels[0] = glm::rotate(baseMat, -simTime / 1000.0f, glm::vec3(0,1,0));
 }
\ No newline at end of file
@@ -70,8 +70,17 @@ bool deviceSuitable(VkPhysicalDevice const& dev)
     vkGetPhysicalDeviceProperties(dev, &properties);
     vkGetPhysicalDeviceFeatures(dev, &features);
 
+    VkPhysicalDeviceVulkan12Features features12 = {};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &features12;
+    vkGetPhysicalDeviceFeatures2(dev, &features2);
+
     return
     checkDeviceExtensionSupport(dev)
+        // all CPU/GPU synchronization goes through one timeline semaphore
+        && features12.timelineSemaphore
         && features.tessellationShader
         && features.geometryShader
         && features.samplerAnisotropy;
@@ -295,39 +304,82 @@ VkResult WindowBase::createLogicalDevice()
     }
 
 
-    std::vector<VkDeviceQueueCreateInfo> queueCreateList;
+    // one create info per distinct family; several roles may share a family
+    std::set<uint32_t> uniqueFamilies = {
+            queueFamilyIndex.graphicsFamily.value(),
+            queueFamilyIndex.presentationFamily.value(),
+            queueFamilyIndex.transferQueueFamily(),
+            queueFamilyIndex.computeQueueFamily()
+    };
 
     float priority = 1.f;
-    VkDeviceQueueCreateInfo createQueueInfo = {};
-    createQueueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    createQueueInfo.queueFamilyIndex = queueFamilyIndex.graphicsFamily.value();
-    createQueueInfo.queueCount = 1;
-    createQueueInfo.pQueuePriorities = &priority;
+    std::vector<VkDeviceQueueCreateInfo> queues;
+    for (uint32_t const& family : uniqueFamilies)
+    {
+        VkDeviceQueueCreateInfo createQueueInfo = {};
+        createQueueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        createQueueInfo.queueFamilyIndex = family;
+        createQueueInfo.queueCount = 1;
+        createQueueInfo.pQueuePriorities = &priority;
+        queues.push_back(createQueueInfo);
+    }
 
-    VkDeviceQueueCreateInfo presentationQueueInfo = {};
-    presentationQueueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    presentationQueueInfo.queueFamilyIndex = queueFamilyIndex.presentationFamily.value();
-    presentationQueueInfo.queueCount = 1;
-    presentationQueueInfo.pQueuePriorities = &priority;
+    queryFeatures12();
+    enabledFeatures = {};
+    enabledFeatures.samplerAnisotropy = VK_TRUE;
 
-    VkDeviceQueueCreateInfo transferQueueInfo = {};
-    transferQueueInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    transferQueueInfo.queueFamilyIndex = queueFamilyIndex.transferQueueFamily();
-    transferQueueInfo.queueCount = 1;
-    transferQueueInfo.pQueuePriorities = &priority;
+    enabledFeatures12 = {};
+    enabledFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    // checked by deviceSuitable()
+    enabledFeatures12.timelineSemaphore = VK_TRUE;
 
-    VkDeviceQueueCreateInfo queues[] = {createQueueInfo, presentationQueueInfo, transferQueueInfo};
+    // descriptor indexing, for the bindless draw path
+    if (BindlessTable::supported(supportedFeatures12))
+    {
+        enabledFeatures12.descriptorIndexing = VK_TRUE;
+        enabledFeatures12.runtimeDescriptorArray = VK_TRUE;
+        enabledFeatures12.descriptorBindingPartiallyBound = VK_TRUE;
+        enabledFeatures12.descriptorBindingVariableDescriptorCount = VK_TRUE;
+        enabledFeatures12.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        enabledFeatures12.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+    }
 
-    VkPhysicalDeviceFeatures feat = {};
-    feat.samplerAnisotropy = VK_TRUE;
+    // buffer device address, for per-draw records reached through push-constant pointers
+    if (supportedFeatures12.bufferDeviceAddress == VK_TRUE)
+    {
+        enabledFeatures12.bufferDeviceAddress = VK_TRUE;
+    }
+
+    // indirect draws with GPU-written counts and per-command instance offsets, for the GPU-driven path
+    if (CullingPass::supported(supportedFeatures, supportedFeatures12))
+    {
+        enabledFeatures.multiDrawIndirect = VK_TRUE;
+        enabledFeatures.drawIndirectFirstInstance = VK_TRUE;
+        enabledFeatures12.drawIndirectCount = VK_TRUE;
+    }
 
     auto deviceExts = getRequiredDeviceExts();
 
+#if defined(VK_EXT_graphics_pipeline_library)
+    // pipeline libraries, so PipelineManager can link variants instead of compiling them whole
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT pipelineLibraryFeatures = {};
+    pipelineLibraryFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    if (pipelineLibrarySupported())
+    {
+        pipelineLibraryFeatures.graphicsPipelineLibrary = VK_TRUE;
+        enabledFeatures12.pNext = &pipelineLibraryFeatures;
+        deviceExts.push_back(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+        deviceExts.push_back(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+        pipelineLibrary = true;
+    }
+#endif
+
     VkDeviceCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-    createInfo.queueCreateInfoCount = 3;
-    createInfo.pQueueCreateInfos = queues;
-    createInfo.pEnabledFeatures = &feat;
+    createInfo.pNext = &enabledFeatures12;
+    createInfo.queueCreateInfoCount = static_cast<uint32_t>(queues.size());
+    createInfo.pQueueCreateInfos = queues.data();
+    createInfo.pEnabledFeatures = &enabledFeatures;
     createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExts.size());
     createInfo.ppEnabledExtensionNames = deviceExts.data();
 
@@ -335,11 +387,77 @@ VkResult WindowBase::createLogicalDevice()
     vkGetDeviceQueue(logicalDev, queueFamilyIndex.graphicsFamily.value(), 0, &graphicsQueue);
     vkGetDeviceQueue(logicalDev, queueFamilyIndex.presentationFamily.value(), 0, &presentQueue);
     vkGetDeviceQueue(logicalDev, queueFamilyIndex.transferQueueFamily(), 0, &transferQueue);
+    vkGetDeviceQueue(logicalDev, queueFamilyIndex.computeQueueFamily(), 0, &computeQueue);
 
+    // the member outlives the pipeline library features on this stack frame
+    enabledFeatures12.pNext = nullptr;
 
     return result;
 }
 
+void WindowBase::queryFeatures12()
+{
+    supportedFeatures12 = {};
+    supportedFeatures12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+    VkPhysicalDeviceFeatures2 features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &supportedFeatures12;
+    vkGetPhysicalDeviceFeatures2(dev, &features);
+    supportedFeatures = features.features;
+    supportedFeatures12.pNext = nullptr;
+}
+
+bool WindowBase::pipelineLibrarySupported() const
+{
+#if defined(VK_EXT_graphics_pipeline_library)
+    if (not checkDeviceExtensionSupport(
+            dev, {VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME}))
+    {
+        return false;
+    }
+
+    VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT features = {};
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT;
+    VkPhysicalDeviceFeatures2 features2 = {};
+    features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features2.pNext = &features;
+    vkGetPhysicalDeviceFeatures2(dev, &features2);
+
+    // without fast linking, linking costs about as much as compiling the whole pipeline
+    VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT properties = {};
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT;
+    VkPhysicalDeviceProperties2 properties2 = {};
+    properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties2.pNext = &properties;
+    vkGetPhysicalDeviceProperties2(dev, &properties2);
+
+    return features.graphicsPipelineLibrary == VK_TRUE && properties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+#else
+    return false;
+#endif
+}
+
+bool WindowBase::pipelineLibraryEnabled() const
+{
+    return pipelineLibrary;
+}
+
+bool WindowBase::bindlessEnabled() const
+{
+    return enabledFeatures12.descriptorIndexing == VK_TRUE;
+}
+
+bool WindowBase::bufferDeviceAddressEnabled() const
+{
+    return enabledFeatures12.bufferDeviceAddress == VK_TRUE;
+}
+
+bool WindowBase::indirectCountEnabled() const
+{
+    return enabledFeatures12.drawIndirectCount == VK_TRUE;
+}
+
 VkResult WindowBase::createSurface()
 {
 #if defined(__linux__)
@@ -362,6 +480,10 @@ VkResult WindowBase::createAllocator()
     createInfo.physicalDevice = dev;
     createInfo.device = logicalDev;
     createInfo.instance = instance;
+    if (bufferDeviceAddressEnabled())
+    {
+        createInfo.flags |= VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
+    }
 
     return vmaCreateAllocator(&createInfo, &allocator);
 }
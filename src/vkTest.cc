@@ -3,8 +3,106 @@
 
 #define TITLE "Vulkan"
 
-int main()
+int main(int argc, char** argv)
 {
-    Window win1(1920, 1080, TITLE);
+    RenderOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg(argv[i]);
+        if (arg == "--bindless")
+        {
+            options.drawPath = DRAW_PATH_BINDLESS;
+        }
+        else if (arg == "--dynamic-ubo")
+        {
+            options.drawPath = DRAW_PATH_DYNAMIC_UBO;
+        }
+        else if (arg == "--bda")
+        {
+            options.drawPath = DRAW_PATH_BUFFER_ADDRESS;
+        }
+        else if (arg == "--instanced")
+        {
+            options.drawPath = DRAW_PATH_INSTANCED;
+        }
+        else if (arg == "--gpu-driven")
+        {
+            options.drawPath = DRAW_PATH_GPU_DRIVEN;
+        }
+        else if (arg == "--no-cull")
+        {
+            options.cpuCulling = false;
+        }
+        else if (arg == "--depth-prepass")
+        {
+            options.depthPrePass = true;
+        }
+        else if (arg == "--split-positions")
+        {
+            options.splitPositions = true;
+        }
+        else if (arg == "--deferred")
+        {
+            options.deferredShading = true;
+        }
+        else if (arg == "--no-sort")
+        {
+            options.sortDraws = false;
+        }
+        else if (arg == "--min-pixels" && i + 1 < argc)
+        {
+            options.minScreenPixels = std::stof(argv[++i]);
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            options.jobThreads = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--pin-threads")
+        {
+            options.pinThreads = true;
+        }
+        else if (arg == "--no-render-thread")
+        {
+            options.renderThread = false;
+        }
+        else if (arg == "--no-present-thread")
+        {
+            options.presentThread = false;
+        }
+        else if (arg == "--sim-rate" && i + 1 < argc)
+        {
+            options.simulationRate = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--pipeline-cache" && i + 1 < argc)
+        {
+            options.pipelineCachePath = argv[++i];
+        }
+        else if (arg == "--no-pipeline-cache")
+        {
+            options.pipelineCachePath.clear();
+        }
+        else if (arg == "--shader-dir" && i + 1 < argc)
+        {
+            options.shaderDirectory = argv[++i];
+        }
+        else if (arg == "--benchmark" && i + 1 < argc)
+        {
+            options.benchmarkFrames = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--draws" && i + 1 < argc)
+        {
+            options.drawCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--lights" && i + 1 < argc)
+        {
+            options.lightCount = static_cast<uint32_t>(std::stoul(argv[++i]));
+        }
+        else if (arg == "--cpu-light-binning")
+        {
+            options.cpuLightBinning = true;
+        }
+    }
+
+    Window win1(1920, 1080, TITLE, 60.f, 0.1f, 100.f, options);
     return win1.mainLoop();
-}
\ No newline at end of file
+}
@@ -0,0 +1,27 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#pragma once
+#include <iostream>
+
+// minimal assertions for the test executables; main() returns Tests::result()
+namespace Tests
+{
+    inline int failures = 0;
+
+    inline int result()
+    {
+        if (failures != 0)
+        {
+            std::cerr << failures << " check(s) failed." << std::endl;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+}
+
+#define EXPECT(cond) { \
+    if (not (cond)) { \
+    std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " << #cond << std::endl; \
+    ++Tests::failures; \
+    }}
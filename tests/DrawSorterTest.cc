@@ -0,0 +1,118 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "DrawKey.h"
+#include "Check.h"
+#include <random>
+
+namespace
+{
+    // drawIdx records the input order, so a stable sort is fully determined by it
+    std::vector<DrawSortEntry> entriesFromKeys(std::vector<uint64_t> const& keys)
+    {
+        std::vector<DrawSortEntry> entries;
+        entries.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            entries.push_back({ keys[i], static_cast<uint32_t>(i) });
+        }
+        return entries;
+    }
+
+    void checkSort(DrawSorter& sorter, std::vector<uint64_t> const& keys)
+    {
+        std::vector<DrawSortEntry> sorted = entriesFromKeys(keys);
+        sorter.sort(sorted);
+
+        std::vector<DrawSortEntry> expected = entriesFromKeys(keys);
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](DrawSortEntry const& a, DrawSortEntry const& b) { return a.key < b.key; });
+
+        EXPECT(sorted.size() == expected.size());
+        EXPECT(std::equal(sorted.begin(), sorted.end(), expected.begin(), expected.end(),
+                          [](DrawSortEntry const& a, DrawSortEntry const& b)
+                          {
+                              return a.key == b.key && a.drawIdx == b.drawIdx;
+                          }));
+    }
+
+    /**
+     * Keys that differ only in the given bytes, drawn from a few values per byte so
+     * there are many duplicates to keep in order.
+     */
+    std::vector<uint64_t> randomKeys(size_t const& count, std::vector<uint32_t> const& bytes, uint32_t const& seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<uint32_t> byteValue(0, 5);
+        std::vector<uint64_t> keys(count, 0x0123456789abcdefull);
+        for (auto& key : keys)
+        {
+            for (uint32_t byte : bytes)
+            {
+                uint32_t const shift = byte * DrawSorter::RADIX_BITS;
+                key = (key & ~(uint64_t(0xff) << shift)) | (uint64_t(byteValue(rng)) << shift);
+            }
+        }
+        return keys;
+    }
+
+    void testEmpty()
+    {
+        DrawSorter sorter;
+        checkSort(sorter, {});
+    }
+
+    void testAllEqual()
+    {
+        DrawSorter sorter;
+        checkSort(sorter, std::vector<uint64_t>(1, 42));
+        checkSort(sorter, std::vector<uint64_t>(300, 0xfedcba9876543210ull));
+    }
+
+    // odd and even numbers of non-skipped passes, so the last swap leaves the result in either buffer
+    void testPassCounts()
+    {
+        DrawSorter sorter;
+        std::vector<std::vector<uint32_t>> byteSets = {
+                { 0 },
+                { 5 },
+                { 0, 3 },
+                { 1, 4, 7 },
+                { 0, 1, 2, 3, 4, 5, 6 },
+                { 0, 1, 2, 3, 4, 5, 6, 7 } };
+        for (size_t i = 0; i < byteSets.size(); ++i)
+        {
+            for (size_t count : { 2, 17, 1000 })
+            {
+                checkSort(sorter, randomKeys(count, byteSets[i], static_cast<uint32_t>(i * 1000 + count)));
+            }
+        }
+    }
+
+    // keys as the renderer builds them, sorted by a reused sorter of a different size
+    void testDrawKeys()
+    {
+        DrawSorter sorter;
+        checkSort(sorter, randomKeys(5000, { 0, 1, 2 }, 7));
+
+        std::mt19937 rng(11);
+        std::uniform_int_distribution<uint32_t> state(0, 3);
+        std::uniform_real_distribution<float> depth(-0.1f, 1.1f);
+        std::vector<uint64_t> keys(777);
+        for (auto& key : keys)
+        {
+            key = DrawKey::make(state(rng), state(rng), state(rng), depth(rng));
+        }
+        checkSort(sorter, keys);
+    }
+}
+
+int main()
+{
+    testEmpty();
+    testAllEqual();
+    testPassCounts();
+    testDrawKeys();
+    return Tests::result();
+}
@@ -0,0 +1,156 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "FrustumCuller.h"
+#include "Check.h"
+#include <random>
+
+namespace
+{
+    constexpr float PIXELS_PER_UNIT = 540.f;
+    constexpr float MIN_PIXELS = 2.f;
+
+    // the camera at the origin, looking down +z (view space is left-handed)
+    struct Scene
+    {
+        glm::vec3 cameraPos = glm::vec3(0.f);
+        Frustum frustum = Frustum::fromViewProj(glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 100.f));
+    };
+
+    /**
+     * Spheres in and around the frustum, some too small to see. Those within a small margin
+     * of a plane or of the size threshold are moved away from it, so rounding differences
+     * between the FMA and scalar math cannot flip them.
+     */
+    std::vector<glm::vec4> testSpheres(Scene const& scene, size_t const& count, uint32_t const& seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> xy(-80.f, 80.f);
+        std::uniform_real_distribution<float> z(-10.f, 120.f);
+        std::uniform_real_distribution<float> r(0.001f, 3.f);
+
+        auto ambiguous = [&scene](glm::vec4 const& sphere)
+        {
+            glm::vec3 center(sphere);
+            for (auto const& plane : scene.frustum.planes)
+            {
+                if (std::abs(glm::dot(glm::vec3(plane), center) + plane.w + sphere.w) < 1e-2f)
+                {
+                    return true;
+                }
+            }
+            glm::vec3 diff = center - scene.cameraPos;
+            float size2 = 4.f * PIXELS_PER_UNIT * PIXELS_PER_UNIT * sphere.w * sphere.w;
+            float threshold = glm::dot(diff, diff) * MIN_PIXELS * MIN_PIXELS;
+            return std::abs(size2 - threshold) < 1e-2f * threshold;
+        };
+
+        std::vector<glm::vec4> spheres;
+        while (spheres.size() < count)
+        {
+            glm::vec4 sphere(xy(rng), xy(rng), z(rng), r(rng));
+            if (not ambiguous(sphere))
+            {
+                spheres.push_back(sphere);
+            }
+        }
+        return spheres;
+    }
+
+    void setSpheres(FrustumCuller& culler, std::vector<glm::vec4> const& spheres)
+    {
+        culler.resize(spheres.size());
+        for (size_t i = 0; i < spheres.size(); ++i)
+        {
+            culler.setBounds(i, spheres[i]);
+        }
+    }
+
+    bool sameStats(CullStats const& a, CullStats const& b)
+    {
+        return a.visible == b.visible && a.frustumCulled == b.frustumCulled && a.smallCulled == b.smallCulled;
+    }
+
+    // every path of the build agrees with the scalar one, which counts each sphere exactly once
+    void checkCull(Scene const& scene, FrustumCuller const& culler, size_t const& count)
+    {
+        std::vector<uint32_t> scalarVisible;
+        CullStats scalar = culler.cullScalar(scene.frustum, scene.cameraPos, PIXELS_PER_UNIT, MIN_PIXELS, scalarVisible);
+        EXPECT(scalar.visible + scalar.frustumCulled + scalar.smallCulled == count);
+        EXPECT(std::all_of(scalarVisible.begin(), scalarVisible.end(), [count](uint32_t idx) { return idx < count; }));
+
+        std::vector<uint32_t> culledVisible;
+        CullStats culled = culler.cull(scene.frustum, scene.cameraPos, PIXELS_PER_UNIT, MIN_PIXELS, culledVisible);
+        EXPECT(sameStats(scalar, culled));
+        EXPECT(scalarVisible == culledVisible);
+
+#if defined(FRUSTUM_CULLER_AVX2)
+        std::vector<uint32_t> avx2Visible;
+        CullStats avx2 = culler.cullAvx2(scene.frustum, scene.cameraPos, PIXELS_PER_UNIT, MIN_PIXELS, avx2Visible);
+        EXPECT(sameStats(scalar, avx2));
+        EXPECT(scalarVisible == avx2Visible);
+#endif
+    }
+
+    // counts on both sides of the SIMD width, so the last block has padding lanes
+    void testMatchesScalar()
+    {
+        Scene scene;
+        for (size_t count : {0, 1, 5, 7, 8, 9, 15, 16, 17, 63, 1001})
+        {
+            FrustumCuller culler;
+            setSpheres(culler, testSpheres(scene, count, static_cast<uint32_t>(count)));
+            checkCull(scene, culler, count);
+        }
+    }
+
+    // shrinking keeps the old spheres in the padding lanes; they must not be counted
+    void testStalePadding()
+    {
+        Scene scene;
+        std::vector<glm::vec4> spheres(16, glm::vec4(0.f, 0.f, 10.f, 1.f));
+
+        FrustumCuller culler;
+        setSpheres(culler, spheres);
+        spheres.resize(9);
+        setSpheres(culler, spheres);
+
+        std::vector<uint32_t> visible;
+        CullStats stats = culler.cull(scene.frustum, scene.cameraPos, PIXELS_PER_UNIT, MIN_PIXELS, visible);
+        EXPECT(stats.visible == 9);
+        EXPECT(stats.frustumCulled == 0);
+        EXPECT(stats.smallCulled == 0);
+        EXPECT(visible.size() == 9 && visible.back() == 8);
+        checkCull(scene, culler, 9);
+    }
+
+    // one sphere of each outcome, in a known order
+    void testKnownSpheres()
+    {
+        Scene scene;
+        FrustumCuller culler;
+        setSpheres(culler, {
+                glm::vec4(0.f, 0.f, 10.f, 1.f),      // visible
+                glm::vec4(0.f, 0.f, -10.f, 1.f),     // behind the camera
+                glm::vec4(0.f, 0.f, 90.f, 0.0001f),  // too small
+                glm::vec4(500.f, 0.f, 10.f, 1.f),    // off to the side
+                glm::vec4(1.f, 1.f, 50.f, 2.f) });   // visible
+
+        std::vector<uint32_t> visible;
+        CullStats stats = culler.cull(scene.frustum, scene.cameraPos, PIXELS_PER_UNIT, MIN_PIXELS, visible);
+        EXPECT(stats.visible == 2);
+        EXPECT(stats.frustumCulled == 2);
+        EXPECT(stats.smallCulled == 1);
+        EXPECT((visible == std::vector<uint32_t> { 0, 4 }));
+        checkCull(scene, culler, 5);
+    }
+}
+
+int main()
+{
+    testMatchesScalar();
+    testStalePadding();
+    testKnownSpheres();
+    return Tests::result();
+}
@@ -0,0 +1,83 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "InstanceTransform.h"
+#include "Check.h"
+
+namespace
+{
+    // distinct entries everywhere, including the dropped bottom row
+    glm::mat4 testMatrix(size_t const& idx)
+    {
+        glm::mat4 model(1.f);
+        for (int c = 0; c < 4; ++c)
+        {
+            for (int r = 0; r < 4; ++r)
+            {
+                model[c][r] = static_cast<float>(idx * 16 + c * 4 + r) + 0.5f;
+            }
+        }
+        return model;
+    }
+
+    // rows[r][c] = model[c][r], without any SIMD
+    bool matchesTranspose(glm::mat4 const& model, InstanceTransform const& transform)
+    {
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                if (transform.rows[r][c] != model[c][r])
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool sameTransform(InstanceTransform const& a, InstanceTransform const& b)
+    {
+        return std::memcmp(&a, &b, sizeof(InstanceTransform)) == 0;
+    }
+
+    void testEncode()
+    {
+        glm::mat4 model = testMatrix(3);
+        EXPECT(matchesTranspose(model, InstanceTransform::encode(model)));
+    }
+
+    // covers full batches, the remainder after them, and counts below one batch
+    void testEncodeBatch()
+    {
+        for (size_t count = 0; count <= 10; ++count)
+        {
+            std::vector<glm::mat4> models;
+            for (size_t i = 0; i < count; ++i)
+            {
+                models.push_back(testMatrix(i));
+            }
+
+            // one extra record, which encodeBatch must leave alone
+            InstanceTransform sentinel = {};
+            sentinel.rows[0] = glm::vec4(-1.f);
+            std::vector<InstanceTransform> out(count + 1, sentinel);
+            InstanceTransform::encodeBatch(models.data(), count, out.data());
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                EXPECT(sameTransform(out[i], InstanceTransform::encode(models[i])));
+                EXPECT(matchesTranspose(models[i], out[i]));
+            }
+            EXPECT(sameTransform(out[count], sentinel));
+        }
+    }
+}
+
+int main()
+{
+    testEncode();
+    testEncodeBatch();
+    return Tests::result();
+}
@@ -0,0 +1,74 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "JobSystem.h"
+#include <chrono>
+#include <cmath>
+
+/**
+ * Scaling benchmark of the job system: times the same parallelFor workload with
+ * 1, 2, 4, ... workers up to every hardware thread and prints the speedup over one.
+ * Usage: jobSystemBenchmark [items] [grain size] [repetitions]
+ */
+namespace
+{
+    double runWorkload(JobSystem& jobs, uint32_t items, uint32_t grain, uint32_t repetitions)
+    {
+        std::vector<float> results(items);
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t rep = 0; rep < repetitions; ++rep)
+        {
+            jobs.parallelFor(items, grain, [&results, rep](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    // a few hundred cycles per item, roughly one drawable's culling and encoding
+                    float x = static_cast<float>(i + rep);
+                    for (int k = 0; k < 64; ++k)
+                    {
+                        x = std::sqrt(x * 1.0001f + 1.f);
+                    }
+                    results[i] = x;
+                }
+            });
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        // keeps the work from being optimized out
+        volatile float sink = results[items / 2];
+        (void) sink;
+        return std::chrono::duration<double, std::milli>(end - start).count() / repetitions;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t items = argc > 1 ? static_cast<uint32_t>(std::stoul(argv[1])) : 65536;
+    uint32_t grain = argc > 2 ? static_cast<uint32_t>(std::stoul(argv[2])) : 128;
+    uint32_t repetitions = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 200;
+    uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    std::cout << items << " items, grain " << grain << ", " << repetitions << " repetitions" << std::endl;
+    std::vector<uint32_t> threadCounts;
+    for (uint32_t threads = 1; threads < maxThreads; threads *= 2)
+    {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    double baseline = 0;
+    for (uint32_t threads : threadCounts)
+    {
+        JobSystem jobs(threads);
+        runWorkload(jobs, items, grain, 5); // warmup
+        double ms = runWorkload(jobs, items, grain, repetitions);
+        if (threads == 1)
+        {
+            baseline = ms;
+        }
+        std::cout << threads << " thread(s): " << ms << " ms per pass, "
+                  << baseline / ms << "x" << std::endl;
+    }
+    return 0;
+}
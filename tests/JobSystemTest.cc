@@ -0,0 +1,260 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "JobSystem.h"
+#include "Check.h"
+
+namespace
+{
+    void testRunAndWait(JobSystem& jobs)
+    {
+        std::atomic<uint32_t> sum = 0;
+        Jobs::Counter counter;
+        for (uint32_t i = 1; i <= 1000; ++i)
+        {
+            jobs.run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        EXPECT(counter.done());
+        EXPECT(sum.load() == 500500);
+    }
+
+    void testParallelForCoversRange(JobSystem& jobs)
+    {
+        for (uint32_t grain : {1u, 7u, 64u, 5000u})
+        {
+            std::vector<std::atomic<uint32_t>> hits(3001);
+            jobs.parallelFor(static_cast<uint32_t>(hits.size()), grain, [&hits](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    hits[i].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            bool once = std::all_of(hits.begin(), hits.end(), [](auto const& hit) { return hit.load() == 1; });
+            EXPECT(once);
+        }
+    }
+
+    void testRunAfterOrdering(JobSystem& jobs)
+    {
+        std::atomic<uint32_t> firstDone = 0;
+        std::atomic<bool> orderKept = true;
+        Jobs::Counter first;
+        Jobs::Counter second;
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            jobs.run([&firstDone]() { firstDone.fetch_add(1, std::memory_order_acq_rel); }, &first);
+        }
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            jobs.runAfter(first, [&firstDone, &orderKept]()
+            {
+                if (firstDone.load(std::memory_order_acquire) != 64)
+                {
+                    orderKept.store(false);
+                }
+            }, &second);
+        }
+        jobs.wait(second);
+        EXPECT(orderKept.load());
+    }
+
+    void testNestedWait(JobSystem& jobs)
+    {
+        std::atomic<uint32_t> leaves = 0;
+        Jobs::Counter outer;
+        for (uint32_t i = 0; i < 16; ++i)
+        {
+            jobs.run([&jobs, &leaves]()
+            {
+                Jobs::Counter inner;
+                for (uint32_t j = 0; j < 16; ++j)
+                {
+                    jobs.run([&leaves]() { leaves.fetch_add(1, std::memory_order_relaxed); }, &inner);
+                }
+                jobs.wait(inner);
+            }, &outer);
+        }
+        jobs.wait(outer);
+        EXPECT(leaves.load() == 256);
+    }
+
+    void testWaitRethrows(JobSystem& jobs)
+    {
+        std::atomic<uint32_t> ran = 0;
+        Jobs::Counter counter;
+        for (uint32_t i = 0; i < 32; ++i)
+        {
+            jobs.run([&ran, i]()
+            {
+                ran.fetch_add(1, std::memory_order_relaxed);
+                if (i == 5)
+                {
+                    throw std::runtime_error("job failed");
+                }
+            }, &counter);
+        }
+
+        bool thrown = false;
+        try
+        {
+            jobs.wait(counter);
+        }
+        catch (std::runtime_error const&)
+        {
+            thrown = true;
+        }
+        EXPECT(thrown);
+        // the other jobs still ran, and the counter is done
+        EXPECT(ran.load() == 32);
+        EXPECT(counter.done());
+    }
+
+    void testParallelForThrowWaitsForRanges(JobSystem& jobs)
+    {
+        std::atomic<uint32_t> finished = 0;
+        bool thrown = false;
+        try
+        {
+            jobs.parallelFor(64, 1, [&finished](uint32_t begin, uint32_t)
+            {
+                if (begin == 0)
+                {
+                    // the calling thread's own range
+                    throw std::runtime_error("range failed");
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                finished.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        catch (std::runtime_error const&)
+        {
+            thrown = true;
+        }
+        EXPECT(thrown);
+        // every queued range was done with the stack-held body before parallelFor returned
+        EXPECT(finished.load() == 63);
+    }
+
+    void testUncountedJobThrowing(JobSystem& jobs)
+    {
+        // must neither terminate the worker nor stop later jobs from running
+        for (uint32_t i = 0; i < 8; ++i)
+        {
+            jobs.run([]() { throw std::runtime_error("uncounted job failed (expected by the test)"); });
+        }
+
+        std::atomic<uint32_t> ran = 0;
+        Jobs::Counter counter;
+        for (uint32_t i = 0; i < 64; ++i)
+        {
+            jobs.run([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        EXPECT(ran.load() == 64);
+    }
+
+    void testDequeOverflow(JobSystem& jobs)
+    {
+        // more jobs than one worker's deque holds; the rest must still be scheduled
+        uint32_t count = Jobs::WorkStealingDeque::CAPACITY * 2 + 17;
+        std::atomic<uint32_t> ran = 0;
+        Jobs::Counter counter;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            jobs.run([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        EXPECT(ran.load() == count);
+    }
+
+    void testMainThreadJobs(JobSystem& jobs)
+    {
+        std::thread::id mainThread = std::this_thread::get_id();
+        std::atomic<uint32_t> onMain = 0;
+        Jobs::Counter counter;
+        jobs.parallelFor(32, 1, [&](uint32_t, uint32_t)
+        {
+            jobs.runOnMainThread([&onMain, mainThread]()
+            {
+                if (std::this_thread::get_id() == mainThread)
+                {
+                    onMain.fetch_add(1, std::memory_order_relaxed);
+                }
+            }, &counter);
+        });
+        // the main thread runs its queue while it waits
+        jobs.wait(counter);
+        EXPECT(onMain.load() == 32);
+    }
+
+    void testRegisteredThread(JobSystem& jobs)
+    {
+        // as the renderer does: another thread takes over worker 0 while the main thread
+        // queues from outside the system, then hands it back
+        jobs.releaseThread();
+        std::atomic<uint32_t> sum = 0;
+        std::thread renderThread([&jobs, &sum]()
+        {
+            jobs.registerThread();
+            Jobs::Counter counter;
+            for (uint32_t i = 1; i <= 100; ++i)
+            {
+                jobs.run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+            }
+            jobs.wait(counter);
+            jobs.releaseThread();
+        });
+
+        Jobs::Counter counter;
+        jobs.run([&sum]() { sum.fetch_add(1000, std::memory_order_relaxed); }, &counter);
+        jobs.wait(counter);
+        renderThread.join();
+        jobs.registerThread();
+
+        EXPECT(sum.load() == 6050);
+        testRunAndWait(jobs);
+    }
+
+    void testDequeOrder()
+    {
+        Jobs::WorkStealingDeque deque;
+        Jobs::Job jobs[3];
+        EXPECT(deque.push(&jobs[0]));
+        EXPECT(deque.push(&jobs[1]));
+        EXPECT(deque.push(&jobs[2]));
+
+        // the owner pops the newest job, thieves take the oldest
+        EXPECT(deque.pop() == &jobs[2]);
+        EXPECT(deque.steal() == &jobs[0]);
+        EXPECT(deque.pop() == &jobs[1]);
+        EXPECT(deque.pop() == nullptr);
+        EXPECT(deque.steal() == nullptr);
+    }
+}
+
+int main()
+{
+    testDequeOrder();
+
+    for (uint32_t threads : {1u, 2u, 4u})
+    {
+        JobSystem jobs(threads);
+        EXPECT(jobs.threadCount() == threads);
+
+        testRunAndWait(jobs);
+        testParallelForCoversRange(jobs);
+        testRunAfterOrdering(jobs);
+        testNestedWait(jobs);
+        testWaitRethrows(jobs);
+        testParallelForThrowWaitsForRanges(jobs);
+        testUncountedJobThrowing(jobs);
+        testDequeOverflow(jobs);
+        testMainThreadJobs(jobs);
+        testRegisteredThread(jobs);
+    }
+    return Tests::result();
+}
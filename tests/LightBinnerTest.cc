@@ -0,0 +1,99 @@
+//
+// Created by Supakorn on 10/19/2026.
+//
+
+#include "LightClusters.h"
+#include "Check.h"
+
+namespace
+{
+    constexpr float CLIP_NEAR = 0.1f;
+    constexpr float CLIP_FAR = 100.f;
+
+    // the camera at the origin; view space is left-handed, so it looks down +z
+    struct Camera
+    {
+        glm::mat4 view = glm::mat4(1.f);
+        glm::mat4 proj = glm::perspective(glm::radians(60.f), 16.f / 9.f, CLIP_NEAR, CLIP_FAR);
+        LightClusters::DepthSlicing slicing = LightClusters::DepthSlicing::fromClipPlanes(CLIP_NEAR, CLIP_FAR);
+    };
+
+    Light pointLight(glm::vec3 const& position, float const& range)
+    {
+        Light light = {};
+        light.lightType = POINT_LIGHT;
+        light.intensity = 1.f;
+        light.color = glm::vec4(1.f);
+        light.position = glm::vec4(position, 1.f);
+        light.parameters = glm::vec4(range, 0.f, 0.f, 0.f);
+        return light;
+    }
+
+    uint32_t clusterOf(Camera const& camera, glm::vec3 const& viewPos)
+    {
+        using namespace LightClusters;
+
+        glm::vec4 clip = camera.proj * glm::vec4(viewPos, 1.f);
+        auto tile = [](float const& ndc, uint32_t const& gridSize)
+        {
+            return std::min(static_cast<uint32_t>((ndc * 0.5f + 0.5f) * static_cast<float>(gridSize)), gridSize - 1);
+        };
+        uint32_t x = tile(clip.x / clip.w, GRID_X);
+        uint32_t y = tile(clip.y / clip.w, GRID_Y);
+        auto slice = static_cast<uint32_t>(std::log(viewPos.z) * camera.slicing.scale + camera.slicing.bias);
+        return (slice * GRID_Y + y) * GRID_X + x;
+    }
+
+    /**
+     * Bins SIMD_WIDTH + 1 copies of one light: the first SIMD_WIDTH go through the AVX2
+     * path when it is built, the last one through the scalar path. Every cluster must
+     * then hold either all of the copies or none of them.
+     */
+    uint32_t binCopies(JobSystem& jobs, Camera const& camera, Light const& light, LightBinner& binner)
+    {
+        constexpr uint32_t copies = LightBinner::SIMD_WIDTH + 1;
+        std::vector<Light> lights(copies, light);
+        binner.bin(lights, 0, camera.view, camera.proj, camera.slicing, jobs);
+
+        uint32_t clusters = 0;
+        for (uint32_t cluster = 0; cluster < LightClusters::CLUSTER_COUNT; ++cluster)
+        {
+            std::vector<uint32_t> binned = binner.clusterLights(cluster);
+            EXPECT(binned.empty() or binned.size() == copies);
+            clusters += binned.empty() ? 0 : 1;
+        }
+        return clusters;
+    }
+
+    void testLightsInFront(JobSystem& jobs)
+    {
+        Camera camera;
+        for (auto const& [position, range] : std::vector<std::pair<glm::vec3, float>> {
+                { glm::vec3(0.f, 0.f, 10.f), 1.f },
+                { glm::vec3(3.f, -1.f, 5.f), 2.f },
+                { glm::vec3(-20.f, 4.f, 50.f), 8.f },
+                { glm::vec3(0.5f, 0.5f, 0.5f), 1.f } })
+        {
+            LightBinner binner;
+            EXPECT(binCopies(jobs, camera, pointLight(position, range), binner) > 0);
+
+            std::vector<uint32_t> binned = binner.clusterLights(clusterOf(camera, position));
+            EXPECT(not binned.empty());
+        }
+    }
+
+    void testLightBehind(JobSystem& jobs)
+    {
+        Camera camera;
+        LightBinner binner;
+        EXPECT(binCopies(jobs, camera, pointLight(glm::vec3(0.f, 0.f, -10.f), 1.f), binner) == 0);
+    }
+}
+
+int main()
+{
+    JobSystem jobs(2);
+    testLightsInFront(jobs);
+    testLightBehind(jobs);
+    return Tests::result();
+}